@@ -1,21 +1,22 @@
-#include "color.h"
-
-/* ===== MAP COLORS ===== */
-const SDL_Color COLOR_WALL_HARD = {64, 64, 64, 255};
-const SDL_Color COLOR_WALL_SOFT = {139, 69, 19, 255};
-
-/* ===== ENTITY COLORS ===== */
-const SDL_Color COLOR_PLAYER1 = {0, 0, 255, 255};
-const SDL_Color COLOR_PLAYER2 = {255, 255, 0, 255};
-const SDL_Color COLOR_PLAYER3 = {255, 0, 255, 255};
-const SDL_Color COLOR_PLAYER4 = {0, 255, 255, 255};
-const SDL_Color COLOR_POWERUP_BOMB = {255, 215, 0, 255};
-const SDL_Color COLOR_POWERUP_FIRE = {255, 69, 0, 255};
-
-/* ===== HUD / TEXT COLORS ===== */
-const SDL_Color COLOR_TEXT_PRIMARY = {237, 237, 237, 255};
-const SDL_Color COLOR_TEXT_MUTED   = {168, 168, 168, 255};
-const SDL_Color COLOR_TEXT_ACCENT  = {205, 187, 138, 255};
-const SDL_Color COLOR_TEXT_OK      = {61, 220, 151, 255};
-const SDL_Color COLOR_TEXT_BAD     = {220, 60, 60, 255};
+#include "color.h"
+
+/* ===== MAP COLORS ===== */
+const SDL_Color COLOR_WALL_HARD = {64, 64, 64, 255};
+const SDL_Color COLOR_WALL_SOFT = {139, 69, 19, 255};
+
+/* ===== ENTITY COLORS ===== */
+const SDL_Color COLOR_PLAYER1 = {0, 0, 255, 255};
+const SDL_Color COLOR_PLAYER2 = {255, 255, 0, 255};
+const SDL_Color COLOR_PLAYER3 = {255, 0, 255, 255};
+const SDL_Color COLOR_PLAYER4 = {0, 255, 255, 255};
+const SDL_Color COLOR_POWERUP_BOMB = {255, 215, 0, 255};
+const SDL_Color COLOR_POWERUP_FIRE = {255, 69, 0, 255};
+const SDL_Color COLOR_POWERUP_SPEED = {0, 191, 255, 255};
+
+/* ===== HUD / TEXT COLORS ===== */
+const SDL_Color COLOR_TEXT_PRIMARY = {237, 237, 237, 255};
+const SDL_Color COLOR_TEXT_MUTED   = {168, 168, 168, 255};
+const SDL_Color COLOR_TEXT_ACCENT  = {205, 187, 138, 255};
+const SDL_Color COLOR_TEXT_OK      = {61, 220, 151, 255};
+const SDL_Color COLOR_TEXT_BAD     = {220, 60, 60, 255};
 const SDL_Color COLOR_DIVIDER      = {42, 42, 42, 255};
\ No newline at end of file
@@ -1,22 +1,23 @@
-#pragma once
-#include <SDL2/SDL.h>
-
-/* ===== MAP COLORS ===== */
-extern const SDL_Color COLOR_WALL_HARD;
-extern const SDL_Color COLOR_WALL_SOFT;
-
-/* ===== ENTITY COLORS ===== */
-extern const SDL_Color COLOR_PLAYER1;
-extern const SDL_Color COLOR_PLAYER2;
-extern const SDL_Color COLOR_PLAYER3;
-extern const SDL_Color COLOR_PLAYER4;
-extern const SDL_Color COLOR_POWERUP_BOMB;
-extern const SDL_Color COLOR_POWERUP_FIRE;
-
-/* ===== HUD / TEXT COLORS ===== */
-extern const SDL_Color COLOR_TEXT_PRIMARY;
-extern const SDL_Color COLOR_TEXT_MUTED;
-extern const SDL_Color COLOR_TEXT_ACCENT;
-extern const SDL_Color COLOR_TEXT_OK;
-extern const SDL_Color COLOR_TEXT_BAD;
-extern const SDL_Color COLOR_DIVIDER;
+#pragma once
+#include <SDL2/SDL.h>
+
+/* ===== MAP COLORS ===== */
+extern const SDL_Color COLOR_WALL_HARD;
+extern const SDL_Color COLOR_WALL_SOFT;
+
+/* ===== ENTITY COLORS ===== */
+extern const SDL_Color COLOR_PLAYER1;
+extern const SDL_Color COLOR_PLAYER2;
+extern const SDL_Color COLOR_PLAYER3;
+extern const SDL_Color COLOR_PLAYER4;
+extern const SDL_Color COLOR_POWERUP_BOMB;
+extern const SDL_Color COLOR_POWERUP_FIRE;
+extern const SDL_Color COLOR_POWERUP_SPEED;
+
+/* ===== HUD / TEXT COLORS ===== */
+extern const SDL_Color COLOR_TEXT_PRIMARY;
+extern const SDL_Color COLOR_TEXT_MUTED;
+extern const SDL_Color COLOR_TEXT_ACCENT;
+extern const SDL_Color COLOR_TEXT_OK;
+extern const SDL_Color COLOR_TEXT_BAD;
+extern const SDL_Color COLOR_DIVIDER;
@@ -1,38 +1,37 @@
-#include "graphics.h"
-
-// ===== FOG OF WAR OVERLAY =====
-void draw_fog_overlay(SDL_Renderer *renderer, GameState *state, int my_player_id) {
-    // No fog in non-fog-of-war modes
-    if (state->game_mode != GAME_MODE_FOG_OF_WAR) return;
-    
-    // Dead players see everything
-    if (my_player_id >= 0 && my_player_id < state->num_players) {
-        Player *my_player = &state->players[my_player_id];
-        if (!my_player->is_alive) return;  // Spectator view
-    }
-    
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        for (int x = 0; x < MAP_WIDTH; x++) {
-            // Calculate if this tile should be visible (7x7 square)
-            int visible = 1;
-            if (my_player_id >= 0 && my_player_id < state->num_players) {
-                Player *p = &state->players[my_player_id];
-                int dist_x = abs(p->x - x);
-                int dist_y = abs(p->y - y);
-                // 7x7 square: 3 tiles in each direction from player
-                visible = (dist_x <= 3 && dist_y <= 3);
-            }
-            
-            if (!visible) {
-                // Draw dark overlay for unseen tiles
-                SDL_Rect fog_rect = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
-                SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);  // Dark overlay
-                SDL_RenderFillRect(renderer, &fog_rect);
-            }
-        }
-    }
-    
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-}
+#include "graphics.h"
+#include "visibility.h"
+
+// ===== FOG OF WAR OVERLAY =====
+// Same line-of-sight rules as the server (common/visibility.c), so the dark
+// tiles here are exactly the ones the server blanked out.
+void draw_fog_overlay(SDL_Renderer *renderer, GameState *state, int my_player_id) {
+    // No fog in non-fog-of-war modes
+    if (state->game_mode != GAME_MODE_FOG_OF_WAR) return;
+
+    // Spectators see the server's view as is
+    if (my_player_id < 0 || my_player_id >= state->num_players) return;
+
+    // Dead players see everything
+    Player *my_player = &state->players[my_player_id];
+    if (!my_player->is_alive) return;
+
+    VisOpacity opacity;
+    uint64_t seen[VIS_MAX_ROWS];
+    vis_build_opacity(&opacity, &state->map[0][0], MAP_WIDTH, MAP_HEIGHT, MAP_WIDTH);
+    vis_compute(&opacity, my_player->x - state->view_x, my_player->y - state->view_y,
+                state->fog_radius, seen);
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);  // Dark overlay
+
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            if (!vis_is_set(seen, x, y)) {
+                SDL_Rect fog_rect = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+                SDL_RenderFillRect(renderer, &fog_rect);
+            }
+        }
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
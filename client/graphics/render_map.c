@@ -1,13 +1,13 @@
-#include "graphics.h"
-
-void draw_tile(SDL_Renderer *renderer, int x, int y, SDL_Color color, int draw_border) {
-    SDL_Rect rect = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderFillRect(renderer, &rect);
-    
-    if (draw_border) {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        SDL_RenderDrawRect(renderer, &rect);
-    }
-}
-
+#include "graphics.h"
+
+void draw_tile(SDL_Renderer *renderer, int x, int y, SDL_Color color, int draw_border) {
+    SDL_Rect rect = {x * TILE_SIZE, y * TILE_SIZE, TILE_SIZE, TILE_SIZE};
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+    
+    if (draw_border) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderDrawRect(renderer, &rect);
+    }
+}
+
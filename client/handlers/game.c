@@ -1,33 +1,53 @@
-/* client/handlers/game.c */
-#include "../state/client_state.h"
-#include "../graphics/graphics.h" // for add_notification
-
-void check_game_changes() {
-    // Kiểm tra người chơi chết
-    for (int i = 0; i < current_state.num_players; i++) {
-        if (previous_state.players[i].is_alive && !current_state.players[i].is_alive) {
-            char msg[128];
-            snprintf(msg, sizeof(msg), "%s has been defeated!", 
-                    current_state.players[i].username);
-            add_notification(msg, (SDL_Color){255, 68, 68, 255});
-        }
-        
-        // Kiểm tra power-up
-        if (current_state.players[i].max_bombs > previous_state.players[i].max_bombs) {
-            if (i == my_player_id) { // Chỉ thông báo cho người chơi hiện tại
-                add_notification("Picked up BOMB power-up! +1 Bomb", 
-                               (SDL_Color){255, 215, 0, 255});
-            }
-        }
-        
-        if (current_state.players[i].bomb_range > previous_state.players[i].bomb_range) {
-            if (i == my_player_id) {
-                add_notification("Picked up FIRE power-up! +1 Blast Range", 
-                               (SDL_Color){255, 69, 0, 255});
-            }
-        }
-    }
-    
-    // Cập nhật previous state
-    memcpy(&previous_state, &current_state, sizeof(GameState));
-}
\ No newline at end of file
+/* client/handlers/game.c */
+#include "../state/client_state.h"
+#include "../graphics/graphics.h" // for add_notification
+
+void check_game_changes() {
+    int me = my_view_slot();
+    
+    // Views may reorder or drop players (arena), so pair them up by id
+    for (int i = 0; i < current_state.num_players; i++) {
+        Player *cur = &current_state.players[i];
+        Player *prev = NULL;
+        for (int j = 0; j < previous_state.num_players; j++) {
+            if (previous_state.players[j].id == cur->id) {
+                prev = &previous_state.players[j];
+                break;
+            }
+        }
+        if (!prev) continue;
+        
+        // Kiểm tra người chơi chết
+        if (prev->is_alive && !cur->is_alive) {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "%s has been defeated!", 
+                    cur->username);
+            add_notification(msg, (SDL_Color){255, 68, 68, 255});
+        }
+        
+        // Kiểm tra power-up
+        if (cur->max_bombs > prev->max_bombs) {
+            if (i == me) { // Chỉ thông báo cho người chơi hiện tại
+                add_notification("Picked up BOMB power-up! +1 Bomb", 
+                               (SDL_Color){255, 215, 0, 255});
+            }
+        }
+        
+        if (cur->bomb_range > prev->bomb_range) {
+            if (i == me) {
+                add_notification("Picked up FIRE power-up! +1 Blast Range", 
+                               (SDL_Color){255, 69, 0, 255});
+            }
+        }
+        
+        if (cur->move_speed > prev->move_speed && prev->move_speed > 0) {
+            if (i == me) {
+                add_notification("Picked up SPEED power-up! +1 Speed", 
+                               (SDL_Color){0, 191, 255, 255});
+            }
+        }
+    }
+    
+    // Cập nhật previous state
+    memcpy(&previous_state, &current_state, sizeof(GameState));
+}
@@ -1,7 +1,7 @@
-/* client/handlers/game.h */
-#ifndef GAME_HANDLER_H
-#define GAME_HANDLER_H
-
-void check_game_changes();
-
+/* client/handlers/game.h */
+#ifndef GAME_HANDLER_H
+#define GAME_HANDLER_H
+
+void check_game_changes();
+
 #endif
\ No newline at end of file
@@ -1,27 +1,27 @@
-#include "ui.h"
-// --- BẢNG MÀU CẢI TIẾN (Modern Dark Theme) ---
-const SDL_Color CLR_BG          = {15, 23, 42, 255};      // Nền xanh đậm sang trọng
-const SDL_Color CLR_GRID        = {30, 41, 59, 255};      // Lưới nhẹ
-const SDL_Color CLR_PRIMARY     = {59, 130, 246, 255};    // Xanh dương sáng
-const SDL_Color CLR_PRIMARY_DK  = {37, 99, 235, 255};     // Xanh đậm hơn
-const SDL_Color CLR_ACCENT      = {251, 146, 60, 255};    // Cam Bomberman
-const SDL_Color CLR_ACCENT_DK   = {234, 88, 12, 255};     // Cam đậm
-const SDL_Color CLR_WHITE       = {248, 250, 252, 255};   // Trắng nhẹ
-const SDL_Color CLR_GRAY        = {148, 163, 184, 255};   // Xám trung bình
-const SDL_Color CLR_GRAY_LIGHT  = {203, 213, 225, 255};   // Xám sáng
-const SDL_Color CLR_INPUT_BG    = {30, 41, 59, 255};      // Nền input
-const SDL_Color CLR_BTN_NORM    = {59, 130, 246, 255};    // Nút xanh
-const SDL_Color CLR_BTN_HOVER   = {96, 165, 250, 255};    // Hover sáng hơn
-const SDL_Color CLR_SUCCESS     = {40, 200, 40, 255};     // Xanh lá
-const SDL_Color CLR_DANGER      = {239, 68, 68, 255};     // Đỏ
-const SDL_Color CLR_WARNING     = {234, 179, 8, 255};     // Vàng
-const SDL_Color CLR_PURPLE      = {139, 92, 246, 255};    // Tím (Host)
-const SDL_Color CLR_PURPLE_DARK = {109, 40, 217, 255};    // Tím đậm
-
-// --- GRADIENT & GLOW COLORS ---
-const SDL_Color CLR_ACCENT_LIGHT = {255, 176, 102, 255};  // Cam sáng (gradient)
-const SDL_Color CLR_PRIMARY_LIGHT = {96, 165, 250, 255};  // Xanh sáng hơn
-const SDL_Color CLR_BG_DARK = {8, 15, 30, 255};           // Nền đậm nhất
-const SDL_Color CLR_GLOW = {255, 255, 255, 60};           // Glow hover
-const SDL_Color CLR_SHADOW_SOFT = {0, 0, 0, 30};           // Soft shadows
+#include "ui.h"
+// --- BẢNG MÀU CẢI TIẾN (Modern Dark Theme) ---
+const SDL_Color CLR_BG          = {15, 23, 42, 255};      // Nền xanh đậm sang trọng
+const SDL_Color CLR_GRID        = {30, 41, 59, 255};      // Lưới nhẹ
+const SDL_Color CLR_PRIMARY     = {59, 130, 246, 255};    // Xanh dương sáng
+const SDL_Color CLR_PRIMARY_DK  = {37, 99, 235, 255};     // Xanh đậm hơn
+const SDL_Color CLR_ACCENT      = {251, 146, 60, 255};    // Cam Bomberman
+const SDL_Color CLR_ACCENT_DK   = {234, 88, 12, 255};     // Cam đậm
+const SDL_Color CLR_WHITE       = {248, 250, 252, 255};   // Trắng nhẹ
+const SDL_Color CLR_GRAY        = {148, 163, 184, 255};   // Xám trung bình
+const SDL_Color CLR_GRAY_LIGHT  = {203, 213, 225, 255};   // Xám sáng
+const SDL_Color CLR_INPUT_BG    = {30, 41, 59, 255};      // Nền input
+const SDL_Color CLR_BTN_NORM    = {59, 130, 246, 255};    // Nút xanh
+const SDL_Color CLR_BTN_HOVER   = {96, 165, 250, 255};    // Hover sáng hơn
+const SDL_Color CLR_SUCCESS     = {40, 200, 40, 255};     // Xanh lá
+const SDL_Color CLR_DANGER      = {239, 68, 68, 255};     // Đỏ
+const SDL_Color CLR_WARNING     = {234, 179, 8, 255};     // Vàng
+const SDL_Color CLR_PURPLE      = {139, 92, 246, 255};    // Tím (Host)
+const SDL_Color CLR_PURPLE_DARK = {109, 40, 217, 255};    // Tím đậm
+
+// --- GRADIENT & GLOW COLORS ---
+const SDL_Color CLR_ACCENT_LIGHT = {255, 176, 102, 255};  // Cam sáng (gradient)
+const SDL_Color CLR_PRIMARY_LIGHT = {96, 165, 250, 255};  // Xanh sáng hơn
+const SDL_Color CLR_BG_DARK = {8, 15, 30, 255};           // Nền đậm nhất
+const SDL_Color CLR_GLOW = {255, 255, 255, 60};           // Glow hover
+const SDL_Color CLR_SHADOW_SOFT = {0, 0, 0, 30};           // Soft shadows
 const SDL_Color CLR_SHADOW_HARD = {0, 0, 0, 80};           // Hard shadows
\ No newline at end of file
@@ -0,0 +1,62 @@
+/* common/packet.c - Variable-size framing for ServerPacket */
+#include "packet.h"
+
+#define PAYLOAD_SIZE(member) (SERVER_PACKET_HEADER_SIZE + sizeof(((ServerPacket *)0)->payload.member))
+
+size_t server_packet_wire_size(const ServerPacket *packet) {
+    switch (packet->type) {
+        case MSG_AUTH_RESPONSE:         return PAYLOAD_SIZE(auth);
+        case MSG_LOBBY_LIST:            return PAYLOAD_SIZE(lobby_list);
+        case MSG_LOBBY_DELTA:           return PAYLOAD_SIZE(lobby_delta);
+        case MSG_FRIEND_LIST_RESPONSE:  return PAYLOAD_SIZE(friend_list);
+        case MSG_LEADERBOARD_RESPONSE:
+        case MSG_LEADERBOARD_AROUND_RESPONSE: return PAYLOAD_SIZE(leaderboard);
+        case MSG_RANK_RESPONSE:         return PAYLOAD_SIZE(rank);
+        case MSG_FRIEND_PRESENCE:       return PAYLOAD_SIZE(friend_status);
+        case MSG_QUEUE_STATUS:          return PAYLOAD_SIZE(queue_status);
+        case MSG_MATCH_HISTORY_RESPONSE: {
+            // Sized by its row count, carried in the header
+            int count = packet->code;
+            if (count < 0) count = 0;
+            if (count > MATCH_HISTORY_PAGE_MAX) count = MATCH_HISTORY_PAGE_MAX;
+            return offsetof(ServerPacket, payload.match_history.entries) +
+                   count * sizeof(MatchHistoryEntry);
+        }
+        case MSG_SEARCH_USERS_RESPONSE: {
+            int count = packet->code;
+            if (count < 0) count = 0;
+            if (count > SEARCH_RESULTS_MAX) count = SEARCH_RESULTS_MAX;
+            return offsetof(ServerPacket, payload.user_search.results) +
+                   count * sizeof(UserSearchResult);
+        }
+        case MSG_BROWSE_LOBBIES_RESPONSE: {
+            int count = packet->code;
+            if (count < 0) count = 0;
+            if (count > LOBBY_LIST_MAX) count = LOBBY_LIST_MAX;
+            return offsetof(ServerPacket, payload.lobby_page.lobbies) +
+                   count * sizeof(LobbySummary);
+        }
+        case MSG_LOBBY_UPDATE: {
+            // A 4-player room should not pay for the 64-slot arena roster
+            int count = packet->code;
+            if (count < 0) count = 0;
+            if (count > MAX_LOBBY_PLAYERS) count = MAX_LOBBY_PLAYERS;
+            return offsetof(ServerPacket, payload.lobby.players) + count * sizeof(Player);
+        }
+        case MSG_GAME_STATE:            return PAYLOAD_SIZE(game_state);
+        case MSG_PROFILE_RESPONSE:      return PAYLOAD_SIZE(profile);
+        case MSG_PROFILE_DETAIL_RESPONSE: return PAYLOAD_SIZE(profile_detail);
+        case MSG_CHAT:                  return PAYLOAD_SIZE(chat_msg);
+        case MSG_CHAT_BACKLOG: {
+            int length = packet->code;
+            if (length < 0) length = 0;
+            if (length > CHAT_BACKLOG_BYTES) length = CHAT_BACKLOG_BYTES;
+            return offsetof(ServerPacket, payload.chat_backlog.records) + length;
+        }
+        case MSG_INVITE_RECEIVED:       return PAYLOAD_SIZE(invite);
+        case MSG_NOTIFICATION:
+        case MSG_ERROR:
+        case MSG_FRIEND_RESPONSE:       return SERVER_PACKET_HEADER_SIZE;
+        default:                        return sizeof(ServerPacket);
+    }
+}
@@ -0,0 +1,17 @@
+/* common/packet.h - Variable-size framing for ServerPacket */
+#ifndef PACKET_H
+#define PACKET_H
+
+#include <stddef.h>
+#include "protocol.h"
+
+// A ServerPacket goes on the wire as its fixed header (type, code, message)
+// followed by only the union member that its type uses. The receiver reads
+// the header, then server_packet_wire_size(header) - header more bytes.
+// Paged lists (match history, user search) send only the rows in use:
+// 'code' is the count.
+#define SERVER_PACKET_HEADER_SIZE offsetof(ServerPacket, payload)
+
+size_t server_packet_wire_size(const ServerPacket *packet);
+
+#endif
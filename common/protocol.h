@@ -1,275 +1,449 @@
-#ifndef PROTOCOL_H
-#define PROTOCOL_H
-
-#include <stdint.h>
-
-#define PORT 8081
-#define MAX_CLIENTS 4
-#define MAX_LOBBIES 10
-#define MAX_USERNAME 32
-#define MAX_SPECTATORS 4
-#define MAX_PASSWORD 128
-#define MAX_ROOM_NAME 64
-#define MAX_EMAIL 128
-#define MAX_DISPLAY_NAME 64
-
-// Map config
-#define MAP_WIDTH 15
-#define MAP_HEIGHT 13
-
-// Game modes
-#define GAME_MODE_CLASSIC 0
-#define GAME_MODE_SUDDEN_DEATH 1
-#define GAME_MODE_FOG_OF_WAR 2
-
-// Tile types
-#define EMPTY 0
-#define WALL_HARD 1
-#define WALL_SOFT 2
-#define BOMB 3
-#define EXPLOSION 4
-#define POWERUP_BOMB 5      // Tăng số bom
-#define POWERUP_FIRE 6      // Tăng tầm nổ
-
-#define MOVE_UP 0
-#define MOVE_DOWN 1
-#define MOVE_LEFT 2
-#define MOVE_RIGHT 3
-
-// Message types
-#define MSG_REGISTER 1
-#define MSG_LOGIN 2
-#define MSG_CREATE_LOBBY 3
-#define MSG_JOIN_LOBBY 4
-#define MSG_LIST_LOBBIES 5
-#define MSG_LEAVE_LOBBY 6
-#define MSG_START_GAME 7
-#define MSG_GAME_STATE 8
-#define MSG_MOVE 9
-#define MSG_PLANT_BOMB 10
-#define MSG_LEAVE_GAME 11
-#define MSG_FRIEND_REQUEST 12
-#define MSG_FRIEND_ACCEPT 13
-#define MSG_FRIEND_DECLINE 14
-#define MSG_FRIEND_REMOVE 15
-#define MSG_FRIEND_LIST 16
-#define MSG_FRIEND_LIST_RESPONSE 17
-#define MSG_FRIEND_RESPONSE 18
-#define MSG_LOBBY_UPDATE 19
-#define MSG_LOBBY_LIST 20
-#define MSG_READY 21
-#define MSG_CHAT 22
-#define MSG_GET_PROFILE 23
-#define MSG_PROFILE_RESPONSE 24
-#define MSG_GET_LEADERBOARD 25
-#define MSG_LEADERBOARD_RESPONSE 26
-#define MSG_NOTIFICATION 27
-#define MSG_ERROR 28
-#define MSG_FRIEND_INVITE 30
-#define MSG_INVITE_RECEIVED 31
-#define MSG_INVITE_RESPONSE 32
-#define MSG_AUTH_RESPONSE 33
-#define MSG_RECONNECT 34
-#define MSG_LOGIN_WITH_TOKEN 35
-#define MSG_SPECTATE 36
-#define MSG_KICK_PLAYER 38
-#define MSG_SET_ROOM_PRIVATE 39
-
-// Lobby status
-#define LOBBY_WAITING 0
-#define LOBBY_PLAYING 1
-
-// Game status
-#define GAME_WAITING 0
-#define GAME_RUNNING 1
-#define GAME_ENDED 2
-
-// ===== AUTH RESULT CODES =====
-#define AUTH_SUCCESS              0
-#define AUTH_FAIL                 1
-#define AUTH_FAILED               AUTH_FAIL   // backward compatibility
-// Registration errors
-#define AUTH_USER_EXISTS          2
-#define AUTH_INVALID_USERNAME     3
-#define AUTH_INVALID_EMAIL        4
-#define AUTH_INVALID_PASSWORD     5
-#define AUTH_USERNAME_EXISTS      6
-#define AUTH_EMAIL_EXISTS         7
-// Login errors
-#define AUTH_USER_NOT_FOUND       8
-#define AUTH_WRONG_PASSWORD       9
-
-// Server response codes (errors)
-#define ERR_LOBBY_NOT_FOUND -2
-#define ERR_LOBBY_GAME_IN_PROGRESS -3
-#define ERR_LOBBY_FULL -4
-#define ERR_LOBBY_WRONG_ACCESS_CODE -5
-#define ERR_LOBBY_LOCKED -6
-#define ERR_LOBBY_DUPLICATE_USER -7  // User already in lobby
-#define ERR_NOT_HOST 3
-#define ERR_NOT_ENOUGH_PLAYERS 4
-#define ERR_ALREADY_IN_LOBBY 5
-
-// Player structure - WITH POWER-UPS AND ELO
-typedef struct {
-    int id;
-    int x, y;
-    int is_alive;
-    int is_ready;
-    char username[MAX_USERNAME];
-    char display_name[MAX_DISPLAY_NAME];  // Mutable display name
-    int elo_rating;                       // ELO ranking
-    int max_bombs;                        // Max bombs can place
-    int bomb_range;                       // Explosion range
-    int current_bombs;                    // Current bombs placed
-} Player;
-
-// Friend info structure
-typedef struct {
-    int user_id;
-    char display_name[MAX_DISPLAY_NAME];
-    int elo_rating;
-    int is_online;  // 0=offline, 1=online, 2=in-game
-} FriendInfo;
-
-// Profile/Statistics structure
-typedef struct {
-    char username[MAX_USERNAME];
-    char display_name[MAX_DISPLAY_NAME];
-    int elo_rating;
-    int tier;  // 0=Bronze, 1=Silver, 2=Gold, 3=Diamond
-    int total_matches;
-    int wins;
-    int total_kills;
-    int deaths;
-} ProfileData;
-
-// Leaderboard entry
-typedef struct {
-    int rank;
-    char display_name[MAX_DISPLAY_NAME];
-    int elo_rating;
-    int wins;
-} LeaderboardEntry;
-
-// Lobby structure
-typedef struct {
-    int id;
-    char name[64];
-    char host_username[MAX_USERNAME];
-    int host_id;
-    Player players[MAX_CLIENTS];
-    int num_players;
-    int spectator_count;
-    char spectators[MAX_SPECTATORS][MAX_USERNAME];
-    int status;                  // LOBBY_WAITING or LOBBY_PLAYING
-    int is_private;              // 0 = public, 1 = private
-    char access_code[8];         // 6-digit code (plus null terminator)
-    int is_locked;               // 0 = unlocked, 1 = locked (no new joins)
-    int game_mode;               // Game mode: 0=Classic, 1=Sudden Death, 2=Fog of War
-} Lobby;
-
-// Lightweight Lobby Summary for lists
-typedef struct {
-    int id;
-    char name[MAX_ROOM_NAME];
-    int num_players;
-    int max_players;
-    int spectator_count;
-    int game_mode;
-    int status;
-    int is_private;
-    int is_locked;
-} LobbySummary;
-
-// Game state
-typedef struct {
-    int map[MAP_HEIGHT][MAP_WIDTH];
-    Player players[MAX_CLIENTS];
-    int num_players;
-    int game_status;
-    int winner_id;
-    int kills[MAX_CLIENTS];  // Kill count per player this match
-    int elo_changes[MAX_CLIENTS];  // ELO change for each player (+/-)
-    long long match_start_time;  // Unix timestamp when match started
-    int match_duration_seconds;  // Match duration in seconds
-    long long end_game_time;
-    int game_mode;               // Active game mode (0=Classic, 1=Sudden Death, 2=Fog of War)
-    int fog_radius;              // Fog of war visibility radius in tiles (5 = default)
-    int sudden_death_timer;      // 1800 ticks (90 seconds at 20 ticks/sec)
-    int shrink_zone_left;        // Safe zone left boundary
-    int shrink_zone_right;       // Safe zone right boundary
-    int shrink_zone_top;         // Safe zone top boundary
-    int shrink_zone_bottom;      // Safe zone bottom boundary
-    long long start_game_time;   // Server timestamp when game started
-} GameState;
-
-// Client packet - ENHANCED
-typedef struct {
-    int type;
-    char username[MAX_USERNAME];
-    char password[MAX_PASSWORD];
-    char email[MAX_EMAIL];             // For registration
-    char display_name[MAX_DISPLAY_NAME]; // For profile updates, etc.
-    
-    // For friend operations
-    char target_display_name[MAX_DISPLAY_NAME]; // For friend requests
-    int target_user_id;  // For accept/decline/remove friend
-    
-    // For lobby
-    int lobby_id;
-    char room_name[MAX_ROOM_NAME];     // For creating lobby
-    int data;                          // Multi-purpose: direction, player_id, etc.
-    char access_code[8];               // For joining private rooms
-    int is_private;                    // For creating private rooms
-    int target_player_id;              // For kick, spectator view
-    int game_mode;                     // For room creation: game mode selection
-    char chat_message[200];            // For chat messages
-    char session_token[64];            // For reconnection and auto-login
-} ClientPacket;
-
-// Server packet - ENHANCED
-typedef struct {
-    int type;
-    int code;
-    char message[256];
-    union {
-        struct {
-            int user_id;
-            char username[MAX_USERNAME];
-            char display_name[MAX_DISPLAY_NAME];
-            int elo_rating;
-            char session_token[64];
-        } auth;
-        struct {
-            LobbySummary lobbies[MAX_LOBBIES];
-            int count;
-        } lobby_list;
-        struct {
-            FriendInfo friends[50];
-            int count;
-        } friend_list;
-        struct {
-            LeaderboardEntry entries[100];
-            int count;
-        } leaderboard;
-        Lobby lobby;
-        GameState game_state;
-        ProfileData profile;
-        struct {
-            char sender_username[MAX_USERNAME];
-            char message[200];
-            uint32_t timestamp;
-            int player_id;  // For color coding
-        } chat_msg;
-        struct {
-            int lobby_id;
-            char room_name[MAX_ROOM_NAME];
-            char host_name[MAX_USERNAME];
-            char access_code[8];  // For password bypass
-            int game_mode;
-        } invite;
-    } payload;
-} ServerPacket;
-
-#endif
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+#define PORT 8081
+#define MAX_CLIENTS 4            // Players in a standard match
+#define MAX_ARENA_PLAYERS 64     // Players in a large-arena match
+#define MAX_LOBBY_PLAYERS MAX_ARENA_PLAYERS
+#define MAX_VIEW_PLAYERS 8       // Player slots in one GameState view
+#define LOBBY_LIST_MAX 10        // Lobbies per MSG_LOBBY_LIST
+#define CHAT_HISTORY_MAX 50      // Chat messages a room keeps (and a client shows)
+#define CHAT_BACKLOG_BYTES 4096  // Packed MSG_CHAT_BACKLOG records; newest that fit
+#define MAX_USERNAME 32
+#define MAX_SPECTATORS 4
+#define MAX_PASSWORD 128
+#define MAX_ROOM_NAME 64
+#define MAX_EMAIL 128
+#define MAX_DISPLAY_NAME 64
+
+// Map config. A GameState carries one MAP_WIDTH x MAP_HEIGHT window of the
+// world; standard maps are exactly that size, arenas are bigger.
+#define MAP_WIDTH 15
+#define MAP_HEIGHT 13
+
+// Game modes
+#define GAME_MODE_CLASSIC 0
+#define GAME_MODE_SUDDEN_DEATH 1
+#define GAME_MODE_FOG_OF_WAR 2
+#define GAME_MODE_ARENA 3        // Large map, 16-64 players, windowed views
+#define NUM_GAME_MODES 4
+
+// Tile types
+#define EMPTY 0
+#define WALL_HARD 1
+#define WALL_SOFT 2
+#define BOMB 3
+#define EXPLOSION 4
+#define POWERUP_BOMB 5      // Tăng số bom
+#define POWERUP_FIRE 6      // Tăng tầm nổ
+#define POWERUP_SPEED 7     // Faster movement
+
+#define MOVE_UP 0
+#define MOVE_DOWN 1
+#define MOVE_LEFT 2
+#define MOVE_RIGHT 3
+#define MOVE_NONE -1        // MSG_MOVE data: direction released
+
+// Sub-tile positions are fixed point: TILE_FP units per tile, and a player
+// standing in the middle of tile (x, y) is at (x * TILE_FP, y * TILE_FP)
+#define TILE_FP 256
+
+// Message types
+#define MSG_REGISTER 1
+#define MSG_LOGIN 2
+#define MSG_CREATE_LOBBY 3
+#define MSG_JOIN_LOBBY 4
+#define MSG_LIST_LOBBIES 5
+#define MSG_LEAVE_LOBBY 6
+#define MSG_START_GAME 7
+#define MSG_GAME_STATE 8
+#define MSG_MOVE 9
+#define MSG_PLANT_BOMB 10
+#define MSG_LEAVE_GAME 11
+#define MSG_FRIEND_REQUEST 12
+#define MSG_FRIEND_ACCEPT 13
+#define MSG_FRIEND_DECLINE 14
+#define MSG_FRIEND_REMOVE 15
+#define MSG_FRIEND_LIST 16
+#define MSG_FRIEND_LIST_RESPONSE 17
+#define MSG_FRIEND_RESPONSE 18
+#define MSG_LOBBY_UPDATE 19     // code = players sent
+#define MSG_LOBBY_LIST 20
+#define MSG_READY 21
+#define MSG_CHAT 22
+#define MSG_GET_PROFILE 23
+#define MSG_PROFILE_RESPONSE 24
+#define MSG_GET_LEADERBOARD 25
+#define MSG_LEADERBOARD_RESPONSE 26
+#define MSG_NOTIFICATION 27
+#define MSG_ERROR 28
+#define MSG_FRIEND_INVITE 30
+#define MSG_INVITE_RECEIVED 31
+#define MSG_INVITE_RESPONSE 32
+#define MSG_AUTH_RESPONSE 33
+#define MSG_RECONNECT 34
+#define MSG_LOGIN_WITH_TOKEN 35
+#define MSG_SPECTATE 36
+#define MSG_KICK_PLAYER 38
+#define MSG_SET_ROOM_PRIVATE 39
+#define MSG_GET_MY_RANK 41       // data = user id (0 = self)
+#define MSG_RANK_RESPONSE 42
+#define MSG_GET_LEADERBOARD_AROUND 43  // data = players either side, target_user_id (0 = self)
+#define MSG_LEADERBOARD_AROUND_RESPONSE 44
+#define MSG_FRIEND_PRESENCE 45   // Server push: a friend's PRESENCE_* changed
+#define MSG_GET_MATCH_HISTORY 46 // target_user_id (0 = self), data = page size, cursor
+#define MSG_MATCH_HISTORY_RESPONSE 47  // code = entries in this page, -1 = invalid cursor
+#define MSG_GET_PROFILE_DETAIL 48      // target_user_id (0 = self)
+#define MSG_PROFILE_DETAIL_RESPONSE 49
+#define MSG_QUEUE_JOIN 50        // Quick play: game_mode
+#define MSG_QUEUE_LEAVE 51
+#define MSG_QUEUE_STATUS 52      // Server push: code = QUEUE_*
+#define MSG_SEARCH_USERS 53      // target_display_name = query, data = max results (0 = all)
+#define MSG_SEARCH_USERS_RESPONSE 54   // code = results sent
+#define MSG_LOBBY_SUBSCRIBE 55   // Lobby browser open: data = last version seen (0 = none)
+#define MSG_LOBBY_UNSUBSCRIBE 56
+#define MSG_LOBBY_DELTA 57       // Server push to subscribers: one room changed
+#define MSG_BROWSE_LOBBIES 58    // data = LOBBY_FILTER_* | LOBBY_SORT_* << LOBBY_SORT_SHIFT, game_mode, cursor
+#define MSG_BROWSE_LOBBIES_RESPONSE 59 // code = rooms in this page
+#define MSG_CHAT_BACKLOG 60      // Room chat so far, on entering a room: code = record bytes
+
+// Lobby status
+#define LOBBY_WAITING 0
+#define LOBBY_PLAYING 1
+
+// Quick play queue status (MSG_QUEUE_STATUS code)
+#define QUEUE_WAITING 0
+#define QUEUE_MATCHED 1          // queue_status.lobby_id is the new room
+#define QUEUE_LEFT 2
+#define QUEUE_REJECTED 3         // message says why
+
+// Lobby list feed. Subscribers get one MSG_LOBBY_DELTA per room change, each
+// one version newer. A subscriber whose version is too old for the server's
+// recent deltas gets the whole list again as MSG_LOBBY_LIST chunks instead.
+#define LOBBY_DELTA_ADD 0
+#define LOBBY_DELTA_UPDATE 1
+#define LOBBY_DELTA_REMOVE 2     // Only lobby.id is set
+#define LOBBY_LIST_FIRST 1       // MSG_LOBBY_LIST code bits: first chunk (start over)
+#define LOBBY_LIST_LAST 2        // ... last chunk (list complete at 'version')
+
+// Lobby browsing (MSG_BROWSE_LOBBIES): filters, ANDed
+#define LOBBY_FILTER_MODE 1      // Only rooms of the packet's game_mode
+#define LOBBY_FILTER_JOINABLE 2  // Waiting, unlocked, a player slot free
+#define LOBBY_FILTER_FREE_SLOTS 4  // A player slot free, playing or not
+#define LOBBY_FILTER_PUBLIC 8    // No access code needed
+#define LOBBY_SORT_SHIFT 8
+#define LOBBY_SORT_NEWEST 0
+#define LOBBY_SORT_FULLEST 1     // Most players first
+#define LOBBY_SORT_MOST_FREE 2   // Most free player slots first
+
+// Game status
+#define GAME_WAITING 0
+#define GAME_RUNNING 1
+#define GAME_ENDED 2
+
+// ===== AUTH RESULT CODES =====
+#define AUTH_SUCCESS              0
+#define AUTH_FAIL                 1
+#define AUTH_FAILED               AUTH_FAIL   // backward compatibility
+// Registration errors
+#define AUTH_USER_EXISTS          2
+#define AUTH_INVALID_USERNAME     3
+#define AUTH_INVALID_EMAIL        4
+#define AUTH_INVALID_PASSWORD     5
+#define AUTH_USERNAME_EXISTS      6
+#define AUTH_EMAIL_EXISTS         7
+// Login errors
+#define AUTH_USER_NOT_FOUND       8
+#define AUTH_WRONG_PASSWORD       9
+#define AUTH_SERVER_BUSY          10  // Too many logins in progress, retry
+
+// Server response codes (errors)
+#define ERR_LOBBY_NOT_FOUND -2
+#define ERR_LOBBY_GAME_IN_PROGRESS -3
+#define ERR_LOBBY_FULL -4
+#define ERR_LOBBY_WRONG_ACCESS_CODE -5
+#define ERR_LOBBY_LOCKED -6
+#define ERR_LOBBY_DUPLICATE_USER -7  // User already in lobby
+#define ERR_NOT_HOST 3
+#define ERR_NOT_ENOUGH_PLAYERS 4
+#define ERR_ALREADY_IN_LOBBY 5
+
+// Player structure - WITH POWER-UPS AND ELO
+typedef struct {
+    int id;
+    int x, y;
+    int is_alive;
+    int is_ready;
+    char username[MAX_USERNAME];
+    char display_name[MAX_DISPLAY_NAME];  // Mutable display name
+    int elo_rating;                       // ELO ranking
+    int max_bombs;                        // Max bombs can place
+    int bomb_range;                       // Explosion range
+    int current_bombs;                    // Current bombs placed
+    int px, py;                           // Sub-tile position (TILE_FP units); x/y is the nearest tile
+    int move_dir;                         // Held direction (MOVE_NONE when standing still)
+    int move_speed;                       // TILE_FP units per second
+} Player;
+
+// Friend info structure
+typedef struct {
+    int user_id;
+    char display_name[MAX_DISPLAY_NAME];
+    int elo_rating;
+    int is_online;  // PRESENCE_*
+} FriendInfo;
+
+// FriendInfo.is_online
+#define PRESENCE_OFFLINE 0
+#define PRESENCE_ONLINE 1
+#define PRESENCE_IN_LOBBY 2
+
+// Profile/Statistics structure
+typedef struct {
+    char username[MAX_USERNAME];
+    char display_name[MAX_DISPLAY_NAME];
+    int elo_rating;
+    int tier;  // 0=Bronze, 1=Silver, 2=Gold, 3=Diamond
+    int total_matches;
+    int wins;
+    int total_kills;
+    int deaths;
+} ProfileData;
+
+// Leaderboard entry
+typedef struct {
+    int rank;
+    int user_id;
+    char display_name[MAX_DISPLAY_NAME];
+    int elo_rating;
+    int wins;
+} LeaderboardEntry;
+
+// Totals over a set of matches (one game mode, or one day)
+typedef struct {
+    int matches;
+    int wins;
+    int kills;
+    int deaths;
+    int play_seconds;            // Kills per minute = kills * 60 / play_seconds
+    int elo_change;
+} StatsRollup;
+
+// Profile plus per-mode totals and recent form
+#define PROFILE_RECENT_DAYS 14
+typedef struct {
+    ProfileData profile;
+    StatsRollup by_mode[NUM_GAME_MODES];
+    int recent_days[PROFILE_RECENT_DAYS];    // Unix day (time / 86400) of recent[i], newest first
+    StatsRollup recent[PROFILE_RECENT_DAYS];
+    int recent_count;                        // Days with matches in the window
+} ProfileDetail;
+
+// One match in a player's history, from that player's point of view
+#define MATCH_HISTORY_PAGE_MAX 50
+typedef struct {
+    int match_id;
+    uint32_t played_at;          // Unix time
+    int16_t elo_change;
+    uint16_t duration_seconds;
+    uint8_t placement;
+    uint8_t kills;
+    uint8_t num_players;
+    uint8_t won;
+} MatchHistoryEntry;
+
+// Display name search, best matches first
+#define SEARCH_RESULTS_MAX 10
+#define SEARCH_MATCH_EXACT 0
+#define SEARCH_MATCH_PREFIX 1
+#define SEARCH_MATCH_FUZZY 2     // Shares enough trigrams (typos, infixes)
+typedef struct {
+    int user_id;
+    char display_name[MAX_DISPLAY_NAME];
+    int elo_rating;
+    int is_online;               // PRESENCE_*
+    int match;                   // SEARCH_MATCH_*
+} UserSearchResult;
+
+// Quick play ticket, as reported to its owner
+typedef struct {
+    int game_mode;
+    int rating;                  // Rating the queue matches on
+    int window;                  // Current search window: rating +/- window
+    int wait_ms;                 // Time in queue so far (or until matched)
+    int expected_wait_ms;        // Recent median for this mode, -1 = unknown
+    int queue_size;              // Players waiting in this mode
+    int lobby_id;                // QUEUE_MATCHED only
+} QueueStatus;
+
+// Lobby structure
+typedef struct {
+    int id;
+    char name[64];
+    char host_username[MAX_USERNAME];
+    int host_id;
+    int num_players;
+    int max_players;             // MAX_CLIENTS, or MAX_ARENA_PLAYERS for arenas
+    int spectator_count;
+    char spectators[MAX_SPECTATORS][MAX_USERNAME];
+    int status;                  // LOBBY_WAITING or LOBBY_PLAYING
+    int is_private;              // 0 = public, 1 = private
+    char access_code[8];         // 6-digit code (plus null terminator)
+    int is_locked;               // 0 = unlocked, 1 = locked (no new joins)
+    int game_mode;               // Game mode: 0=Classic, 1=Sudden Death, 2=Fog of War, 3=Arena
+    int tick_rate;               // Simulation ticks per second, fixed at creation
+    Player players[MAX_LOBBY_PLAYERS];  // Last: MSG_LOBBY_UPDATE sends only num_players
+} Lobby;
+
+// Lightweight Lobby Summary for lists
+typedef struct {
+    int id;
+    char name[MAX_ROOM_NAME];
+    int num_players;
+    int max_players;
+    int spectator_count;
+    int game_mode;
+    int status;
+    int is_private;
+    int is_locked;
+} LobbySummary;
+
+typedef struct {
+    uint32_t version;            // Feed version after this change
+    int op;                      // LOBBY_DELTA_*
+    LobbySummary lobby;
+} LobbyDelta;
+
+// Game state as seen by one recipient. map[][] is the window starting at
+// (view_x, view_y) in world tiles; player x/y/px/py stay in world
+// coordinates. players[] holds the recipient (at self_slot) plus whoever is
+// near enough to matter; Player.id is the player's index in the lobby.
+typedef struct {
+    int map[MAP_HEIGHT][MAP_WIDTH];
+    Player players[MAX_VIEW_PLAYERS];
+    int num_players;             // Filled slots in players[]
+    int game_status;
+    int winner_id;               // Slot in players[], -1 = draw / not in view
+    int kills[MAX_VIEW_PLAYERS];  // Kill count per slot this match
+    int elo_changes[MAX_VIEW_PLAYERS];  // ELO change per slot (+/-)
+    long long match_start_time;  // Unix timestamp when match started
+    int match_duration_seconds;  // Match duration in seconds
+    long long end_game_time;
+    int game_mode;               // Active game mode (0=Classic, 1=Sudden Death, 2=Fog of War)
+    int fog_radius;              // Fog of war visibility radius in tiles (5 = default)
+    int sudden_death_timer;      // Remaining ticks (90 seconds * tick_rate)
+    int shrink_zone_left;        // Safe zone left boundary
+    int shrink_zone_right;       // Safe zone right boundary
+    int shrink_zone_top;         // Safe zone top boundary
+    int shrink_zone_bottom;      // Safe zone bottom boundary
+    long long start_game_time;   // Server timestamp when game started
+    int tick_rate;               // Ticks per second (sudden_death_timer is in ticks)
+    unsigned int tick;           // Simulation step counter
+    int view_x, view_y;          // World tile at map[0][0]
+    int world_width, world_height;
+    int self_slot;               // Recipient's slot in players[] (-1 = spectator)
+    int total_players;           // Players in the match (may exceed num_players)
+    int alive_players;
+} GameState;
+
+// Client packet - ENHANCED
+typedef struct {
+    int type;
+    char username[MAX_USERNAME];
+    char password[MAX_PASSWORD];
+    char email[MAX_EMAIL];             // For registration
+    char display_name[MAX_DISPLAY_NAME]; // For profile updates, etc.
+    
+    // For friend operations
+    char target_display_name[MAX_DISPLAY_NAME]; // For friend requests
+    int target_user_id;  // For accept/decline/remove friend
+    
+    // For lobby
+    int lobby_id;
+    char room_name[MAX_ROOM_NAME];     // For creating lobby
+    int data;                          // Multi-purpose: direction, player_id, etc.
+    char access_code[8];               // For joining private rooms
+    int is_private;                    // For creating private rooms
+    int target_player_id;              // For kick, spectator view
+    int game_mode;                     // For room creation: game mode selection
+    int tick_rate;                     // For room creation: ticks per second (0 = server default)
+    char chat_message[200];            // For chat messages
+    char session_token[64];            // For reconnection and auto-login
+    uint64_t cursor;                   // For paged queries: from the last page, 0 = first
+} ClientPacket;
+
+// Server packet - ENHANCED
+typedef struct {
+    int type;
+    int code;
+    char message[256];
+    union {
+        struct {
+            int user_id;
+            char username[MAX_USERNAME];
+            char display_name[MAX_DISPLAY_NAME];
+            int elo_rating;
+            char session_token[64];
+        } auth;
+        struct {
+            LobbySummary lobbies[LOBBY_LIST_MAX];
+            int count;
+            uint32_t version;        // Feed version the list is current at
+        } lobby_list;
+        struct {
+            FriendInfo friends[50];
+            int count;
+        } friend_list;
+        struct {
+            LeaderboardEntry entries[100];
+            int count;
+            int total_players;
+        } leaderboard;
+        struct {
+            LeaderboardEntry entry;
+            int total_players;
+        } rank;
+        struct {
+            uint64_t next_cursor;      // Opaque; 0 = no more pages
+            int user_id;
+            MatchHistoryEntry entries[MATCH_HISTORY_PAGE_MAX];  // Only 'code' are sent
+        } match_history;
+        struct {
+            uint64_t next_cursor;      // Opaque, for the same filters and sort; 0 = no more pages
+            int total;                 // Rooms passing the filters, all pages
+            LobbySummary lobbies[LOBBY_LIST_MAX];  // Only 'code' are sent
+        } lobby_page;
+        struct {
+            UserSearchResult results[SEARCH_RESULTS_MAX];  // Only 'code' are sent
+        } user_search;
+        LobbyDelta lobby_delta;
+        FriendInfo friend_status;
+        QueueStatus queue_status;
+        Lobby lobby;
+        GameState game_state;
+        ProfileData profile;
+        ProfileDetail profile_detail;
+        struct {
+            char sender_username[MAX_USERNAME];
+            char message[200];
+            uint32_t timestamp;
+            int player_id;  // For color coding
+        } chat_msg;
+        struct {
+            int lobby_id;
+            // Oldest first: player_id + 1 (one byte), sender\0, message\0
+            char records[CHAT_BACKLOG_BYTES];  // Only 'code' bytes are sent
+        } chat_backlog;
+        struct {
+            int lobby_id;
+            char room_name[MAX_ROOM_NAME];
+            char host_name[MAX_USERNAME];
+            char access_code[8];  // For password bypass
+            int game_mode;
+        } invite;
+    } payload;
+} ServerPacket;
+
+#endif
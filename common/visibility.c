@@ -0,0 +1,133 @@
+/* common/visibility.c - Line-of-sight fog of war */
+#include <stdlib.h>
+#include <string.h>
+#include "visibility.h"
+#include "protocol.h"
+
+#define VIS_SPAN (2 * VIS_MAX_RADIUS + 1)
+#define VIS_MAX_CELLS (VIS_SPAN * VIS_SPAN)
+#define VIS_MAX_PARENTS 3
+#define VIS_NO_PARENT VIS_MAX_CELLS   // Slot in pass[] that is always 0
+
+// Ray table for one radius. A Bresenham ray is traced from the origin to
+// every cell of the disc once, at startup; the rays are merged into a DAG
+// where each cell remembers the cells just before it on any ray. At runtime a
+// cell is visible when at least one of its parents is visible and clear, so
+// one pass in distance order replaces walking every ray.
+typedef struct {
+    int ready;
+    int num_cells;                              // Cell 0 is the origin
+    signed char dx[VIS_MAX_CELLS];
+    signed char dy[VIS_MAX_CELLS];
+    short parents[VIS_MAX_CELLS][VIS_MAX_PARENTS];  // VIS_NO_PARENT = unused
+} VisTable;
+
+static VisTable tables[VIS_MAX_RADIUS + 1];
+
+static int in_disc(int dx, int dy, int r) {
+    return dx * dx + dy * dy <= r * r + r;
+}
+
+static void add_parent(VisTable *t, int cell, int parent) {
+    for (int i = 0; i < VIS_MAX_PARENTS; i++) {
+        if (t->parents[cell][i] == parent) return;
+        if (t->parents[cell][i] == VIS_NO_PARENT) {
+            t->parents[cell][i] = (short)parent;
+            return;
+        }
+    }
+}
+
+static void build_table(int r) {
+    VisTable *t = &tables[r];
+    int index[VIS_SPAN][VIS_SPAN];
+    memset(index, -1, sizeof(index));
+
+    // Order cells by ring (Chebyshev distance) so parents always come first
+    int n = 0;
+    for (int d = 0; d <= r; d++) {
+        for (int dy = -d; dy <= d; dy++) {
+            for (int dx = -d; dx <= d; dx++) {
+                int ring = abs(dx) > abs(dy) ? abs(dx) : abs(dy);
+                if (ring != d || !in_disc(dx, dy, r)) continue;
+                index[dy + r][dx + r] = n;
+                t->dx[n] = (signed char)dx;
+                t->dy[n] = (signed char)dy;
+                for (int i = 0; i < VIS_MAX_PARENTS; i++) t->parents[n][i] = VIS_NO_PARENT;
+                n++;
+            }
+        }
+    }
+    t->num_cells = n;
+
+    for (int c = 1; c < n; c++) {
+        int x1 = t->dx[c], y1 = t->dy[c];
+        int adx = abs(x1), ady = abs(y1);
+        int sx = x1 < 0 ? -1 : 1, sy = y1 < 0 ? -1 : 1;
+        int err = adx - ady;
+        int x = 0, y = 0, prev = 0;
+
+        while (x != x1 || y != y1) {
+            int e2 = 2 * err;
+            if (e2 > -ady) { err -= ady; x += sx; }
+            if (e2 < adx)  { err += adx; y += sy; }
+            int cell = index[y + r][x + r];
+            if (cell < 0) continue;  // Clipped corner of the disc; never the target
+            add_parent(t, cell, prev);
+            prev = cell;
+        }
+    }
+    t->ready = 1;
+}
+
+void vis_init(void) {
+    for (int r = 0; r <= VIS_MAX_RADIUS; r++) {
+        if (!tables[r].ready) build_table(r);
+    }
+}
+
+void vis_build_opacity(VisOpacity *out, const int *map, int width, int height, int stride) {
+    if (width > 64) width = 64;
+    if (height > VIS_MAX_ROWS) height = VIS_MAX_ROWS;
+    out->width = width;
+    out->height = height;
+
+    for (int y = 0; y < height; y++) {
+        const int *row = map + y * stride;
+        uint64_t bits = 0;
+        for (int x = 0; x < width; x++) {
+            if (row[x] == WALL_HARD || row[x] == WALL_SOFT) bits |= 1ULL << x;
+        }
+        out->rows[y] = bits;
+    }
+}
+
+void vis_compute(const VisOpacity *opacity, int ox, int oy, int radius, uint64_t *out_rows) {
+    for (int y = 0; y < opacity->height; y++) out_rows[y] = 0;
+    if (ox < 0 || oy < 0 || ox >= opacity->width || oy >= opacity->height) return;
+
+    if (radius < 0) radius = 0;
+    if (radius > VIS_MAX_RADIUS) radius = VIS_MAX_RADIUS;
+    const VisTable *t = &tables[radius];
+    if (!t->ready) {
+        build_table(radius);
+    }
+
+    // pass[c]: cell c is visible and sight continues through it
+    unsigned char pass[VIS_MAX_CELLS + 1];
+    pass[VIS_NO_PARENT] = 0;
+    pass[0] = 1;
+    out_rows[oy] |= 1ULL << ox;
+
+    for (int c = 1; c < t->num_cells; c++) {
+        int x = ox + t->dx[c];
+        int y = oy + t->dy[c];
+        const short *p = t->parents[c];
+        pass[c] = 0;
+        if (!(pass[p[0]] | pass[p[1]] | pass[p[2]])) continue;
+        if (x < 0 || y < 0 || x >= opacity->width || y >= opacity->height) continue;
+
+        out_rows[y] |= 1ULL << x;
+        pass[c] = !((opacity->rows[y] >> x) & 1);
+    }
+}
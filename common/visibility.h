@@ -0,0 +1,32 @@
+/* common/visibility.h - Line-of-sight fog of war shared by client and server */
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include <stdint.h>
+
+#define VIS_MAX_RADIUS 8
+#define VIS_MAX_ROWS 64          // Map rows; each row is one 64-bit column mask
+
+// One bit per tile that blocks sight (hard and soft walls). Rebuilt from the
+// map whenever walls may have changed.
+typedef struct {
+    int width, height;
+    uint64_t rows[VIS_MAX_ROWS];
+} VisOpacity;
+
+// Build the ray tables for every radius. Call once at startup, before any
+// thread uses vis_compute().
+void vis_init(void);
+
+// map points at map[0][0]; 'stride' is the row length of the array in ints
+void vis_build_opacity(VisOpacity *out, const int *map, int width, int height, int stride);
+
+// Tiles visible from (ox, oy) within 'radius': out_rows[y] bit x is set when
+// the tile can be seen. Walls block sight but are themselves visible.
+void vis_compute(const VisOpacity *opacity, int ox, int oy, int radius, uint64_t *out_rows);
+
+static inline int vis_is_set(const uint64_t *rows, int x, int y) {
+    return (int)((rows[y] >> x) & 1);
+}
+
+#endif
@@ -0,0 +1,176 @@
+/* server/auth_pool.c - Worker threads for password hashing */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include "server.h"
+
+// A scrypt hash takes tens of milliseconds, so logins and registrations
+// queue their password work here instead of running it on the main loop.
+// Jobs finish in any order; finished ones wait in a second ring until
+// auth_pool_dispatch() runs their callbacks on the main loop.
+//
+// At most AUTH_QUEUE_SIZE jobs are in flight (queued, hashing or awaiting
+// dispatch). Past that, auth_pool_submit() refuses: a login flood gets
+// "busy" answers instead of an unbounded backlog of 16 MiB hashes.
+static AuthJob queue[AUTH_QUEUE_SIZE];
+static unsigned int queue_head, queue_tail;
+static AuthJob done[AUTH_QUEUE_SIZE];
+static unsigned int done_head, done_tail;
+static int in_flight = 0;
+static int stopping = 0;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_ready = PTHREAD_COND_INITIALIZER;
+static pthread_t *threads = NULL;
+static int num_threads = 0;
+static int wake_fd = -1;
+
+static void run_job(AuthJob *job) {
+    int needs_rehash = 0;
+    switch (job->type) {
+        case AUTH_JOB_HASH:
+            job->result = password_hash(job->password, job->salt, job->hash, sizeof(job->hash)) == 0
+                        ? AUTH_SUCCESS : AUTH_FAILED;
+            break;
+
+        case AUTH_JOB_VERIFY:
+            switch (password_verify(job->password, job->salt, job->hash, &needs_rehash)) {
+                case 1:  job->result = AUTH_SUCCESS; break;
+                case 0:  job->result = AUTH_WRONG_PASSWORD; break;
+                default: job->result = AUTH_FAILED; break;
+            }
+            // Upgrade legacy or under-cost hashes while we still have the password
+            if (job->result == AUTH_SUCCESS && needs_rehash) {
+                generate_salt(job->salt, sizeof(job->salt));
+                job->rehashed = password_hash(job->password, job->salt, job->hash, sizeof(job->hash)) == 0;
+            }
+            break;
+    }
+    memset(job->password, 0, sizeof(job->password));
+}
+
+static void* worker_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    while (1) {
+        while (queue_head == queue_tail && !stopping) {
+            pthread_cond_wait(&work_ready, &lock);
+        }
+        if (stopping) break;  // Queued logins are dropped; their clients are gone too
+
+        AuthJob job = queue[queue_head % AUTH_QUEUE_SIZE];
+        queue_head++;
+        pthread_mutex_unlock(&lock);
+        run_job(&job);
+        pthread_mutex_lock(&lock);
+
+        // in_flight bounds both rings, so this slot is free
+        done[done_tail % AUTH_QUEUE_SIZE] = job;
+        done_tail++;
+        memset(&job, 0, sizeof(job));
+        uint64_t one = 1;
+        if (write(wake_fd, &one, sizeof(one)) < 0) {
+            perror("[AUTH] eventfd write");
+        }
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+// Start 'count' hashing threads
+int auth_pool_start(int count) {
+    if (count < 1) count = 1;
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0) {
+        perror("[AUTH] eventfd");
+        return -1;
+    }
+    threads = calloc(count, sizeof(pthread_t));
+    if (!threads) return -1;
+
+    stopping = 0;
+    for (num_threads = 0; num_threads < count; num_threads++) {
+        if (pthread_create(&threads[num_threads], NULL, worker_main, NULL) != 0) {
+            fprintf(stderr, "[AUTH] Failed to start hashing thread\n");
+            auth_pool_stop();
+            return -1;
+        }
+    }
+    printf("[AUTH] Hashing pool started: %d thread(s), queue %d, scrypt ln=%d r=%d p=%d\n",
+           num_threads, AUTH_QUEUE_SIZE, PASSWORD_SCRYPT_LOG_N, PASSWORD_SCRYPT_R, PASSWORD_SCRYPT_P);
+    return 0;
+}
+
+// Readable whenever finished jobs are waiting for auth_pool_dispatch()
+int auth_pool_fd() {
+    return wake_fd;
+}
+
+// Queue a copy of 'job'. Returns -1 without queuing when the pool is full.
+int auth_pool_submit(const AuthJob *job) {
+    pthread_mutex_lock(&lock);
+    if (in_flight == AUTH_QUEUE_SIZE) {
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+    in_flight++;
+    queue[queue_tail % AUTH_QUEUE_SIZE] = *job;
+    queue_tail++;
+    pthread_cond_signal(&work_ready);
+    pthread_mutex_unlock(&lock);
+    return 0;
+}
+
+// Run callbacks for finished jobs. Main loop only.
+void auth_pool_dispatch() {
+    uint64_t count;
+    if (read(wake_fd, &count, sizeof(count)) < 0) {
+        // EAGAIN: already drained by an earlier dispatch
+    }
+
+    while (1) {
+        pthread_mutex_lock(&lock);
+        if (done_head == done_tail) {
+            pthread_mutex_unlock(&lock);
+            break;
+        }
+        AuthJob job = done[done_head % AUTH_QUEUE_SIZE];
+        memset(&done[done_head % AUTH_QUEUE_SIZE], 0, sizeof(AuthJob));
+        done_head++;
+        in_flight--;
+        pthread_mutex_unlock(&lock);
+
+        if (job.on_done) job.on_done(&job);
+    }
+}
+
+// Jobs submitted and not yet dispatched
+int auth_pool_pending() {
+    pthread_mutex_lock(&lock);
+    int n = in_flight;
+    pthread_mutex_unlock(&lock);
+    return n;
+}
+
+// Stop the threads once their current hash is done. Unstarted jobs are dropped.
+void auth_pool_stop() {
+    pthread_mutex_lock(&lock);
+    stopping = 1;
+    pthread_cond_broadcast(&work_ready);
+    pthread_mutex_unlock(&lock);
+
+    for (int i = 0; i < num_threads; i++) pthread_join(threads[i], NULL);
+    free(threads);
+    threads = NULL;
+    num_threads = 0;
+
+    memset(queue, 0, sizeof(queue));
+    memset(done, 0, sizeof(done));
+    queue_head = queue_tail = done_head = done_tail = 0;
+    in_flight = 0;
+    if (wake_fd >= 0) close(wake_fd);
+    wake_fd = -1;
+}
@@ -1,467 +1,371 @@
-/* server/database.c - SQLite3 Implementation */
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-#include <time.h>
-#include <sqlite3.h>
-#include "../common/protocol.h"
-#include "server.h"
-
-#define DB_FILE "bomberman.db"
-#define SCHEMA_FILE "server/schema.sql"
-
-sqlite3 *db = NULL;  // Exposed for other modules
-
-// Simple password hashing with salt (SHA-256 would be better in production)
-void generate_salt(char *salt, size_t len) {
-    const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-    for (size_t i = 0; i < len - 1; i++) {
-        salt[i] = charset[rand() % (sizeof(charset) - 1)];
-    }
-    salt[len - 1] = '\0';
-}
-
-void hash_password(const char *password, const char *salt, char *output) {
-    // Simple hash: concatenate password + salt and hash
-    // In production, use bcrypt or proper SHA-256
-    unsigned long hash = 5381;
-    char combined[512];
-    snprintf(combined, sizeof(combined), "%s%s", password, salt);
-    
-    const char *str = combined;
-    int c;
-    while ((c = *str++)) {
-        hash = ((hash << 5) + hash) + c;
-    }
-    snprintf(output, MAX_PASSWORD, "%lu", hash);
-}
-
-// Initialize database and create tables from schema
-int db_init() {
-    int rc = sqlite3_open(DB_FILE, &db);
-    if (rc != SQLITE_OK) {
-        fprintf(stderr, "[DB] Cannot open database: %s\n", sqlite3_errmsg(db));
-        return -1;
-    }
-    
-    printf("[DB] SQLite database opened: %s\n", DB_FILE);
-    
-    // Read and execute schema file
-    FILE *f = fopen(SCHEMA_FILE, "r");
-    if (!f) {
-        fprintf(stderr, "[DB] Cannot open schema file: %s\n", SCHEMA_FILE);
-        return -1;
-    }
-    
-    // Read schema file
-    fseek(f, 0, SEEK_END);
-    long fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    
-    char *schema = malloc(fsize + 1);
-    fread(schema, 1, fsize, f);
-    fclose(f);
-    schema[fsize] = '\0';
-    
-    // Execute schema
-    char *err_msg = NULL;
-    rc = sqlite3_exec(db, schema, NULL, NULL, &err_msg);
-    free(schema);
-    
-    if (rc != SQLITE_OK) {
-        fprintf(stderr, "[DB] Schema execution failed: %s\n", err_msg);
-        sqlite3_free(err_msg);
-        return -1;
-    }
-    
-    printf("[DB] Database initialized successfully\n");
-    srand(time(NULL)); // For salt generation
-    return 0;
-}
-
-void db_close() {
-    if (db) {
-        sqlite3_close(db);
-        printf("[DB] Database closed\n");
-    }
-}
-
-// Validate username (3-31 chars, alphanumeric + underscore)
-int validate_username(const char *username) {
-    int len = strlen(username);
-    if (len < 3 || len > MAX_USERNAME - 1) return 0;
-    for (int i = 0; i < len; i++) {
-        if (!isalnum(username[i]) && username[i] != '_') return 0;
-    }
-    return 1;
-}
-
-// Validate email (basic check for @ and .)
-int validate_email(const char *email) {
-    int len = strlen(email);
-    if (len < 5 || len > 127) return 0;
-    
-    int has_at = 0, has_dot_after_at = 0;
-    for (int i = 0; i < len; i++) {
-        if (email[i] == '@') {
-            if (has_at) return 0; // Multiple @
-            has_at = 1;
-        }
-        if (has_at && email[i] == '.') {
-            has_dot_after_at = 1;
-        }
-    }
-    return has_at && has_dot_after_at;
-}
-
-// Register new user
-int db_register_user(const char *username, const char *email, const char *password) {
-    if (!validate_username(username)) {
-        printf("[DB] Invalid username format: %s\n", username);
-        return AUTH_INVALID_USERNAME;
-    }
-
-    if (!validate_email(email)) {
-        printf("[DB] Invalid email format: %s\n", email);
-        return AUTH_INVALID_EMAIL;
-    }
-
-    if (strlen(password) < 4) {
-        printf("[DB] Password too short\n");
-        return AUTH_INVALID_PASSWORD;
-    }
-    
-    // Check if username/email already exists
-    int username_exists = 0;
-    int email_exists = 0;
-
-    sqlite3_stmt *stmt;
-    const char *check_user_sql = "SELECT id FROM Users WHERE username = ?";
-    
-    if (sqlite3_prepare_v2(db, check_user_sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[DB] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return AUTH_FAILED;
-    }
-    
-    sqlite3_bind_text(stmt, 1, username, -1, SQLITE_STATIC);
-    
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (rc == SQLITE_ROW) {
-        username_exists = 1;
-    }
-    
-    // Check if email already exists
-    const char *check_email_sql = "SELECT id FROM Users WHERE email = ?";
-    
-    if (sqlite3_prepare_v2(db, check_email_sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[DB] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return AUTH_FAILED;
-    }
-    
-    sqlite3_bind_text(stmt, 1, email, -1, SQLITE_STATIC);
-    
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (rc == SQLITE_ROW) {
-        email_exists = 1;
-    }
-
-    if (username_exists && email_exists) {
-        printf("[DB] Username and email already exist\n");
-        return AUTH_USER_EXISTS;
-    }
-
-    if (username_exists) {
-        printf("[DB] Username already exists\n");
-        return AUTH_USERNAME_EXISTS;
-    }
-
-    if (email_exists) {
-        printf("[DB] Email already exists\n");
-        return AUTH_EMAIL_EXISTS;
-    }
-    
-    // Generate salt and hash password
-    char salt[32];
-    char hash[MAX_PASSWORD];
-    generate_salt(salt, sizeof(salt));
-    hash_password(password, salt, hash);
-    
-    // Insert new user (display_name starts same as username)
-    const char *insert_sql = 
-        "INSERT INTO Users (username, display_name, email, password_hash, salt) "
-        "VALUES (?, ?, ?, ?, ?)";
-    
-    if (sqlite3_prepare_v2(db, insert_sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[DB] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return AUTH_FAILED;
-    }
-    
-    sqlite3_bind_text(stmt, 1, username, -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, username, -1, SQLITE_STATIC); // Initial display_name = username
-    sqlite3_bind_text(stmt, 3, email, -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 4, hash, -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 5, salt, -1, SQLITE_STATIC);
-    
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (rc != SQLITE_DONE) {
-        fprintf(stderr, "[DB] Insert failed: %s\n", sqlite3_errmsg(db));
-        return AUTH_FAILED;
-    }
-    
-    // Create default statistics record
-    int user_id = (int)sqlite3_last_insert_rowid(db);
-    const char *stats_sql = "INSERT INTO Statistics (user_id) VALUES (?)";
-    
-    if (sqlite3_prepare_v2(db, stats_sql, -1, &stmt, NULL) == SQLITE_OK) {
-        sqlite3_bind_int(stmt, 1, user_id);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-    }
-    
-    printf("[DB] Registered user: %s (email: %s, id: %d)\n", username, email, user_id);
-    return AUTH_SUCCESS;
-}
-
-// Login user (by username or email)
-int db_login_user(const char *identifier, const char *password, User *out_user) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT id, username, display_name, email, password_hash, salt, elo_rating "
-        "FROM Users WHERE username = ? OR email = ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[DB] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return AUTH_FAILED;
-    }
-    
-    sqlite3_bind_text(stmt, 1, identifier, -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, identifier, -1, SQLITE_STATIC);
-    
-    int rc = sqlite3_step(stmt);
-    
-    if (rc != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
-        printf("[DB] User not found: %s\n", identifier);
-        return AUTH_USER_NOT_FOUND;
-    }
-    
-    // Get stored hash and salt
-    const char *stored_hash = (const char *)sqlite3_column_text(stmt, 4);
-    const char *salt = (const char *)sqlite3_column_text(stmt, 5);
-    
-    // Hash provided password with stored salt
-    char computed_hash[MAX_PASSWORD];
-    hash_password(password, salt, computed_hash);
-    
-    // Compare hashes
-    if (strcmp(stored_hash, computed_hash) != 0) {
-        sqlite3_finalize(stmt);
-        printf("[DB] Invalid password for: %s\n", identifier);
-        return AUTH_WRONG_PASSWORD;
-    }
-    
-    // Populate user struct
-    if (out_user) {
-        out_user->id = sqlite3_column_int(stmt, 0);
-        strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
-        strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
-        strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
-        out_user->elo_rating = sqlite3_column_int(stmt, 6);
-        out_user->is_online = 1;
-        out_user->lobby_id = -1;
-    }
-    
-    sqlite3_finalize(stmt);
-    
-    // Update last_login
-    const char *update_sql = "UPDATE Users SET last_login = CURRENT_TIMESTAMP WHERE id = ?";
-    if (sqlite3_prepare_v2(db, update_sql, -1, &stmt, NULL) == SQLITE_OK) {
-        sqlite3_bind_int(stmt, 1, out_user->id);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
-    }
-    
-    printf("[DB] Login successful: %s (id: %d, ELO: %d)\n", 
-           out_user->username, out_user->id, out_user->elo_rating);
-    return AUTH_SUCCESS;
-}
-
-// Update user's display name
-int db_update_display_name(int user_id, const char *new_display_name) {
-    if (strlen(new_display_name) < 3 || strlen(new_display_name) > MAX_DISPLAY_NAME - 1) {
-        return -1;
-    }
-    
-    sqlite3_stmt *stmt;
-    const char *sql = "UPDATE Users SET display_name = ? WHERE id = ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
-    sqlite3_bind_text(stmt, 1, new_display_name, -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 2, user_id);
-    
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (rc == SQLITE_DONE) {
-        printf("[DB] Updated display name for user %d: %s\n", user_id, new_display_name);
-        return 0;
-    }
-    return -1;
-}
-
-// Get user by ID
-int db_get_user_by_id(int user_id, User *out_user) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT id, username, display_name, email, elo_rating "
-        "FROM Users WHERE id = ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
-    sqlite3_bind_int(stmt, 1, user_id);
-    
-    int rc = sqlite3_step(stmt);
-    
-    if (rc != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
-        return -1;
-    }
-    
-    if (out_user) {
-        out_user->id = sqlite3_column_int(stmt, 0);
-        strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
-        strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
-        strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
-        out_user->elo_rating = sqlite3_column_int(stmt, 4);
-    }
-    
-    sqlite3_finalize(stmt);
-    return 0;
-}
-
-// Find user by display name (for friend requests)
-int db_find_user_by_display_name(const char *display_name, User *out_user) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT id, username, display_name, email, elo_rating "
-        "FROM Users WHERE display_name = ? COLLATE NOCASE";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
-    sqlite3_bind_text(stmt, 1, display_name, -1, SQLITE_STATIC);
-    
-    int rc = sqlite3_step(stmt);
-    
-    if (rc != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
-        return -1;
-    }
-    
-    if (out_user) {
-        out_user->id = sqlite3_column_int(stmt, 0);
-        strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
-        strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
-        strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
-        out_user->elo_rating = sqlite3_column_int(stmt, 4);
-    }
-    
-    sqlite3_finalize(stmt);
-    return 0;
-}
-
-// Update user's ELO rating
-int db_update_elo(int user_id, int new_elo) {
-    sqlite3_stmt *stmt;
-    const char *sql = "UPDATE Users SET elo_rating = ? WHERE id = ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
-    sqlite3_bind_int(stmt, 1, new_elo);
-    sqlite3_bind_int(stmt, 2, user_id);
-    
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    return (rc == SQLITE_DONE) ? 0 : -1;
-}
-
-// Update session token for user
-int db_update_session_token(int user_id, const char *token) {
-    sqlite3_stmt *stmt;
-    // Set token and expiry (30 days from now)
-    const char *sql = "UPDATE Users SET session_token = ?, session_expiry = datetime('now', '+30 days') WHERE id = ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        printf("[DB] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return -1;
-    }
-    
-    sqlite3_bind_text(stmt, 1, token, -1, SQLITE_STATIC);
-    sqlite3_bind_int(stmt, 2, user_id);
-    
-    int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
-    
-    if (rc == SQLITE_DONE) {
-        // printf("[DB] Updated session token for user %d\n", user_id);
-        return 0;
-    }
-    return -1;
-}
-
-// Get user by session token (Auto-Login)
-int db_get_user_by_token(const char *token, User *out_user) {
-    sqlite3_stmt *stmt;
-    // Check token and expiry
-    const char *sql = 
-        "SELECT id, username, display_name, email, elo_rating "
-        "FROM Users WHERE session_token = ? AND session_expiry > datetime('now')";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
-    sqlite3_bind_text(stmt, 1, token, -1, SQLITE_STATIC);
-    
-    int rc = sqlite3_step(stmt);
-    
-    if (rc != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
-        return -1; // Token invalid or expired
-    }
-    
-    if (out_user) {
-        out_user->id = sqlite3_column_int(stmt, 0);
-        strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
-        strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
-        strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
-        out_user->elo_rating = sqlite3_column_int(stmt, 4);
-        out_user->is_online = 1;
-        out_user->lobby_id = -1;
-        strncpy(out_user->session_token, token, 63);
-    }
-    
-    sqlite3_finalize(stmt);
-    
-    // Refresh expiry
-    db_update_session_token(out_user->id, token);
-    
-    printf("[DB] Auto-login successful: %s via token\n", out_user->username);
-    return 0;
-}
+/* server/database.c - SQLite3 Implementation */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <sqlite3.h>
+#include "../common/protocol.h"
+#include "server.h"
+
+#define DB_FILE "bomberman.db"
+#define SCHEMA_FILE "server/schema.sql"
+
+sqlite3 *db = NULL;  // Exposed for other modules
+StmtRegistry db_stmts;
+
+// Open a connection to the game database. The main loop and the DB writer
+// thread each own one; WAL (set in db_init) lets them read and write at once.
+int db_open_connection(sqlite3 **out) {
+    if (sqlite3_open(DB_FILE, out) != SQLITE_OK) {
+        fprintf(stderr, "[DB] Cannot open database: %s\n", sqlite3_errmsg(*out));
+        sqlite3_close(*out);
+        *out = NULL;
+        return -1;
+    }
+    // Only one connection can write at a time; wait for the other instead of failing
+    sqlite3_busy_timeout(*out, 5000);
+    return 0;
+}
+
+// Add a column that was introduced after its table first shipped:
+// CREATE TABLE IF NOT EXISTS leaves older databases without it
+static int ensure_column(const char *table, const char *column, const char *decl) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM pragma_table_info(?) WHERE name = ?",
+                           -1, &stmt, NULL) != SQLITE_OK) {
+        return -1;
+    }
+    sqlite3_bind_text(stmt, 1, table, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, column, -1, SQLITE_STATIC);
+    int exists = (sqlite3_step(stmt) == SQLITE_ROW);
+    sqlite3_finalize(stmt);
+    if (exists) return 0;
+    
+    char sql[256];
+    snprintf(sql, sizeof(sql), "ALTER TABLE %s ADD COLUMN %s %s", table, column, decl);
+    if (sqlite3_exec(db, sql, NULL, NULL, NULL) != SQLITE_OK) {
+        fprintf(stderr, "[DB] Cannot add %s.%s: %s\n", table, column, sqlite3_errmsg(db));
+        return -1;
+    }
+    printf("[DB] Added column %s.%s\n", table, column);
+    return 0;
+}
+
+// Initialize database and create tables from schema
+int db_init() {
+    if (db_open_connection(&db) != 0) {
+        return -1;
+    }
+    
+    printf("[DB] SQLite database opened: %s\n", DB_FILE);
+    
+    // Readers on the main connection must not block behind the writer thread
+    int rc = sqlite3_exec(db, "PRAGMA journal_mode=WAL", NULL, NULL, NULL);
+    if (rc != SQLITE_OK) {
+        fprintf(stderr, "[DB] Cannot enable WAL: %s\n", sqlite3_errmsg(db));
+    }
+    
+    // Read and execute schema file
+    FILE *f = fopen(SCHEMA_FILE, "r");
+    if (!f) {
+        fprintf(stderr, "[DB] Cannot open schema file: %s\n", SCHEMA_FILE);
+        return -1;
+    }
+    
+    // Read schema file
+    fseek(f, 0, SEEK_END);
+    long fsize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    char *schema = malloc(fsize + 1);
+    fread(schema, 1, fsize, f);
+    fclose(f);
+    schema[fsize] = '\0';
+    
+    // Execute schema
+    char *err_msg = NULL;
+    rc = sqlite3_exec(db, schema, NULL, NULL, &err_msg);
+    free(schema);
+    
+    if (rc != SQLITE_OK) {
+        fprintf(stderr, "[DB] Schema execution failed: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        return -1;
+    }
+    
+    if (ensure_column("MatchHistory", "game_mode", "INTEGER DEFAULT 0") != 0) {
+        return -1;
+    }
+    
+    // Prepared after the schema so every table they touch exists
+    if (stmt_registry_open(&db_stmts, db) != 0) {
+        return -1;
+    }
+    
+    printf("[DB] Database initialized successfully\n");
+    return 0;
+}
+
+void db_close() {
+    if (db) {
+        stmt_registry_report(&db_stmts, "main connection");
+        stmt_registry_close(&db_stmts);
+        sqlite3_close(db);
+        printf("[DB] Database closed\n");
+    }
+}
+
+// Validate username (3-31 chars, alphanumeric + underscore)
+int validate_username(const char *username) {
+    int len = strlen(username);
+    if (len < 3 || len > MAX_USERNAME - 1) return 0;
+    for (int i = 0; i < len; i++) {
+        if (!isalnum(username[i]) && username[i] != '_') return 0;
+    }
+    return 1;
+}
+
+// Validate email (basic check for @ and .)
+int validate_email(const char *email) {
+    int len = strlen(email);
+    if (len < 5 || len > 127) return 0;
+    
+    int has_at = 0, has_dot_after_at = 0;
+    for (int i = 0; i < len; i++) {
+        if (email[i] == '@') {
+            if (has_at) return 0; // Multiple @
+            has_at = 1;
+        }
+        if (has_at && email[i] == '.') {
+            has_dot_after_at = 1;
+        }
+    }
+    return has_at && has_dot_after_at;
+}
+
+// Validate a registration and check the username/email are free. The
+// password itself is hashed on the auth pool before db_insert_user().
+int db_check_registration(const char *username, const char *email, const char *password) {
+    if (!validate_username(username)) {
+        printf("[DB] Invalid username format: %s\n", username);
+        return AUTH_INVALID_USERNAME;
+    }
+
+    if (!validate_email(email)) {
+        printf("[DB] Invalid email format: %s\n", email);
+        return AUTH_INVALID_EMAIL;
+    }
+
+    if (strlen(password) < 4) {
+        printf("[DB] Password too short\n");
+        return AUTH_INVALID_PASSWORD;
+    }
+    
+    // Check if username/email already exists
+    int username_exists = 0;
+    int email_exists = 0;
+
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_EXISTS_USERNAME);
+    sqlite3_bind_text(stmt, 1, username, -1, SQLITE_STATIC);
+    
+    int rc = sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_USER_EXISTS_USERNAME);
+    
+    if (rc == SQLITE_ROW) {
+        username_exists = 1;
+    }
+    
+    // Check if email already exists
+    stmt = stmt_acquire(&db_stmts, STMT_USER_EXISTS_EMAIL);
+    sqlite3_bind_text(stmt, 1, email, -1, SQLITE_STATIC);
+    
+    rc = sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_USER_EXISTS_EMAIL);
+    
+    if (rc == SQLITE_ROW) {
+        email_exists = 1;
+    }
+
+    if (username_exists && email_exists) {
+        printf("[DB] Username and email already exist\n");
+        return AUTH_USER_EXISTS;
+    }
+
+    if (username_exists) {
+        printf("[DB] Username already exists\n");
+        return AUTH_USERNAME_EXISTS;
+    }
+
+    if (email_exists) {
+        printf("[DB] Email already exists\n");
+        return AUTH_EMAIL_EXISTS;
+    }
+    
+    return AUTH_SUCCESS;
+}
+
+// Create an account from an already hashed password
+int db_insert_user(const char *username, const char *email, const char *hash, const char *salt,
+                   int *out_user_id) {
+    // Insert new user (display_name starts same as username)
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_INSERT);
+    sqlite3_bind_text(stmt, 1, username, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, username, -1, SQLITE_STATIC); // Initial display_name = username
+    sqlite3_bind_text(stmt, 3, email, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, hash, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, salt, -1, SQLITE_STATIC);
+    
+    int rc = sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_USER_INSERT);
+    
+    if (rc == SQLITE_CONSTRAINT) {
+        // Taken while the password was being hashed
+        printf("[DB] Username or email taken meanwhile: %s\n", username);
+        return AUTH_USER_EXISTS;
+    }
+    if (rc != SQLITE_DONE) {
+        fprintf(stderr, "[DB] Insert failed: %s\n", sqlite3_errmsg(db));
+        return AUTH_FAILED;
+    }
+    
+    // Create default statistics record
+    int user_id = (int)sqlite3_last_insert_rowid(db);
+    stmt = stmt_acquire(&db_stmts, STMT_STATS_INSERT);
+    sqlite3_bind_int(stmt, 1, user_id);
+    sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_STATS_INSERT);
+    
+    printf("[DB] Registered user: %s (email: %s, id: %d)\n", username, email, user_id);
+    leaderboard_refresh_user(user_id);
+    *out_user_id = user_id;
+    return AUTH_SUCCESS;
+}
+
+// Look up an account for login (by username or email). Copies out the
+// stored hash and salt; the password is checked on the auth pool.
+int db_get_login(const char *identifier, User *out_user, char *hash, char *salt) {
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_LOGIN);
+    sqlite3_bind_text(stmt, 1, identifier, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, identifier, -1, SQLITE_STATIC);
+    
+    int rc = sqlite3_step(stmt);
+    
+    if (rc != SQLITE_ROW) {
+        stmt_release(&db_stmts, STMT_USER_LOGIN);
+        printf("[DB] User not found: %s\n", identifier);
+        return AUTH_USER_NOT_FOUND;
+    }
+    
+    // Get stored hash and salt
+    strncpy(hash, (const char *)sqlite3_column_text(stmt, 4), PASSWORD_HASH_SIZE - 1);
+    hash[PASSWORD_HASH_SIZE - 1] = '\0';
+    strncpy(salt, (const char *)sqlite3_column_text(stmt, 5), PASSWORD_SALT_SIZE - 1);
+    salt[PASSWORD_SALT_SIZE - 1] = '\0';
+    
+    // Populate user struct
+    memset(out_user, 0, sizeof(User));
+    out_user->id = sqlite3_column_int(stmt, 0);
+    strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
+    strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
+    strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
+    out_user->elo_rating = sqlite3_column_int(stmt, 6);
+    out_user->is_online = 1;
+    out_user->lobby_id = -1;
+    
+    stmt_release(&db_stmts, STMT_USER_LOGIN);
+    return AUTH_SUCCESS;
+}
+
+// Password verified: update last_login
+void db_touch_login(const User *user) {
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_TOUCH_LOGIN);
+    sqlite3_bind_int(stmt, 1, user->id);
+    sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_USER_TOUCH_LOGIN);
+    
+    printf("[DB] Login successful: %s (id: %d, ELO: %d)\n", 
+           user->username, user->id, user->elo_rating);
+}
+
+// Replace a password hash (rehash on login). Runs on the DB writer thread.
+int db_update_password(StmtRegistry *reg, const DbPasswordJob *job) {
+    sqlite3_stmt *stmt = stmt_acquire(reg, STMT_USER_SET_PASSWORD);
+    sqlite3_bind_text(stmt, 1, job->hash, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, job->salt, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 3, job->user_id);
+    
+    int rc = sqlite3_step(stmt);
+    stmt_release(reg, STMT_USER_SET_PASSWORD);
+    return rc == SQLITE_DONE ? 0 : -1;
+}
+
+// Update user's display name
+int db_update_display_name(int user_id, const char *new_display_name) {
+    if (strlen(new_display_name) < 3 || strlen(new_display_name) > MAX_DISPLAY_NAME - 1) {
+        return -1;
+    }
+    
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_SET_DISPLAY_NAME);
+    sqlite3_bind_text(stmt, 1, new_display_name, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 2, user_id);
+    
+    int rc = sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_USER_SET_DISPLAY_NAME);
+    
+    if (rc == SQLITE_DONE) {
+        printf("[DB] Updated display name for user %d: %s\n", user_id, new_display_name);
+        leaderboard_refresh_user(user_id);
+        response_cache_invalidate(CACHE_PROFILE, user_id);
+        return 0;
+    }
+    return -1;
+}
+
+// Get user by ID
+int db_get_user_by_id(int user_id, User *out_user) {
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_BY_ID);
+    sqlite3_bind_int(stmt, 1, user_id);
+    
+    int rc = sqlite3_step(stmt);
+    
+    if (rc != SQLITE_ROW) {
+        stmt_release(&db_stmts, STMT_USER_BY_ID);
+        return -1;
+    }
+    
+    if (out_user) {
+        out_user->id = sqlite3_column_int(stmt, 0);
+        strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
+        strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
+        strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
+        out_user->elo_rating = sqlite3_column_int(stmt, 4);
+    }
+    
+    stmt_release(&db_stmts, STMT_USER_BY_ID);
+    return 0;
+}
+
+// Find user by display name (for friend requests)
+int db_find_user_by_display_name(const char *display_name, User *out_user) {
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_BY_DISPLAY_NAME);
+    sqlite3_bind_text(stmt, 1, display_name, -1, SQLITE_STATIC);
+    
+    int rc = sqlite3_step(stmt);
+    
+    if (rc != SQLITE_ROW) {
+        stmt_release(&db_stmts, STMT_USER_BY_DISPLAY_NAME);
+        return -1;
+    }
+    
+    if (out_user) {
+        out_user->id = sqlite3_column_int(stmt, 0);
+        strncpy(out_user->username, (const char *)sqlite3_column_text(stmt, 1), MAX_USERNAME - 1);
+        strncpy(out_user->display_name, (const char *)sqlite3_column_text(stmt, 2), MAX_DISPLAY_NAME - 1);
+        strncpy(out_user->email, (const char *)sqlite3_column_text(stmt, 3), MAX_EMAIL - 1);
+        out_user->elo_rating = sqlite3_column_int(stmt, 4);
+    }
+    
+    stmt_release(&db_stmts, STMT_USER_BY_DISPLAY_NAME);
+    return 0;
+}
@@ -0,0 +1,209 @@
+/* server/db_stmt.c - Prepared statement registry */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sqlite3.h>
+#include "server.h"
+
+// Every query the server runs, prepared once per connection. Statements are
+// handed out reset and with bindings cleared, so callers only bind and step.
+static const struct {
+    const char *name;
+    const char *sql;
+} stmt_defs[STMT_COUNT] = {
+    // database.c
+    [STMT_USER_EXISTS_USERNAME] = {"user_exists_username",
+        "SELECT id FROM Users WHERE username = ?"},
+    [STMT_USER_EXISTS_EMAIL] = {"user_exists_email",
+        "SELECT id FROM Users WHERE email = ?"},
+    [STMT_USER_INSERT] = {"user_insert",
+        "INSERT INTO Users (username, display_name, email, password_hash, salt) "
+        "VALUES (?, ?, ?, ?, ?)"},
+    [STMT_STATS_INSERT] = {"stats_insert",
+        "INSERT INTO Statistics (user_id) VALUES (?)"},
+    [STMT_USER_LOGIN] = {"user_login",
+        "SELECT id, username, display_name, email, password_hash, salt, elo_rating "
+        "FROM Users WHERE username = ? OR email = ?"},
+    [STMT_USER_TOUCH_LOGIN] = {"user_touch_login",
+        "UPDATE Users SET last_login = CURRENT_TIMESTAMP WHERE id = ?"},
+    [STMT_USER_SET_PASSWORD] = {"user_set_password",
+        "UPDATE Users SET password_hash = ?, salt = ? WHERE id = ?"},
+    [STMT_USER_SET_DISPLAY_NAME] = {"user_set_display_name",
+        "UPDATE Users SET display_name = ? WHERE id = ?"},
+    [STMT_USER_BY_ID] = {"user_by_id",
+        "SELECT id, username, display_name, email, elo_rating "
+        "FROM Users WHERE id = ?"},
+    [STMT_USER_BY_DISPLAY_NAME] = {"user_by_display_name",
+        "SELECT id, username, display_name, email, elo_rating "
+        "FROM Users WHERE display_name = ? COLLATE NOCASE"},
+
+    // session_store.c
+    [STMT_SESSION_LOAD] = {"session_load",
+        "SELECT token_hash, user_id, expires_at FROM Sessions WHERE expires_at > ?"},
+    [STMT_SESSION_INSERT] = {"session_insert",
+        "INSERT OR REPLACE INTO Sessions (token_hash, user_id, expires_at) VALUES (?, ?, ?)"},
+    [STMT_SESSION_DELETE] = {"session_delete",
+        "DELETE FROM Sessions WHERE token_hash = ?"},
+    [STMT_SESSION_SWEEP] = {"session_sweep",
+        "DELETE FROM Sessions WHERE expires_at <= ?"},
+
+    // statistics.c
+    [STMT_BEGIN] = {"begin", "BEGIN IMMEDIATE"},
+    [STMT_COMMIT] = {"commit", "COMMIT"},
+    [STMT_ROLLBACK] = {"rollback", "ROLLBACK"},
+    [STMT_MATCH_INSERT] = {"match_insert",
+        "INSERT INTO MatchHistory (winner_id, duration_seconds, num_players, game_mode) "
+        "VALUES (?, ?, ?, ?)"},
+    [STMT_STATS_ADD_MATCH] = {"stats_add_match",
+        "UPDATE Statistics SET "
+        "total_matches = total_matches + 1, "
+        "wins = wins + ?, "
+        "total_kills = total_kills + ?, "
+        "deaths = deaths + ?, "
+        "bombs_planted = bombs_planted + ?, "
+        "walls_destroyed = walls_destroyed + ? "
+        "WHERE user_id = ?"},
+    [STMT_MATCH_PLAYER_INSERT] = {"match_player_insert",
+        "INSERT INTO MatchPlayers (match_id, user_id, placement, kills, deaths, elo_change) "
+        "VALUES (?, ?, ?, ?, ?, ?)"},
+    [STMT_ROLLUP_DAY_ADD] = {"rollup_day_add",
+        "INSERT INTO StatsDaily (user_id, day, matches, wins, kills, deaths, play_seconds, elo_change) "
+        "SELECT ?1, CAST(strftime('%s', match_date) AS INTEGER) / 86400, 1, ?3, ?4, ?5, "
+        "       COALESCE(duration_seconds, 0), ?6 "
+        "FROM MatchHistory WHERE id = ?2 "
+        "ON CONFLICT (user_id, day) DO UPDATE SET "
+        "matches = matches + 1, wins = wins + excluded.wins, kills = kills + excluded.kills, "
+        "deaths = deaths + excluded.deaths, play_seconds = play_seconds + excluded.play_seconds, "
+        "elo_change = elo_change + excluded.elo_change"},
+    [STMT_ROLLUP_MODE_ADD] = {"rollup_mode_add",
+        "INSERT INTO StatsByMode (user_id, game_mode, matches, wins, kills, deaths, play_seconds, elo_change) "
+        "SELECT ?1, COALESCE(game_mode, 0), 1, ?3, ?4, ?5, COALESCE(duration_seconds, 0), ?6 "
+        "FROM MatchHistory WHERE id = ?2 "
+        "ON CONFLICT (user_id, game_mode) DO UPDATE SET "
+        "matches = matches + 1, wins = wins + excluded.wins, kills = kills + excluded.kills, "
+        "deaths = deaths + excluded.deaths, play_seconds = play_seconds + excluded.play_seconds, "
+        "elo_change = elo_change + excluded.elo_change"},
+    [STMT_PROFILE] = {"profile",
+        "SELECT u.username, u.display_name, u.elo_rating, "
+        "       COALESCE(s.total_matches, 0), COALESCE(s.wins, 0), "
+        "       COALESCE(s.total_kills, 0), COALESCE(s.deaths, 0) "
+        "FROM Users u "
+        "LEFT JOIN Statistics s ON u.id = s.user_id "
+        "WHERE u.id = ?"},
+    [STMT_MATCH_HISTORY_PAGE] = {"match_history_page",
+        "SELECT mh.id, CAST(strftime('%s', mh.match_date) AS INTEGER), mh.duration_seconds, "
+        "       mh.num_players, mh.winner_id = mp.user_id, mp.placement, mp.kills, mp.elo_change "
+        "FROM MatchPlayers mp JOIN MatchHistory mh ON mh.id = mp.match_id "
+        "WHERE mp.user_id = ? AND mp.match_id < ? "
+        "ORDER BY mp.match_id DESC LIMIT ?"},
+    [STMT_ROLLUP_BY_MODE] = {"rollup_by_mode",
+        "SELECT game_mode, matches, wins, kills, deaths, play_seconds, elo_change "
+        "FROM StatsByMode WHERE user_id = ?"},
+    [STMT_ROLLUP_RECENT] = {"rollup_recent",
+        "SELECT day, matches, wins, kills, deaths, play_seconds, elo_change "
+        "FROM StatsDaily WHERE user_id = ? AND day > ? ORDER BY day DESC"},
+    [STMT_LEADERBOARD_LOAD] = {"leaderboard_load",
+        "SELECT u.id, u.display_name, u.elo_rating, COALESCE(s.wins, 0) "
+        "FROM Users u "
+        "LEFT JOIN Statistics s ON u.id = s.user_id"},
+    [STMT_USER_SET_ELO] = {"user_set_elo",
+        "UPDATE Users SET elo_rating = ? WHERE id = ?"},
+    [STMT_ELO_RATING] = {"elo_rating",
+        "SELECT u.elo_rating, COALESCE(s.total_matches, 0) "
+        "FROM Users u "
+        "LEFT JOIN Statistics s ON u.id = s.user_id "
+        "WHERE u.id = ?"},
+
+    // elo_recompute.c
+    [STMT_ELO_REPLAY_USERS] = {"elo_replay_users",
+        "SELECT id, elo_rating FROM Users"},
+    [STMT_ELO_REPLAY_MATCHES] = {"elo_replay_matches",
+        "SELECT id, match_id, user_id, placement, COALESCE(elo_change, 0) "
+        "FROM MatchPlayers ORDER BY match_id, id"},  // Walks idx_match_players_match
+    [STMT_ELO_REPLAY_SET_CHANGE] = {"elo_replay_set_change",
+        "UPDATE MatchPlayers SET elo_change = ? WHERE id = ?"},
+
+    // friend_system.c
+    [STMT_FRIEND_LOAD] = {"friend_load",
+        "SELECT user_id_1, user_id_2, status FROM Friendships "
+        "ORDER BY id"},  // Request order
+    [STMT_FRIEND_INSERT] = {"friend_insert",
+        "INSERT INTO Friendships (user_id_1, user_id_2, status) VALUES (?, ?, 'PENDING')"},
+    [STMT_FRIEND_ACCEPT] = {"friend_accept",
+        "UPDATE Friendships SET status = 'ACCEPTED', accepted_at = CURRENT_TIMESTAMP "
+        "WHERE user_id_1 = ? AND user_id_2 = ? AND status = 'PENDING'"},
+    [STMT_FRIEND_DECLINE] = {"friend_decline",
+        "DELETE FROM Friendships "
+        "WHERE user_id_1 = ? AND user_id_2 = ? AND status = 'PENDING'"},
+    [STMT_FRIEND_REMOVE] = {"friend_remove",
+        "DELETE FROM Friendships "
+        "WHERE ((user_id_1 = ? AND user_id_2 = ?) OR (user_id_1 = ? AND user_id_2 = ?)) "
+        "AND status = 'ACCEPTED'"},
+};
+
+static long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Prepare every statement on 'conn'. Returns 0 on success, -1 on failure.
+int stmt_registry_open(StmtRegistry *reg, sqlite3 *conn) {
+    memset(reg, 0, sizeof(*reg));
+    reg->conn = conn;
+
+    for (int i = 0; i < STMT_COUNT; i++) {
+        // PERSISTENT: these live for the whole run, keep them out of lookaside
+        if (sqlite3_prepare_v3(conn, stmt_defs[i].sql, -1, SQLITE_PREPARE_PERSISTENT,
+                               &reg->stmts[i], NULL) != SQLITE_OK) {
+            fprintf(stderr, "[DB] Prepare failed for %s: %s\n",
+                    stmt_defs[i].name, sqlite3_errmsg(conn));
+            stmt_registry_close(reg);
+            return -1;
+        }
+    }
+    printf("[DB] Prepared %d statements\n", STMT_COUNT);
+    return 0;
+}
+
+void stmt_registry_close(StmtRegistry *reg) {
+    for (int i = 0; i < STMT_COUNT; i++) {
+        if (reg->stmts[i]) sqlite3_finalize(reg->stmts[i]);
+        reg->stmts[i] = NULL;
+    }
+}
+
+// Handle for one query, ready to bind. Pair every acquire with stmt_release();
+// the same statement must not be acquired twice before it is released.
+sqlite3_stmt* stmt_acquire(StmtRegistry *reg, StmtId id) {
+    reg->started_ns[id] = now_ns();
+    return reg->stmts[id];
+}
+
+// Reset for the next caller and account the time since stmt_acquire().
+// Column values read from the statement are invalid after this.
+void stmt_release(StmtRegistry *reg, StmtId id) {
+    sqlite3_stmt *stmt = reg->stmts[id];
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);  // Drop SQLITE_STATIC pointers into caller buffers
+    reg->calls[id]++;
+    reg->total_ns[id] += now_ns() - reg->started_ns[id];
+}
+
+// Per-statement call counts and cumulative latency. Full-scan steps and
+// sorts come from SQLite and point at queries missing an index.
+void stmt_registry_report(StmtRegistry *reg, const char *label) {
+    printf("[DB] Statement stats (%s):\n", label);
+    printf("[DB]   %-24s %10s %12s %10s %10s %8s\n",
+           "statement", "calls", "total ms", "avg us", "fullscan", "sorts");
+    for (int i = 0; i < STMT_COUNT; i++) {
+        if (reg->calls[i] == 0) continue;
+        sqlite3_stmt *stmt = reg->stmts[i];
+        printf("[DB]   %-24s %10lld %12.3f %10.1f %10d %8d\n",
+               stmt_defs[i].name, reg->calls[i],
+               reg->total_ns[i] / 1e6,
+               reg->total_ns[i] / 1e3 / reg->calls[i],
+               sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0),
+               sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 0));
+    }
+}
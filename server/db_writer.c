@@ -0,0 +1,162 @@
+/* server/db_writer.c - Dedicated database writer thread */
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include "server.h"
+
+// One ring holds every job from submit to callback. Jobs run strictly in
+// submission order on the writer thread, so three counters are enough:
+//   head..run   finished, waiting for the main loop to run callbacks
+//   run..tail   queued for the writer thread
+// Only the main loop moves head and tail; only the writer moves run.
+static DbJob jobs[DB_QUEUE_SIZE];
+static unsigned int head, run, tail;
+static int stopping = 0;
+static int started = 0;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_done = PTHREAD_COND_INITIALIZER;
+static pthread_t writer_thread;
+static int wake_fd = -1;
+
+static sqlite3 *writer_db = NULL;
+static StmtRegistry writer_stmts;      // Only touched by the writer thread
+
+static void run_job(DbJob *job) {
+    switch (job->type) {
+        case DB_JOB_MATCH_COMMIT:
+            job->data.match.match_id = stats_commit_match(&writer_stmts, &job->data.match);
+            job->result = (job->data.match.match_id >= 0) ? 0 : -1;
+            break;
+
+        case DB_JOB_SESSION_SAVE:
+        case DB_JOB_SESSION_DELETE:
+        case DB_JOB_SESSION_SWEEP:
+            job->result = session_db_apply(&writer_stmts, job->type, &job->data.session);
+            break;
+
+        case DB_JOB_PASSWORD_UPDATE:
+            job->result = db_update_password(&writer_stmts, &job->data.password);
+            break;
+    }
+}
+
+static void* writer_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    while (1) {
+        while (run == tail && !stopping) {
+            pthread_cond_wait(&work_ready, &lock);
+        }
+        if (run == tail) break;  // Stopping and drained
+
+        // The slot is ours until 'run' moves past it
+        DbJob *job = &jobs[run % DB_QUEUE_SIZE];
+        pthread_mutex_unlock(&lock);
+        run_job(job);
+        pthread_mutex_lock(&lock);
+
+        run++;
+        pthread_cond_broadcast(&job_done);
+        uint64_t one = 1;
+        if (write(wake_fd, &one, sizeof(one)) < 0) {
+            perror("[DBW] eventfd write");
+        }
+    }
+    pthread_mutex_unlock(&lock);
+
+    stmt_registry_report(&writer_stmts, "writer thread");
+    stmt_registry_close(&writer_stmts);
+    sqlite3_close(writer_db);
+    return NULL;
+}
+
+// Open the writer's connection and start the thread. Call after db_init().
+int db_writer_start() {
+    if (db_open_connection(&writer_db) != 0) return -1;
+    if (stmt_registry_open(&writer_stmts, writer_db) != 0) {
+        sqlite3_close(writer_db);
+        return -1;
+    }
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0) {
+        perror("[DBW] eventfd");
+        return -1;
+    }
+
+    if (pthread_create(&writer_thread, NULL, writer_main, NULL) != 0) {
+        fprintf(stderr, "[DBW] Failed to start writer thread\n");
+        return -1;
+    }
+    started = 1;
+    printf("[DBW] Writer thread started (queue: %d jobs)\n", DB_QUEUE_SIZE);
+    return 0;
+}
+
+// Readable whenever finished jobs are waiting for db_writer_dispatch()
+int db_writer_fd() {
+    return wake_fd;
+}
+
+// Queue a copy of 'job'. The queue only fills if the disk stalls; then the
+// main loop waits here, running callbacks as jobs finish to free slots.
+void db_writer_submit(const DbJob *job) {
+    pthread_mutex_lock(&lock);
+    if (tail - head == DB_QUEUE_SIZE) {
+        printf("[DBW] Queue full (%d jobs), waiting for the writer\n", DB_QUEUE_SIZE);
+    }
+    while (tail - head == DB_QUEUE_SIZE) {
+        if (run != head) {
+            pthread_mutex_unlock(&lock);
+            db_writer_dispatch();
+            pthread_mutex_lock(&lock);
+        } else {
+            pthread_cond_wait(&job_done, &lock);
+        }
+    }
+    jobs[tail % DB_QUEUE_SIZE] = *job;
+    tail++;
+    pthread_cond_signal(&work_ready);
+    pthread_mutex_unlock(&lock);
+}
+
+// Run callbacks for finished jobs, in submission order. Main loop only.
+void db_writer_dispatch() {
+    uint64_t count;
+    if (read(wake_fd, &count, sizeof(count)) < 0) {
+        // EAGAIN: already drained by an earlier dispatch
+    }
+
+    while (1) {
+        pthread_mutex_lock(&lock);
+        if (head == run) {
+            pthread_mutex_unlock(&lock);
+            break;
+        }
+        // Copy out and free the slot first: a callback may submit more jobs
+        DbJob job = jobs[head % DB_QUEUE_SIZE];
+        head++;
+        pthread_mutex_unlock(&lock);
+
+        if (job.on_done) job.on_done(&job);
+    }
+}
+
+// Finish every queued write, then close the writer's connection. Callbacks
+// for the last jobs are not run; the main loop has already exited.
+void db_writer_stop() {
+    if (!started) return;
+    pthread_mutex_lock(&lock);
+    stopping = 1;
+    pthread_cond_signal(&work_ready);
+    pthread_mutex_unlock(&lock);
+
+    pthread_join(writer_thread, NULL);
+    close(wake_fd);
+    wake_fd = -1;
+    started = 0;
+}
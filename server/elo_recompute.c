@@ -0,0 +1,278 @@
+/* server/elo_recompute.c - Replay every match through the current ELO rules */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sqlite3.h>
+#include "../common/protocol.h"
+#include "server.h"
+
+// Offline: run with the server stopped (server_bin --recompute-elo).
+//
+// Ratings are path dependent, so a change to get_k_factor() or to
+// elo_rate_match() only means something once it is applied from the first
+// match on. This loads MatchPlayers into memory in match order, replays it
+// against flat arrays indexed by user id - starting every account at the
+// schema default of 1200 with 0 matches - and writes the differences back in
+// one transaction. The replay itself touches no SQLite; loading and writing
+// are timed separately so the numbers say where the minutes go.
+//
+// A match is rated exactly when stats_commit_match() would have rated it:
+// at least two players, all with an account. Every match counts towards the
+// K-factor of its account holders, rated or not, like Statistics.total_matches.
+
+#define REPLAY_START_RATING 1200
+
+typedef struct {
+    int row_id;                // MatchPlayers.id
+    int match_id;
+    int user_id;
+    int placement;
+    int old_change;            // Stored elo_change
+    int new_change;            // Replayed elo_change
+} ReplayRow;
+
+typedef struct {
+    int *rating;               // Replayed, by user id
+    int *old_rating;           // Users.elo_rating before the replay
+    int *matches;              // Matches replayed so far, for the K-factor
+    unsigned char *exists;
+    int capacity;              // Max user id + 1
+    int num_users;
+
+    ReplayRow *rows;
+    int num_rows;
+    int row_capacity;
+    int num_matches;
+    int rated_matches;
+} Replay;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int step_done(StmtId id) {
+    int rc = sqlite3_step(db_stmts.stmts[id]);
+    stmt_release(&db_stmts, id);
+    return rc == SQLITE_DONE;
+}
+
+static void replay_free(Replay *r) {
+    free(r->rating);
+    free(r->old_rating);
+    free(r->matches);
+    free(r->exists);
+    free(r->rows);
+    memset(r, 0, sizeof(*r));
+}
+
+static int grow_users(Replay *r, int min_capacity) {
+    int capacity = r->capacity ? r->capacity : 1024;
+    while (capacity < min_capacity) capacity *= 2;
+
+    int *rating = realloc(r->rating, capacity * sizeof(int));
+    if (rating) r->rating = rating;
+    int *old_rating = realloc(r->old_rating, capacity * sizeof(int));
+    if (old_rating) r->old_rating = old_rating;
+    int *matches = realloc(r->matches, capacity * sizeof(int));
+    if (matches) r->matches = matches;
+    unsigned char *exists = realloc(r->exists, capacity);
+    if (exists) r->exists = exists;
+    if (!rating || !old_rating || !matches || !exists) return -1;
+
+    memset(r->exists + r->capacity, 0, capacity - r->capacity);
+    r->capacity = capacity;
+    return 0;
+}
+
+static int load_users(Replay *r) {
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_ELO_REPLAY_USERS);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        int id = sqlite3_column_int(stmt, 0);
+        if (id <= 0) continue;
+        if (id >= r->capacity && grow_users(r, id + 1) != 0) {
+            rc = SQLITE_NOMEM;
+            break;
+        }
+        r->exists[id] = 1;
+        r->old_rating[id] = sqlite3_column_int(stmt, 1);
+        r->num_users++;
+    }
+    stmt_release(&db_stmts, STMT_ELO_REPLAY_USERS);
+    return rc == SQLITE_DONE ? 0 : -1;
+}
+
+static int load_matches(Replay *r) {
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_ELO_REPLAY_MATCHES);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (r->num_rows == r->row_capacity) {
+            int capacity = r->row_capacity ? r->row_capacity * 2 : 65536;
+            ReplayRow *rows = realloc(r->rows, capacity * sizeof(ReplayRow));
+            if (!rows) {
+                rc = SQLITE_NOMEM;
+                break;
+            }
+            r->rows = rows;
+            r->row_capacity = capacity;
+        }
+        ReplayRow *row = &r->rows[r->num_rows++];
+        row->row_id = sqlite3_column_int(stmt, 0);
+        row->match_id = sqlite3_column_int(stmt, 1);
+        row->user_id = sqlite3_column_int(stmt, 2);
+        row->placement = sqlite3_column_int(stmt, 3);
+        row->old_change = sqlite3_column_int(stmt, 4);
+        row->new_change = 0;
+    }
+    stmt_release(&db_stmts, STMT_ELO_REPLAY_MATCHES);
+    return rc == SQLITE_DONE ? 0 : -1;
+}
+
+// The hot loop: no SQLite, no allocation, no logging
+static void replay(Replay *r) {
+    int ratings[MAX_LOBBY_PLAYERS], counts[MAX_LOBBY_PLAYERS], placements[MAX_LOBBY_PLAYERS];
+    int changes[MAX_LOBBY_PLAYERS], new_ratings[MAX_LOBBY_PLAYERS];
+
+    for (int id = 0; id < r->capacity; id++) {
+        r->rating[id] = REPLAY_START_RATING;
+        r->matches[id] = 0;
+    }
+
+    for (int start = 0, end; start < r->num_rows; start = end) {
+        for (end = start + 1; end < r->num_rows && r->rows[end].match_id == r->rows[start].match_id; end++);
+        int n = end - start;
+        ReplayRow *rows = &r->rows[start];
+        r->num_matches++;
+
+        int rated = n >= 2 && n <= MAX_LOBBY_PLAYERS;
+        for (int i = 0; i < n && rated; i++) {
+            int id = rows[i].user_id;
+            if (id <= 0 || id >= r->capacity || !r->exists[id]) {
+                rated = 0;
+                break;
+            }
+            ratings[i] = r->rating[id];
+            counts[i] = r->matches[id];
+            placements[i] = rows[i].placement;
+        }
+
+        if (rated) {
+            elo_rate_match(ratings, counts, placements, n, changes, new_ratings);
+            for (int i = 0; i < n; i++) {
+                rows[i].new_change = changes[i];
+                r->rating[rows[i].user_id] = new_ratings[i];
+            }
+            r->rated_matches++;
+        }
+        for (int i = 0; i < n; i++) {
+            int id = rows[i].user_id;
+            if (id > 0 && id < r->capacity && r->exists[id]) r->matches[id]++;
+        }
+    }
+}
+
+static void report(const Replay *r) {
+    int changed = 0, max_delta = 0;
+    long long total_delta = 0;
+    int before[4] = {0}, after[4] = {0};
+
+    for (int id = 0; id < r->capacity; id++) {
+        if (!r->exists[id]) continue;
+        int delta = r->rating[id] - r->old_rating[id];
+        if (delta != 0) changed++;
+        total_delta += abs(delta);
+        if (abs(delta) > abs(max_delta)) max_delta = delta;
+        before[get_tier(r->old_rating[id])]++;
+        after[get_tier(r->rating[id])]++;
+    }
+
+    int rows_changed = 0;
+    for (int i = 0; i < r->num_rows; i++) {
+        if (r->rows[i].new_change != r->rows[i].old_change) rows_changed++;
+    }
+
+    printf("[ELO] Ratings changed for %d of %d users (mean |delta| %.1f, largest %+d)\n",
+           changed, r->num_users, r->num_users ? (double)total_delta / r->num_users : 0.0, max_delta);
+    printf("[ELO] Per-match changes differ on %d of %d player rows\n", rows_changed, r->num_rows);
+    for (int tier = 3; tier >= 0; tier--) {
+        printf("[ELO]   %-8s %7d -> %7d\n", get_tier_name(tier), before[tier], after[tier]);
+    }
+}
+
+// Only rows and users whose values moved are written
+static int write_back(const Replay *r) {
+    stmt_acquire(&db_stmts, STMT_BEGIN);
+    if (!step_done(STMT_BEGIN)) {
+        fprintf(stderr, "[ELO] Cannot begin write-back: %s\n", sqlite3_errmsg(db_stmts.conn));
+        return -1;
+    }
+
+    for (int i = 0; i < r->num_rows; i++) {
+        const ReplayRow *row = &r->rows[i];
+        if (row->new_change == row->old_change) continue;
+        sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_ELO_REPLAY_SET_CHANGE);
+        sqlite3_bind_int(stmt, 1, row->new_change);
+        sqlite3_bind_int(stmt, 2, row->row_id);
+        if (!step_done(STMT_ELO_REPLAY_SET_CHANGE)) goto fail;
+    }
+    for (int id = 0; id < r->capacity; id++) {
+        if (!r->exists[id] || r->rating[id] == r->old_rating[id]) continue;
+        sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_USER_SET_ELO);
+        sqlite3_bind_int(stmt, 1, r->rating[id]);
+        sqlite3_bind_int(stmt, 2, id);
+        if (!step_done(STMT_USER_SET_ELO)) goto fail;
+    }
+
+    stmt_acquire(&db_stmts, STMT_COMMIT);
+    if (step_done(STMT_COMMIT)) return 0;
+
+fail:
+    fprintf(stderr, "[ELO] Write-back failed, nothing changed: %s\n", sqlite3_errmsg(db_stmts.conn));
+    stmt_acquire(&db_stmts, STMT_ROLLBACK);
+    step_done(STMT_ROLLBACK);
+    return -1;
+}
+
+// Recompute every rating and per-match change from match history. With
+// dry_run, only report what would change. Returns 0 on success.
+int elo_recompute(int dry_run) {
+    Replay r;
+    memset(&r, 0, sizeof(r));
+
+    double t0 = now_seconds();
+    if (grow_users(&r, 1) != 0 || load_users(&r) != 0 || load_matches(&r) != 0) {
+        fprintf(stderr, "[ELO] Failed to load match history: %s\n", sqlite3_errmsg(db_stmts.conn));
+        replay_free(&r);
+        return -1;
+    }
+    double t1 = now_seconds();
+    replay(&r);
+    double t2 = now_seconds();
+
+    printf("[ELO] Loaded %d users, %d player rows in %.3f s\n", r.num_users, r.num_rows, t1 - t0);
+    printf("[ELO] Replayed %d matches (%d rated) in %.3f s: %.2f M matches/s\n",
+           r.num_matches, r.rated_matches, t2 - t1,
+           t2 > t1 ? r.num_matches / (t2 - t1) / 1e6 : 0.0);
+    report(&r);
+
+    if (dry_run) {
+        printf("[ELO] Dry run: database left unchanged\n");
+        replay_free(&r);
+        return 0;
+    }
+
+    int rc = write_back(&r);
+    replay_free(&r);
+    if (rc != 0) return -1;
+    printf("[ELO] Written back in %.3f s\n", now_seconds() - t2);
+
+    // The rollups sum MatchPlayers.elo_change
+    if (stats_rebuild_rollups() != 0) {
+        fprintf(stderr, "[ELO] Ratings saved, but rollups are stale: run --rebuild-stats\n");
+        return -1;
+    }
+    return 0;
+}
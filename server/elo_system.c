@@ -2,12 +2,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <sqlite3.h>
 #include "../common/protocol.h"
 #include "server.h"
 
-extern sqlite3 *db;
-
 // Get K-factor based on number of matches played
 // New players have higher K for faster rating adjustment
 int get_k_factor(int matches_played) {
@@ -34,41 +31,10 @@ int calculate_elo_change(int player_rating, int avg_opponent_rating,
     return change;
 }
 
-// Update ELO ratings for all players in a match using Pairwise Comparison
-// Returns 0 on success, -1 on failure
-int elo_update_after_match(int *player_ids, int *placements, int num_players, int *out_elo_changes) {
-    if (num_players < 2) return -1;
-    
-    // Get current ratings and match counts
-    int ratings[MAX_CLIENTS];
-    int match_counts[MAX_CLIENTS];
-    
-    for (int i = 0; i < num_players; i++) {
-        sqlite3_stmt *stmt;
-        const char *sql = 
-            "SELECT u.elo_rating, COALESCE(s.total_matches, 0) "
-            "FROM Users u "
-            "LEFT JOIN Statistics s ON u.id = s.user_id "
-            "WHERE u.id = ?";
-        
-        if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-            return -1;
-        }
-        
-        sqlite3_bind_int(stmt, 1, player_ids[i]);
-        
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
-            ratings[i] = sqlite3_column_int(stmt, 0);
-            match_counts[i] = sqlite3_column_int(stmt, 1);
-        } else {
-            sqlite3_finalize(stmt);
-            return -1;
-        }
-        sqlite3_finalize(stmt);
-    }
-    
-    printf("[ELO] Match results (Pairwise Calculation):\n");
-    
+// Pairwise Comparison rating of one match. Pure and silent: the live path
+// logs through elo_compute_match(), the offline recompute calls this directly.
+void elo_rate_match(const int *ratings, const int *match_counts, const int *placements,
+                    int num_players, int *out_elo_changes, int *out_new_ratings) {
     // Calculate ELO change for each player using pairwise comparison
     for (int i = 0; i < num_players; i++) {
         double total_expected = 0;
@@ -103,21 +69,24 @@ int elo_update_after_match(int *player_ids, int *placements, int num_players, in
         // Ensure rating doesn't go below 0
         if (new_rating < 0) new_rating = 0;
 
-        // Store change for output
-        if (out_elo_changes) {
-            out_elo_changes[i] = elo_change;
-        }
-        
-        // Update database
-        if (db_update_elo(player_ids[i], new_rating) == 0) {
-            printf("[ELO]   Player %d (Rank %d): %d -> %d (%s%d) [Score: %.1f/%.1f]\n", 
-                   player_ids[i], placements[i], ratings[i], new_rating,
-                   (elo_change >= 0) ? "+" : "", elo_change, 
-                   total_actual, total_expected);
-        }
+        out_elo_changes[i] = elo_change;
+        out_new_ratings[i] = new_rating;
     }
+}
+
+// Rate a finished match using Pairwise Comparison. Pure calculation: the
+// ratings are read and written by stats_commit_match() in one transaction.
+void elo_compute_match(const int *player_ids, const int *ratings, const int *match_counts,
+                       const int *placements, int num_players,
+                       int *out_elo_changes, int *out_new_ratings) {
+    elo_rate_match(ratings, match_counts, placements, num_players, out_elo_changes, out_new_ratings);
     
-    return 0;
+    printf("[ELO] Match results (Pairwise Calculation):\n");
+    for (int i = 0; i < num_players; i++) {
+        printf("[ELO]   Player %d (Rank %d): %d -> %d (%s%d)\n", 
+               player_ids[i], placements[i], ratings[i], out_new_ratings[i],
+               (out_elo_changes[i] >= 0) ? "+" : "", out_elo_changes[i]);
+    }
 }
 
 // Get tier badge from ELO rating
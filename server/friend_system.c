@@ -8,8 +8,199 @@
 
 extern sqlite3 *db;  // Defined in database.c
 
-// Forward declaration - defined in main.c
-int is_user_online(int user_id);
+// The Friendships table, mirrored in memory as adjacency lists, plus where
+// each user is connected. The database stays the source of truth: every
+// change is written there first, then applied here. Reads (friend lists,
+// presence fan-out) never touch SQL. Main loop only.
+typedef struct {
+    int *ids;
+    int count;
+    int capacity;
+} IdList;
+
+typedef struct {
+    IdList friends;            // ACCEPTED
+    IdList incoming;           // PENDING, they asked (oldest first)
+    IdList outgoing;           // PENDING, we asked (oldest first)
+    int socket_fd;             // -1 = offline
+    int presence;              // PRESENCE_*
+} FriendNode;
+
+static FriendNode *nodes = NULL;
+static int nodes_cap = 0;
+
+static int idlist_add(IdList *list, int id) {
+    if (list->count == list->capacity) {
+        int cap = list->capacity ? list->capacity * 2 : 4;
+        int *grown = realloc(list->ids, cap * sizeof(int));
+        if (!grown) return -1;
+        list->ids = grown;
+        list->capacity = cap;
+    }
+    list->ids[list->count++] = id;
+    return 0;
+}
+
+static int idlist_contains(const IdList *list, int id) {
+    for (int i = 0; i < list->count; i++) {
+        if (list->ids[i] == id) return 1;
+    }
+    return 0;
+}
+
+// Keeps the order, which is request order for the pending lists
+static void idlist_remove(IdList *list, int id) {
+    for (int i = 0; i < list->count; i++) {
+        if (list->ids[i] == id) {
+            memmove(&list->ids[i], &list->ids[i + 1], (list->count - i - 1) * sizeof(int));
+            list->count--;
+            return;
+        }
+    }
+}
+
+// Node for user_id, created on first use; NULL for ids that can't exist
+static FriendNode* node_get(int user_id) {
+    if (user_id <= 0) return NULL;
+    if (user_id >= nodes_cap) {
+        int cap = nodes_cap ? nodes_cap : 1024;
+        while (cap <= user_id) cap *= 2;
+        FriendNode *grown = realloc(nodes, cap * sizeof(FriendNode));
+        if (!grown) {
+            fprintf(stderr, "[FRIEND] Out of memory growing graph to %d users\n", cap);
+            return NULL;
+        }
+        memset(grown + nodes_cap, 0, (cap - nodes_cap) * sizeof(FriendNode));
+        for (int i = nodes_cap; i < cap; i++) grown[i].socket_fd = -1;
+        nodes = grown;
+        nodes_cap = cap;
+    }
+    return &nodes[user_id];
+}
+
+// Read-only lookup; never grows the table
+static FriendNode* node_find(int user_id) {
+    if (user_id <= 0 || user_id >= nodes_cap) return NULL;
+    return &nodes[user_id];
+}
+
+static void graph_add_pending(int from_id, int to_id) {
+    FriendNode *from = node_get(from_id);
+    FriendNode *to = node_get(to_id);
+    if (!from || !to) return;
+    idlist_add(&from->outgoing, to_id);
+    idlist_add(&to->incoming, from_id);
+}
+
+static void graph_drop_pending(int from_id, int to_id) {
+    FriendNode *from = node_find(from_id);
+    FriendNode *to = node_find(to_id);
+    if (from) idlist_remove(&from->outgoing, to_id);
+    if (to) idlist_remove(&to->incoming, from_id);
+}
+
+static void graph_add_friends(int a_id, int b_id) {
+    FriendNode *a = node_get(a_id);
+    FriendNode *b = node_get(b_id);
+    if (!a || !b) return;
+    idlist_add(&a->friends, b_id);
+    idlist_add(&b->friends, a_id);
+}
+
+// Build the graph from Friendships. Call once after db_init().
+int friend_graph_load() {
+    int accepted = 0, pending = 0;
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_FRIEND_LOAD);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        int from_id = sqlite3_column_int(stmt, 0);
+        int to_id = sqlite3_column_int(stmt, 1);
+        if (strcmp((const char *)sqlite3_column_text(stmt, 2), "ACCEPTED") == 0) {
+            graph_add_friends(from_id, to_id);
+            accepted++;
+        } else {
+            graph_add_pending(from_id, to_id);
+            pending++;
+        }
+    }
+    stmt_release(&db_stmts, STMT_FRIEND_LOAD);
+
+    if (rc != SQLITE_DONE) {
+        fprintf(stderr, "[FRIEND] Failed to load friendships: %s\n", sqlite3_errmsg(db));
+        return -1;
+    }
+    printf("[FRIEND] Graph loaded: %d friendships, %d pending requests\n", accepted, pending);
+    return 0;
+}
+
+void friend_graph_free() {
+    for (int i = 0; i < nodes_cap; i++) {
+        free(nodes[i].friends.ids);
+        free(nodes[i].incoming.ids);
+        free(nodes[i].outgoing.ids);
+    }
+    free(nodes);
+    nodes = NULL;
+    nodes_cap = 0;
+}
+
+// --- Presence ---
+
+// Tell every online friend of user_id about its new state
+static void push_presence(int user_id, FriendNode *node) {
+    ServerPacket packet;
+    memset(&packet, 0, sizeof(ServerPacket));
+    packet.type = MSG_FRIEND_PRESENCE;
+    FriendInfo *info = &packet.payload.friend_status;
+    info->user_id = user_id;
+    info->is_online = node->presence;
+
+    LeaderboardEntry entry;
+    if (leaderboard_lookup(user_id, &entry)) {
+        strncpy(info->display_name, entry.display_name, MAX_DISPLAY_NAME - 1);
+        info->elo_rating = entry.elo_rating;
+    }
+
+    for (int i = 0; i < node->friends.count; i++) {
+        FriendNode *f = node_find(node->friends.ids[i]);
+        if (f && f->socket_fd >= 0) send_response(f->socket_fd, &packet);
+    }
+}
+
+// user_id is connected on socket_fd and in lobby_id (-1 = none). Friends are
+// only told when the visible state changes.
+void presence_set(int user_id, int socket_fd, int lobby_id) {
+    FriendNode *node = node_get(user_id);
+    if (!node) return;
+    int presence = (lobby_id >= 0) ? PRESENCE_IN_LOBBY : PRESENCE_ONLINE;
+    node->socket_fd = socket_fd;
+    if (node->presence != presence) {
+        node->presence = presence;
+        push_presence(user_id, node);
+    }
+}
+
+// socket_fd closed. A newer login of the same account on another socket
+// keeps the user online.
+void presence_clear(int user_id, int socket_fd) {
+    FriendNode *node = node_find(user_id);
+    if (!node || node->socket_fd != socket_fd) return;
+    node->socket_fd = -1;
+    node->presence = PRESENCE_OFFLINE;
+    push_presence(user_id, node);
+}
+
+// Socket of a logged-in user, or -1 if offline
+int presence_socket(int user_id) {
+    FriendNode *node = node_find(user_id);
+    return node ? node->socket_fd : -1;
+}
+
+// PRESENCE_* of any user
+int presence_of(int user_id) {
+    FriendNode *node = node_find(user_id);
+    return node ? node->presence : PRESENCE_OFFLINE;
+}
 
 // Send friend request from user_id to target user (by display name)
 int friend_send_request(int sender_id, const char *target_display_name) {
@@ -26,101 +217,58 @@ int friend_send_request(int sender_id, const char *target_display_name) {
     }
     
     // Check if friendship already exists
-    sqlite3_stmt *stmt;
-    const char *check_sql = 
-        "SELECT status FROM Friendships "
-        "WHERE (user_id_1 = ? AND user_id_2 = ?) OR (user_id_1 = ? AND user_id_2 = ?)";
-    
-    if (sqlite3_prepare_v2(db, check_sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[FRIEND] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return -3;
+    FriendNode *sender = node_get(sender_id);
+    if (sender && idlist_contains(&sender->friends, target.id)) {
+        printf("[FRIEND] Already friends\n");
+        return -4;  // Already friends
     }
-    
-    sqlite3_bind_int(stmt, 1, sender_id);
-    sqlite3_bind_int(stmt, 2, target.id);
-    sqlite3_bind_int(stmt, 3, target.id);
-    sqlite3_bind_int(stmt, 4, sender_id);
-    
-    int rc = sqlite3_step(stmt);
-    
-    if (rc == SQLITE_ROW) {
-        const char *status = (const char *)sqlite3_column_text(stmt, 0);
-        sqlite3_finalize(stmt);
-        
-        if (strcmp(status, "ACCEPTED") == 0) {
-            printf("[FRIEND] Already friends\n");
-            return -4;  // Already friends
-        } else {
-            printf("[FRIEND] Friend request already pending\n");
-            return -5;  // Request already pending
-        }
+    if (sender && (idlist_contains(&sender->outgoing, target.id) ||
+                   idlist_contains(&sender->incoming, target.id))) {
+        printf("[FRIEND] Friend request already pending\n");
+        return -5;  // Request already pending
     }
-    sqlite3_finalize(stmt);
     
     // Create new friend request
-    const char *insert_sql = 
-        "INSERT INTO Friendships (user_id_1, user_id_2, status) VALUES (?, ?, 'PENDING')";
-    
-    if (sqlite3_prepare_v2(db, insert_sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[FRIEND] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return -3;
-    }
-    
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_FRIEND_INSERT);
     sqlite3_bind_int(stmt, 1, sender_id);
     sqlite3_bind_int(stmt, 2, target.id);
     
-    rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    int rc = sqlite3_step(stmt);
+    stmt_release(&db_stmts, STMT_FRIEND_INSERT);
     
     if (rc != SQLITE_DONE) {
         fprintf(stderr, "[FRIEND] Insert failed: %s\n", sqlite3_errmsg(db));
         return -3;
     }
+    graph_add_pending(sender_id, target.id);
     
-    User sender;
-    db_get_user_by_id(sender_id, &sender);
-    printf("[FRIEND] Friend request sent: %s -> %s\n", 
-           sender.display_name, target.display_name);
+    printf("[FRIEND] Friend request sent: %d -> %s\n", sender_id, target.display_name);
     return 0;
 }
 
 // Accept friend request
 int friend_accept_request(int user_id, int requester_id) {
-    printf("[FRIEND DEBUG] Accept called: user_id=%d, requester_id=%d\n", user_id, requester_id);
-    
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "UPDATE Friendships SET status = 'ACCEPTED', accepted_at = CURRENT_TIMESTAMP "
-        "WHERE user_id_1 = ? AND user_id_2 = ? AND status = 'PENDING'";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        printf("[FRIEND DEBUG] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return -1;
-    }
-    
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_FRIEND_ACCEPT);
     sqlite3_bind_int(stmt, 1, requester_id);
     sqlite3_bind_int(stmt, 2, user_id);
     
-    printf("[FRIEND DEBUG] Executing UPDATE WHERE user_id_1=%d AND user_id_2=%d AND status='PENDING'\n", 
-           requester_id, user_id);
-    
     int rc = sqlite3_step(stmt);
     int changes = sqlite3_changes(db);
-    
-    printf("[FRIEND DEBUG] Result: rc=%d, changes=%d\n", rc, changes);
-    
-    sqlite3_finalize(stmt);
+    stmt_release(&db_stmts, STMT_FRIEND_ACCEPT);
     
     if (rc != SQLITE_DONE) {
-        printf("[FRIEND DEBUG] Failed: rc != SQLITE_DONE, error: %s\n", sqlite3_errmsg(db));
+        fprintf(stderr, "[FRIEND] Accept failed: %s\n", sqlite3_errmsg(db));
         return -1;
     }
     
     if (changes == 0) {
-        printf("[FRIEND DEBUG] Failed: No rows affected (friendship record not found)\n");
+        printf("[FRIEND] No pending request from User %d to User %d\n", requester_id, user_id);
         return -1;
     }
     
+    graph_drop_pending(requester_id, user_id);
+    graph_add_friends(user_id, requester_id);
+    
     printf("[FRIEND] Friend request accepted: User %d accepted User %d\n", 
            user_id, requester_id);
     return 0;
@@ -129,24 +277,17 @@ int friend_accept_request(int user_id, int requester_id) {
 
 // Decline/remove friend request
 int friend_decline_request(int user_id, int requester_id) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "DELETE FROM Friendships "
-        "WHERE user_id_1 = ? AND user_id_2 = ? AND status = 'PENDING'";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_FRIEND_DECLINE);
     sqlite3_bind_int(stmt, 1, requester_id);
     sqlite3_bind_int(stmt, 2, user_id);
     
     int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    stmt_release(&db_stmts, STMT_FRIEND_DECLINE);
     
     if (rc != SQLITE_DONE || sqlite3_changes(db) == 0) {
         return -1;
     }
+    graph_drop_pending(requester_id, user_id);
     
     printf("[FRIEND] Friend request declined: User %d declined User %d\n", 
            user_id, requester_id);
@@ -155,132 +296,75 @@ int friend_decline_request(int user_id, int requester_id) {
 
 // Remove friend (delete friendship)
 int friend_remove(int user_id, int friend_id) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "DELETE FROM Friendships "
-        "WHERE ((user_id_1 = ? AND user_id_2 = ?) OR (user_id_1 = ? AND user_id_2 = ?)) "
-        "AND status = 'ACCEPTED'";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_FRIEND_REMOVE);
     sqlite3_bind_int(stmt, 1, user_id);
     sqlite3_bind_int(stmt, 2, friend_id);
     sqlite3_bind_int(stmt, 3, friend_id);
     sqlite3_bind_int(stmt, 4, user_id);
     
     int rc = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    stmt_release(&db_stmts, STMT_FRIEND_REMOVE);
     
     if (rc != SQLITE_DONE || sqlite3_changes(db) == 0) {
         return -1;
     }
+    FriendNode *a = node_find(user_id);
+    FriendNode *b = node_find(friend_id);
+    if (a) idlist_remove(&a->friends, friend_id);
+    if (b) idlist_remove(&b->friends, user_id);
     
     printf("[FRIEND] Friendship removed: User %d removed User %d\n", 
            user_id, friend_id);
     return 0;
 }
 
-// Get friends list with online status
-int friend_get_list(int user_id, FriendInfo *out_friends, int max_count) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT u.id, u.display_name, u.elo_rating "
-        "FROM Friendships f "
-        "JOIN Users u ON (f.user_id_1 = u.id OR f.user_id_2 = u.id) "
-        "WHERE ((f.user_id_1 = ? OR f.user_id_2 = ?) AND u.id != ?) "
-        "AND f.status = 'ACCEPTED' "
-        "ORDER BY u.display_name";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[FRIEND] Prepare failed: %s\n", sqlite3_errmsg(db));
-        return 0;
-    }
-    
-    sqlite3_bind_int(stmt, 1, user_id);
-    sqlite3_bind_int(stmt, 2, user_id);
-    sqlite3_bind_int(stmt, 3, user_id);
-    
+// FriendInfo for each id, newest first when 'reverse' is set. Names and
+// ratings come from the leaderboard index.
+static int fill_infos(const IdList *list, int reverse, int with_presence,
+                      FriendInfo *out, int max_count) {
     int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_count) {
-        out_friends[count].user_id = sqlite3_column_int(stmt, 0);
-        strncpy(out_friends[count].display_name, 
-                (const char *)sqlite3_column_text(stmt, 1), 
-                MAX_DISPLAY_NAME - 1);
-        out_friends[count].elo_rating = sqlite3_column_int(stmt, 2);
-        
-        // Check online status
-        out_friends[count].is_online = is_user_online(out_friends[count].user_id);
-        
-        count++;
+    for (int k = 0; k < list->count && count < max_count; k++) {
+        int id = list->ids[reverse ? list->count - 1 - k : k];
+        FriendInfo *info = &out[count++];
+        memset(info, 0, sizeof(*info));
+        info->user_id = id;
+
+        LeaderboardEntry entry;
+        if (leaderboard_lookup(id, &entry)) {
+            memcpy(info->display_name, entry.display_name, MAX_DISPLAY_NAME);
+            info->elo_rating = entry.elo_rating;
+        }
+        if (with_presence) {
+            FriendNode *node = node_find(id);
+            info->is_online = node ? node->presence : PRESENCE_OFFLINE;
+        }
     }
-    
-    sqlite3_finalize(stmt);
-    printf("[FRIEND] Retrieved %d friends for user %d\n", count, user_id);
     return count;
 }
 
-// Get pending friend requests (incoming)
-int friend_get_pending_requests(int user_id, FriendInfo *out_requests, int max_count) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT u.id, u.display_name, u.elo_rating "
-        "FROM Friendships f "
-        "JOIN Users u ON f.user_id_1 = u.id "
-        "WHERE f.user_id_2 = ? AND f.status = 'PENDING' "
-        "ORDER BY f.requested_at DESC";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return 0;
-    }
-    
-    sqlite3_bind_int(stmt, 1, user_id);
-    
-    int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_count) {
-        out_requests[count].user_id = sqlite3_column_int(stmt, 0);
-        strncpy(out_requests[count].display_name, 
-                (const char *)sqlite3_column_text(stmt, 1), 
-                MAX_DISPLAY_NAME - 1);
-        out_requests[count].elo_rating = sqlite3_column_int(stmt, 2);
-        out_requests[count].is_online = 0;  // Not relevant for pending requests
-        count++;
-    }
-    
-    sqlite3_finalize(stmt);
-    printf("[FRIEND] Retrieved %d pending requests for user %d\n", count, user_id);
+static int compare_display_name(const void *a, const void *b) {
+    return strcmp(((const FriendInfo *)a)->display_name, ((const FriendInfo *)b)->display_name);
+}
+
+// Get friends list with presence, sorted by display name
+int friend_get_list(int user_id, FriendInfo *out_friends, int max_count) {
+    FriendNode *node = node_find(user_id);
+    if (!node) return 0;
+    int count = fill_infos(&node->friends, 0, 1, out_friends, max_count);
+    qsort(out_friends, count, sizeof(FriendInfo), compare_display_name);
     return count;
 }
 
-// Get sent friend requests (outgoing)
+// Get pending friend requests (incoming), newest first
+int friend_get_pending_requests(int user_id, FriendInfo *out_requests, int max_count) {
+    FriendNode *node = node_find(user_id);
+    if (!node) return 0;
+    return fill_infos(&node->incoming, 1, 0, out_requests, max_count);
+}
+
+// Get sent friend requests (outgoing), newest first
 int friend_get_sent_requests(int user_id, FriendInfo *out_requests, int max_count) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT u.id, u.display_name, u.elo_rating "
-        "FROM Friendships f "
-        "JOIN Users u ON f.user_id_2 = u.id "
-        "WHERE f.user_id_1 = ? AND f.status = 'PENDING' "
-        "ORDER BY f.requested_at DESC";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return 0;
-    }
-    
-    sqlite3_bind_int(stmt, 1, user_id);
-    
-    int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_count) {
-        out_requests[count].user_id = sqlite3_column_int(stmt, 0);
-        strncpy(out_requests[count].display_name, 
-                (const char *)sqlite3_column_text(stmt, 1), 
-                MAX_DISPLAY_NAME - 1);
-        out_requests[count].elo_rating = sqlite3_column_int(stmt, 2);
-        out_requests[count].is_online = 0;  // Not relevant for sent requests
-        count++;
-    }
-    
-    sqlite3_finalize(stmt);
-    printf("[FRIEND] Retrieved %d sent requests for user %d\n", count, user_id);
-    return count;
+    FriendNode *node = node_find(user_id);
+    if (!node) return 0;
+    return fill_infos(&node->outgoing, 1, 0, out_requests, max_count);
 }
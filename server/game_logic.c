@@ -1,516 +1,930 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdbool.h>
-#include <time.h>
-#include <math.h>
-#include "../common/protocol.h"
-
-#define MAX_BOMBS 50
-#define BOMB_TIMER 3000
-#define EXPLOSION_TIMER 500
-#define POWERUP_CHANCE 30  // 30% cơ hội xuất hiện power-up
-#define FOG_RADIUS 5       // Fog of war visibility radius (5 tiles)
-
-// Power-up limits - ADJUSTED
-#define MAX_BOMB_CAPACITY 3   // User requested: max 3 bombs
-#define MAX_BOMB_RANGE 4      // User requested: max 4 range
-#define MAX_MOVE_SPEED 2.0f
-#define BASE_MOVE_SPEED 1.0f
-
-typedef struct {
-    int x, y;
-    long long plant_time;
-    int is_active;
-    int owner_id;      // ID người đặt bom
-    int range;         // Tầm nổ của bom này
-} Bomb;
-
-typedef struct {
-    int x, y;
-    long long start_time;
-    int is_active;
-} Explosion;
-
-Bomb bombs[MAX_BOMBS];
-Explosion explosions[MAX_BOMBS * 10];
-
-long long get_time_ms() {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000LL;
-}
-
-extern void init_map(GameState *state);
-
-void init_game(GameState *state, Lobby *lobby) {
-    memset(state, 0, sizeof(GameState));
-    memset(bombs, 0, sizeof(bombs));
-    memset(explosions, 0, sizeof(explosions));
-    
-    init_map(state);
-    
-    int spawn_pos[4][2] = {
-        {1, 1},
-        {MAP_WIDTH - 2, 1},
-        {1, MAP_HEIGHT - 2},
-        {MAP_WIDTH - 2, MAP_HEIGHT - 2}
-    };
-    
-    state->num_players = lobby->num_players;
-    for (int i = 0; i < lobby->num_players; i++) {
-        state->players[i] = lobby->players[i];
-        state->players[i].x = spawn_pos[i][0];
-        state->players[i].y = spawn_pos[i][1];
-        state->players[i].is_alive = 1;
-        state->players[i].max_bombs = 1;
-        state->players[i].bomb_range = 2;
-        state->players[i].current_bombs = 0;
-    }
-    
-    state->game_status = GAME_RUNNING;
-    state->winner_id = -1;
-    state->end_game_time = 0;
-    
-    // Initialize game mode and fog settings from lobby
-    state->game_mode = lobby->game_mode;
-    state->fog_radius = (lobby->game_mode == GAME_MODE_FOG_OF_WAR) ? FOG_RADIUS : 0;
-    
-    // Initialize timer
-    state->match_start_time = time(NULL);  // Record start time
-    state->match_duration_seconds = 0;
-    
-    // Sudden Death mode initialization
-    if (lobby->game_mode == GAME_MODE_SUDDEN_DEATH) {
-        state->sudden_death_timer = 1800;  // 90 seconds * 20 ticks/sec
-        state->shrink_zone_left = 0;
-        state->shrink_zone_right = MAP_WIDTH - 1;
-        state->shrink_zone_top = 0;
-        state->shrink_zone_bottom = MAP_HEIGHT - 1;
-        printf("[GAME] Sudden Death mode: 90s timer, walls shrink every 15s\n");
-    } else {
-        state->sudden_death_timer = 0;
-        state->shrink_zone_left = 0;
-        state->shrink_zone_right = 0;
-        state->shrink_zone_top = 0;
-        state->shrink_zone_bottom = 0;
-    }
-    
-    // Initialize kill tracking
-    for (int i = 0; i < MAX_CLIENTS; i++) {
-        state->kills[i] = 0;
-        state->elo_changes[i] = 0;  // Initialize ELO changes
-    }
-    
-    printf("[GAME] Initialized with %d players\n", state->num_players);
-}
-
-int can_move_to(GameState *state, int x, int y) {
-    if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) return 0;
-    int tile = state->map[y][x];
-    // FIXED: Can't walk through bombs or explosions anymore!
-    return (tile == EMPTY || 
-            tile == POWERUP_BOMB || tile == POWERUP_FIRE);
-}
-
-// Returns: 0=nothing, 1=picked up, 2=already at max
-int pickup_powerup(GameState *state, Player *p, int x, int y) {
-    int tile = state->map[y][x];
-    
-    switch (tile) {
-        case POWERUP_BOMB:
-            if (p->max_bombs < MAX_BOMB_CAPACITY) {
-                p->max_bombs++;
-                printf("[GAME] Player %s picked up BOMB power-up! Max bombs: %d/%d\n", 
-                       p->username, p->max_bombs, MAX_BOMB_CAPACITY);
-                state->map[y][x] = EMPTY;
-                return 1;  // Picked up
-            } else {
-                printf("[GAME] Player %s already at max bombs (%d)\n", 
-                       p->username, MAX_BOMB_CAPACITY);
-                state->map[y][x] = EMPTY;  // Still consume it
-                return 2;  // At max
-            }
-            break;
-            
-        case POWERUP_FIRE:
-            if (p->bomb_range < MAX_BOMB_RANGE) {
-                p->bomb_range++;
-                printf("[GAME] Player %s picked up FIRE power-up! Range: %d/%d\n", 
-                       p->username, p->bomb_range, MAX_BOMB_RANGE);
-                state->map[y][x] = EMPTY;
-                return 1;  // Picked up
-            } else {
-                printf("[GAME] Player %s already at max range (%d)\n", 
-                       p->username, MAX_BOMB_RANGE);
-                state->map[y][x] = EMPTY;  // Still consume it
-                return 2;  // At max
-            }
-            break;
-            
-
-    }
-    return 0;  // Nothing happened
-}
-
-int handle_move(GameState *state, int player_id, int direction) {
-    if (player_id < 0 || player_id >= state->num_players) return 0;
-    
-    Player *p = &state->players[player_id];
-    if (!p->is_alive || state->game_status != GAME_RUNNING) return 0;
-    
-    int nx = p->x, ny = p->y;
-    
-    switch (direction) {
-        case MOVE_UP: ny--; break;
-        case MOVE_DOWN: ny++; break;
-        case MOVE_LEFT: nx--; break;
-        case MOVE_RIGHT: nx++; break;
-        default: return 0;
-    }
-    
-    if (can_move_to(state, nx, ny)) {
-        p->x = nx;
-        p->y = ny;
-        int pickup_status = pickup_powerup(state, p, nx, ny);
-        return (pickup_status == 0) ? 1 : (pickup_status + 10); // 1=moved, 11=picked up, 12=at max
-    }
-    return 0;
-}
-
-int plant_bomb(GameState *state, int player_id) {
-    if (player_id < 0 || player_id >= state->num_players) return 0;
-    
-    Player *p = &state->players[player_id];
-    if (!p->is_alive || state->game_status != GAME_RUNNING) return 0;
-    
-    if (p->current_bombs >= p->max_bombs) {
-        return 0;
-    }
-    
-    if (state->map[p->y][p->x] == BOMB) return 0;
-    
-    for (int i = 0; i < MAX_BOMBS; i++) {
-        if (!bombs[i].is_active) {
-            bombs[i].x = p->x;
-            bombs[i].y = p->y;
-            bombs[i].plant_time = get_time_ms();
-            bombs[i].is_active = 1;
-            bombs[i].owner_id = player_id;
-            bombs[i].range = p->bomb_range;
-            state->map[p->y][p->x] = BOMB;
-            p->current_bombs++;
-            
-            printf("[GAME] Player %s planted bomb at (%d,%d), Range: %d, Count: %d/%d\n",
-                   p->username, p->x, p->y, bombs[i].range, p->current_bombs, p->max_bombs);
-            return 1;
-        }
-    }
-    return 0;
-}
-
-void spawn_powerup(GameState *state, int x, int y) {
-    int roll = rand() % 100;
-    
-    if (roll < POWERUP_CHANCE) {
-        int type_roll = rand() % 100;
-        if (type_roll < 50) {
-            state->map[y][x] = POWERUP_BOMB;
-            printf("[GAME] Spawned BOMB power-up at (%d, %d)\n", x, y);
-        } else {
-            state->map[y][x] = POWERUP_FIRE;
-            printf("[GAME] Spawned FIRE power-up at (%d, %d)\n", x, y);
-        }
-    } else {
-        state->map[y][x] = EMPTY;
-    }
-}
-
-void create_explosion_line(GameState *state, int sx, int sy, int dx, int dy, int range) {
-    for (int i = 0; i <= range; i++) {
-        int x = sx + dx * i;
-        int y = sy + dy * i;
-        
-        if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) break;
-        
-        int tile = state->map[y][x];
-        
-        if (tile == WALL_HARD) break;
-        
-        for (int j = 0; j < MAX_BOMBS * 10; j++) {
-            if (!explosions[j].is_active) {
-                explosions[j].x = x;
-                explosions[j].y = y;
-                explosions[j].start_time = get_time_ms();
-                explosions[j].is_active = 1;
-                break;
-            }
-        }
-        
-        if (tile == WALL_SOFT) {
-            spawn_powerup(state, x, y);
-            break;
-        } else if (tile == BOMB) {
-            // FIXED: Need to trigger this bomb immediately!
-            // Find and detonate the bomb at this position
-            for (int b = 0; b < MAX_BOMBS; b++) {
-                if (bombs[b].is_active && bombs[b].x == x && bombs[b].y == y) {
-                    // Force immediate detonation by setting plant_time to past
-                    bombs[b].plant_time = get_time_ms() - BOMB_TIMER - 1;
-                    printf("[GAME] Chain reaction! Bomb at (%d,%d) triggered!\n", x, y);
-                    break;
-                }
-            }
-            state->map[y][x] = EXPLOSION;
-            // Stop explosion propagation after hitting another bomb
-            if (i > 0) break;
-        } else {
-            state->map[y][x] = EXPLOSION;
-        }
-    }
-}
-
-// Sudden Death mode: Timer countdown and shrinking walls
-void apply_sudden_death_shrinking(GameState *state) {
-    if (state->game_mode != GAME_MODE_SUDDEN_DEATH) return;
-    
-    // Countdown timer
-    state->sudden_death_timer--;
-    int elapsed = 1800 - state->sudden_death_timer;
-    
-    // Shrink every 300 ticks (15 seconds)
-    if (elapsed > 0 && elapsed % 300 == 0) {
-        state->shrink_zone_left++;
-        state->shrink_zone_right--;
-        state->shrink_zone_top++;
-        state->shrink_zone_bottom--;
-        
-        printf("[SUDDEN DEATH] Walls shrinking! Safe zone: (%d,%d) to (%d,%d)\n",
-               state->shrink_zone_left, state->shrink_zone_top,
-               state->shrink_zone_right, state->shrink_zone_bottom);
-        
-        // PHYSICAL WALLS: Fill dead zone with hard walls
-        for (int y = 0; y < MAP_HEIGHT; y++) {
-            for (int x = 0; x < MAP_WIDTH; x++) {
-                 if (x < state->shrink_zone_left || x > state->shrink_zone_right ||
-                     y < state->shrink_zone_top || y > state->shrink_zone_bottom) {
-                     // Turn everything outside safe zone into a hard wall
-                     if (state->map[y][x] != WALL_HARD) {
-                         state->map[y][x] = WALL_HARD; 
-                     }
-                 }
-            }
-        }
-    }
-    
-    // CONTINUOUS DEATH CHECK: Kill players outside safe zone immediately
-    for (int i = 0; i < state->num_players; i++) {
-        if (state->players[i].is_alive) {
-            int px = state->players[i].x;
-            int py = state->players[i].y;
-            if (px < state->shrink_zone_left || px > state->shrink_zone_right ||
-                py < state->shrink_zone_top || py > state->shrink_zone_bottom) {
-                state->players[i].is_alive = 0;
-                printf("[SUDDEN DEATH] Player %s died in death zone at (%d,%d)\n", 
-                       state->players[i].username, px, py);
-            }
-        }
-    }
-    
-    // Timer expired - end game
-    if (state->sudden_death_timer <= 0) {
-        state->game_status = GAME_ENDED;
-        
-        // Find winner by most kills
-        int max_kills = -1;
-        int winner = -1;
-        for (int i = 0; i < state->num_players; i++) {
-            if (state->kills[i] > max_kills) {
-                max_kills = state->kills[i];
-                winner = i;
-            }
-        }
-        
-        state->winner_id = winner;
-        printf("[SUDDEN DEATH] Time's up! Winner: %s with %d kills\n", 
-               (winner >= 0) ? state->players[winner].username : "DRAW",
-               max_kills);
-    }
-}
-
-void update_game(GameState *state) {
-    long long now = get_time_ms();
-    
-    for (int i = 0; i < MAX_BOMBS; i++) {
-        if (bombs[i].is_active && now - bombs[i].plant_time >= BOMB_TIMER) {
-            int x = bombs[i].x;
-            int y = bombs[i].y;
-            int owner_id = bombs[i].owner_id;
-            int range = bombs[i].range;
-            
-            printf("[GAME] Bomb at (%d,%d) exploding with range %d\n", x, y, range);
-            
-            create_explosion_line(state, x, y,  0, -1, range);
-            create_explosion_line(state, x, y,  0,  1, range);
-            create_explosion_line(state, x, y, -1,  0, range);
-            create_explosion_line(state, x, y,  1,  0, range);
-            
-            if (owner_id >= 0 && owner_id < state->num_players) {
-                state->players[owner_id].current_bombs--;
-                if (state->players[owner_id].current_bombs < 0) {
-                    state->players[owner_id].current_bombs = 0;
-                }
-            }
-            
-            bombs[i].is_active = 0;
-        }
-    }
-    
-    for (int i = 0; i < MAX_BOMBS * 10; i++) {
-        if (explosions[i].is_active && 
-            now - explosions[i].start_time >= EXPLOSION_TIMER) {
-            int x = explosions[i].x;
-            int y = explosions[i].y;
-            
-            if (state->map[y][x] == EXPLOSION) {
-                state->map[y][x] = EMPTY;
-            }
-            explosions[i].is_active = 0;
-
-            // Check if any player is hit by this explosion tile
-            for (int p = 0; p < state->num_players; p++) {
-                if (state->players[p].is_alive &&
-                    state->players[p].x == x && state->players[p].y == y) {
-                    
-                    state->players[p].is_alive = 0;
-                    
-                    // Try to find which bomb caused this explosion
-                    // Since we don't track explosion source, check recently detonated bombs
-                    int killer_id = -1;
-                    
-                    // Look for a bomb that detonated recently at a position that could reach this explosion
-                    for (int b = 0; b < MAX_BOMBS; b++) {
-                        if (!bombs[b].is_active) { // Check inactive bombs (recently exploded)
-                            // Check if this bomb could have caused explosion at (x, y)
-                            int dist_x = abs(bombs[b].x - x);
-                            int dist_y = abs(bombs[b].y - y);
-                            
-                            // If explosion is in line with bomb and within range
-                            if ((dist_x == 0 && dist_y <= bombs[b].range) ||
-                                (dist_y == 0 && dist_x <= bombs[b].range)) {
-                                killer_id = bombs[b].owner_id;
-                                break;
-                            }
-                        }
-                    }
-                    
-                    // Attribute kill (don't count suicide)
-                    if (killer_id >= 0 && killer_id != p && killer_id < state->num_players) {
-                        state->kills[killer_id]++;
-                        printf("[GAME] Player %s killed %s! (Total kills: %d)\n",
-                               state->players[killer_id].username,
-                               state->players[p].username,
-                               state->kills[killer_id]);
-                    } else if (killer_id == p) {
-                        printf("[GAME] Player %s died from own bomb (suicide)\n",
-                               state->players[p].username);
-                    } else {
-                        printf("[GAME] Player %s died at (%d,%d)! (killer unknown)\n",
-                               state->players[p].username, x, y);
-                    }
-                }
-            }
-        }
-    }
-    
-    // Apply sudden death shrinking (if mode is active)
-    apply_sudden_death_shrinking(state);
-    
-    int alive = 0;
-    int last_alive = -1;
-    for (int i = 0; i < state->num_players; i++) {
-        Player *p = &state->players[i];
-        if (p->is_alive) {
-            // The player death check is now handled when explosions are cleared
-            // This block only counts alive players for game end condition
-            alive++;
-            last_alive = i;
-        }
-    }
-    
-    if (state->game_status == GAME_RUNNING && alive <= 1) {
-        state->game_status = GAME_ENDED;
-        state->winner_id = (alive == 1) ? last_alive : -1;
-        
-        // Calculate match duration
-        long long end_time = time(NULL);
-        state->match_duration_seconds = (int)(end_time - state->match_start_time);
-        
-        if (state->winner_id >= 0) {
-            printf("[GAME] Game ended. Winner: %s (Duration: %d seconds)\n", 
-                   state->players[state->winner_id].username, state->match_duration_seconds);
-        } else {
-            printf("[GAME] Game ended. Draw! (Duration: %d seconds)\n", 
-                   state->match_duration_seconds);
-        }
-    }
-}
-
-// === FOG OF WAR FUNCTIONS ===
-
-// Check if a tile is visible to a specific player (7x7 square centered on player)
-int is_tile_visible(GameState *state, int player_id, int tile_x, int tile_y) {
-    // No fog in non-fog-of-war modes
-    if (state->game_mode != GAME_MODE_FOG_OF_WAR) return 1;
-    
-    // Safety check
-    if (player_id < 0 || player_id >= state->num_players) return 0;
-    
-    Player *p = &state->players[player_id];
-    
-    // Dead players see everything (spectator view)
-    if (!p->is_alive) return 1;
-    
-    // 7x7 square: player at center, so 3 tiles in each direction
-    int dist_x = abs(p->x - tile_x);
-    int dist_y = abs(p->y - tile_y);
-    
-    // Visible if within 3 tiles in both x and y directions (creates 7x7 square)
-    return (dist_x <= 3 && dist_y <= 3);
-}
-
-// Filter game state for a specific player (create per-player view with fog)
-void filter_game_state(GameState *full_state, int player_id, GameState *out_filtered) {
-    // Start with full copy
-    memcpy(out_filtered, full_state, sizeof(GameState));
-    
-    // No filtering needed in non-fog modes
-    if (full_state->game_mode != GAME_MODE_FOG_OF_WAR) return;
-    
-    // Filter map tiles
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        for (int x = 0; x < MAP_WIDTH; x++) {
-            if (!is_tile_visible(full_state, player_id, x, y)) {
-                // Hide unseen tiles (set to empty or keep hard walls for structure)
-                if (full_state->map[y][x] != WALL_HARD) {
-                    out_filtered->map[y][x] = EMPTY;
-                }
-            }
-        }
-    }
-    
-    // Filter other players - MOVE THEM OFF-MAP instead of marking dead
-    for (int i = 0; i < full_state->num_players; i++) {
-        if (i != player_id) {  // Don't hide yourself
-            Player *p = &full_state->players[i];
-            if (p->is_alive && !is_tile_visible(full_state, player_id, p->x, p->y)) {
-                // Hide this player by moving them off-map (don't change is_alive!)
-                out_filtered->players[i].x = -100;  // Off-map position
-                out_filtered->players[i].y = -100;
-            }
-        }
-    }
-    
-    printf("[FOG] Filtered game state for player %d (mode=%d, radius=7x7)\n", 
-           player_id, full_state->game_mode);
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "../common/protocol.h"
+#include "server.h"
+
+#define BOMB_TIMER 3000
+#define EXPLOSION_TIMER 500
+#define POWERUP_CHANCE 30  // 30% cơ hội xuất hiện power-up
+#define FOG_RADIUS 5       // Fog of war line-of-sight radius (tiles)
+#define SUDDEN_DEATH_SECONDS 90
+#define SHRINK_INTERVAL_SECONDS 15
+
+// Power-up limits - ADJUSTED
+#define MAX_BOMB_CAPACITY 3   // User requested: max 3 bombs
+#define MAX_BOMB_RANGE 4      // User requested: max 4 range
+#define BASE_MOVE_SPEED (4 * TILE_FP)   // Sub-tile units per second (4 tiles/s)
+#define MAX_MOVE_SPEED (8 * TILE_FP)
+#define SPEED_POWERUP_STEP TILE_FP      // +1 tile/s per SPEED power-up
+
+
+
+// Walls changed (explosions, shrinking zone): refresh the sight-blocking mask
+static void refresh_opacity(GameWorld *state) {
+    if (state->game_mode != GAME_MODE_FOG_OF_WAR) return;
+    vis_build_opacity(&state->opacity, &state->map[0][0], state->width, state->height, WORLD_MAX_WIDTH);
+}
+
+// Bucket alive players by grid cell (counting sort, O(players + cells))
+void grid_build(GameWorld *state) {
+    SpatialGrid *grid = &state->grid;
+    int counts[GRID_COLS * GRID_ROWS] = {0};
+    int cell_of[MAX_LOBBY_PLAYERS];
+
+    for (int i = 0; i < state->num_players; i++) {
+        Player *p = &state->players[i];
+        cell_of[i] = -1;
+        if (!p->is_alive || p->x < 0 || p->y < 0 ||
+            p->x >= state->width || p->y >= state->height) continue;
+        cell_of[i] = (p->y / GRID_CELL_SIZE) * GRID_COLS + (p->x / GRID_CELL_SIZE);
+        counts[cell_of[i]]++;
+    }
+
+    grid->cell_start[0] = 0;
+    for (int c = 0; c < GRID_COLS * GRID_ROWS; c++) {
+        grid->cell_start[c + 1] = grid->cell_start[c] + counts[c];
+        counts[c] = grid->cell_start[c];  // Reuse as write cursor
+    }
+    for (int i = 0; i < state->num_players; i++) {
+        if (cell_of[i] >= 0) grid->ids[counts[cell_of[i]]++] = i;
+    }
+}
+
+// Alive players whose tile lies inside [x0,x1] x [y0,y1]; returns how many
+int grid_query(GameWorld *state, int x0, int y0, int x1, int y1, int *out, int max_out) {
+    int n = 0;
+    int c0 = (x0 < 0 ? 0 : x0) / GRID_CELL_SIZE, c1 = (x1 < 0 ? 0 : x1) / GRID_CELL_SIZE;
+    int r0 = (y0 < 0 ? 0 : y0) / GRID_CELL_SIZE, r1 = (y1 < 0 ? 0 : y1) / GRID_CELL_SIZE;
+    if (c1 >= GRID_COLS) c1 = GRID_COLS - 1;
+    if (r1 >= GRID_ROWS) r1 = GRID_ROWS - 1;
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cell = r * GRID_COLS + c;
+            for (int g = state->grid.cell_start[cell]; g < state->grid.cell_start[cell + 1] && n < max_out; g++) {
+                Player *p = &state->players[state->grid.ids[g]];
+                if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1) {
+                    out[n++] = state->grid.ids[g];
+                }
+            }
+        }
+    }
+    return n;
+}
+
+void init_game(ActiveGame *game, Lobby *lobby) {
+    // Bombs, explosions and both queues are per game, so lobbies can tick in parallel
+    game_wait_idle(game);
+    memset(game, 0, sizeof(ActiveGame));
+    GameWorld *state = &game->state;
+    
+    // Timers run on the simulated clock so a catch-up burst behaves like real time
+    state->tick_rate = tick_scheduler_clamp_rate(lobby->tick_rate);
+    game->sim_time_ms = 0;
+    
+    if (lobby->game_mode == GAME_MODE_ARENA) {
+        state->width = ARENA_MAP_WIDTH;
+        state->height = ARENA_MAP_HEIGHT;
+    } else {
+        state->width = MAP_WIDTH;
+        state->height = MAP_HEIGHT;
+    }
+    state->num_players = lobby->num_players;
+    game->bomb_slots = state->num_players * BOMB_SLOTS_PER_PLAYER;
+    game->explosion_slots = game->bomb_slots * EXPLOSION_SLOTS_PER_BOMB;
+    
+    // Fresh seed per match; the map, soft walls and power-up drops all follow from it
+    if (secure_random_bytes(&state->seed, sizeof(state->seed)) != 0) {
+        state->seed = (uint64_t)time(NULL) ^ ((uint64_t)lobby->id << 32);
+    }
+    rng_seed(&state->rng, state->seed);
+    init_map(state);
+    
+    for (int i = 0; i < lobby->num_players; i++) {
+        int sx, sy;
+        map_spawn_point(state, state->num_players, i, &sx, &sy);
+        state->players[i] = lobby->players[i];
+        state->players[i].id = i;
+        state->players[i].x = sx;
+        state->players[i].y = sy;
+        state->players[i].is_alive = 1;
+        state->players[i].max_bombs = 1;
+        state->players[i].bomb_range = 2;
+        state->players[i].current_bombs = 0;
+        state->players[i].px = sx * TILE_FP;
+        state->players[i].py = sy * TILE_FP;
+        state->players[i].move_dir = MOVE_NONE;
+        state->players[i].move_speed = BASE_MOVE_SPEED;
+    }
+    
+    state->game_status = GAME_RUNNING;
+    state->winner_id = -1;
+    state->end_game_time = 0;
+    
+    // Initialize game mode and fog settings from lobby
+    state->game_mode = lobby->game_mode;
+    state->fog_radius = (lobby->game_mode == GAME_MODE_FOG_OF_WAR) ? FOG_RADIUS : 0;
+    
+    // Initialize timer
+    state->match_start_time = time(NULL);  // Record start time
+    state->match_duration_seconds = 0;
+    
+    // Sudden Death mode initialization
+    if (lobby->game_mode == GAME_MODE_SUDDEN_DEATH) {
+        state->sudden_death_timer = SUDDEN_DEATH_SECONDS * state->tick_rate;
+        state->shrink_zone_left = 0;
+        state->shrink_zone_right = state->width - 1;
+        state->shrink_zone_top = 0;
+        state->shrink_zone_bottom = state->height - 1;
+        printf("[GAME] Sudden Death mode: %ds timer, walls shrink every %ds\n",
+               SUDDEN_DEATH_SECONDS, SHRINK_INTERVAL_SECONDS);
+    } else {
+        state->sudden_death_timer = 0;
+        state->shrink_zone_left = 0;
+        state->shrink_zone_right = 0;
+        state->shrink_zone_top = 0;
+        state->shrink_zone_bottom = 0;
+    }
+    
+    // Initialize kill tracking
+    for (int i = 0; i < MAX_LOBBY_PLAYERS; i++) {
+        state->kills[i] = 0;
+        state->elo_changes[i] = 0;  // Initialize ELO changes
+    }
+    
+    grid_build(state);
+    refresh_opacity(state);
+    printf("[GAME] Initialized with %d players on a %dx%d map (seed %016llx)\n",
+           state->num_players, state->width, state->height, (unsigned long long)state->seed);
+}
+
+int can_move_to(GameWorld *state, int x, int y) {
+    if (x < 0 || x >= state->width || y < 0 || y >= state->height) return 0;
+    int tile = state->map[y][x];
+    // FIXED: Can't walk through bombs or explosions anymore!
+    return (tile == EMPTY || 
+            tile == POWERUP_BOMB || tile == POWERUP_FIRE || tile == POWERUP_SPEED);
+}
+
+// Returns: 0=nothing, 1=picked up, 2=already at max
+int pickup_powerup(GameWorld *state, Player *p, int x, int y) {
+    int tile = state->map[y][x];
+    
+    switch (tile) {
+        case POWERUP_BOMB:
+            if (p->max_bombs < MAX_BOMB_CAPACITY) {
+                p->max_bombs++;
+                printf("[GAME] Player %s picked up BOMB power-up! Max bombs: %d/%d\n", 
+                       p->username, p->max_bombs, MAX_BOMB_CAPACITY);
+                state->map[y][x] = EMPTY;
+                return 1;  // Picked up
+            } else {
+                printf("[GAME] Player %s already at max bombs (%d)\n", 
+                       p->username, MAX_BOMB_CAPACITY);
+                state->map[y][x] = EMPTY;  // Still consume it
+                return 2;  // At max
+            }
+            break;
+            
+        case POWERUP_FIRE:
+            if (p->bomb_range < MAX_BOMB_RANGE) {
+                p->bomb_range++;
+                printf("[GAME] Player %s picked up FIRE power-up! Range: %d/%d\n", 
+                       p->username, p->bomb_range, MAX_BOMB_RANGE);
+                state->map[y][x] = EMPTY;
+                return 1;  // Picked up
+            } else {
+                printf("[GAME] Player %s already at max range (%d)\n", 
+                       p->username, MAX_BOMB_RANGE);
+                state->map[y][x] = EMPTY;  // Still consume it
+                return 2;  // At max
+            }
+            break;
+            
+        case POWERUP_SPEED:
+            state->map[y][x] = EMPTY;  // Consumed either way
+            if (p->move_speed < MAX_MOVE_SPEED) {
+                p->move_speed += SPEED_POWERUP_STEP;
+                if (p->move_speed > MAX_MOVE_SPEED) p->move_speed = MAX_MOVE_SPEED;
+                printf("[GAME] Player %s picked up SPEED power-up! Speed: %d/%d tiles/s\n",
+                       p->username, p->move_speed / TILE_FP, MAX_MOVE_SPEED / TILE_FP);
+                return 1;
+            }
+            printf("[GAME] Player %s already at max speed\n", p->username);
+            return 2;
+    }
+    return 0;  // Nothing happened
+}
+
+// MSG_MOVE only changes the held direction; the player is moved by
+// move_players() each tick, so sending more packets doesn't move you faster.
+int handle_move(ActiveGame *game, int player_id, int direction) {
+    GameWorld *state = &game->state;
+    if (player_id < 0 || player_id >= state->num_players) return 0;
+    
+    Player *p = &state->players[player_id];
+    if (!p->is_alive || state->game_status != GAME_RUNNING) return 0;
+    
+    switch (direction) {
+        case MOVE_UP:
+        case MOVE_DOWN:
+        case MOVE_LEFT:
+        case MOVE_RIGHT:
+        case MOVE_NONE:
+            p->move_dir = direction;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Nearest tile index for a sub-tile coordinate
+static int fp_to_tile(int v) {
+    return (v + TILE_FP / 2) / TILE_FP;
+}
+
+// Advance one player along its held direction by 'budget' sub-tile units.
+// The player must be centred on the perpendicular axis to move forward;
+// when it isn't, the budget is spent sliding towards the row/column that
+// leads somewhere (the tile's own, or around a corner into the next one).
+static void step_player(GameWorld *state, Player *p, int budget) {
+    int dx = 0, dy = 0;
+    switch (p->move_dir) {
+        case MOVE_UP: dy = -1; break;
+        case MOVE_DOWN: dy = 1; break;
+        case MOVE_LEFT: dx = -1; break;
+        case MOVE_RIGHT: dx = 1; break;
+        default: return;
+    }
+
+    int *along = dx ? &p->px : &p->py;
+    int *across = dx ? &p->py : &p->px;
+    int dir = dx ? dx : dy;
+
+    while (budget > 0) {
+        int tx = fp_to_tile(p->px);
+        int ty = fp_to_tile(p->py);
+        int off = *across - (dx ? ty : tx) * TILE_FP;
+
+        if (off != 0) {
+            int side = (off > 0) ? 1 : -1;
+            int dist;
+            if (can_move_to(state, tx + dx, ty + dy)) {
+                dist = -off;                               // Re-centre in this lane
+            } else if (dx ? (can_move_to(state, tx + dx, ty + side) && can_move_to(state, tx, ty + side))
+                          : (can_move_to(state, tx + side, ty + dy) && can_move_to(state, tx + side, ty))) {
+                dist = side * (TILE_FP - off * side);      // Slide round the corner
+            } else {
+                return;
+            }
+            int d = (abs(dist) < budget) ? abs(dist) : budget;
+            *across += (dist > 0) ? d : -d;
+            budget -= d;
+            continue;
+        }
+
+        // Progress past the current tile centre in the direction of travel
+        int rel = (*along - (dx ? tx : ty) * TILE_FP) * dir;
+        int limit = can_move_to(state, tx + dx, ty + dy) ? TILE_FP - rel : -rel;
+        if (limit <= 0) return;
+
+        int d = (limit < budget) ? limit : budget;
+        *along += dir * d;
+        budget -= d;
+    }
+}
+
+// Integrate held-direction movement for one tick. Results use the old
+// handle_move() codes (11 = power-up collected, 12 = already at max).
+void move_players(ActiveGame *game, int *move_results) {
+    GameWorld *state = &game->state;
+    int tick_rate = (state->tick_rate > 0) ? state->tick_rate : DEFAULT_TICK_RATE;
+
+    for (int i = 0; i < state->num_players; i++) {
+        Player *p = &state->players[i];
+        if (!p->is_alive || p->move_dir == MOVE_NONE) continue;
+
+        step_player(state, p, p->move_speed / tick_rate);
+
+        int nx = fp_to_tile(p->px);
+        int ny = fp_to_tile(p->py);
+        if (nx != p->x || ny != p->y) {
+            p->x = nx;
+            p->y = ny;
+            int pickup_status = pickup_powerup(state, p, nx, ny);
+            if (pickup_status > 0 && move_results) {
+                move_results[i] = pickup_status + 10;
+            }
+        }
+    }
+}
+
+int plant_bomb(ActiveGame *game, int player_id) {
+    GameWorld *state = &game->state;
+    Bomb *bombs = game->bombs;
+    if (player_id < 0 || player_id >= state->num_players) return 0;
+    
+    Player *p = &state->players[player_id];
+    if (!p->is_alive || state->game_status != GAME_RUNNING) return 0;
+    
+    if (p->current_bombs >= p->max_bombs) {
+        return 0;
+    }
+    
+    if (state->map[p->y][p->x] == BOMB) return 0;
+    
+    for (int i = 0; i < game->bomb_slots; i++) {
+        if (!bombs[i].is_active) {
+            bombs[i].x = p->x;
+            bombs[i].y = p->y;
+            bombs[i].plant_time = game->sim_time_ms;
+            bombs[i].is_active = 1;
+            bombs[i].owner_id = player_id;
+            bombs[i].range = p->bomb_range;
+            state->map[p->y][p->x] = BOMB;
+            p->current_bombs++;
+            state->bombs_planted[player_id]++;
+            
+            printf("[GAME] Player %s planted bomb at (%d,%d), Range: %d, Count: %d/%d\n",
+                   p->username, p->x, p->y, bombs[i].range, p->current_bombs, p->max_bombs);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void spawn_powerup(GameWorld *state, int x, int y) {
+    int roll = rng_range(&state->rng, 100);
+    
+    if (roll < POWERUP_CHANCE) {
+        int type_roll = rng_range(&state->rng, 100);
+        if (type_roll < 40) {
+            state->map[y][x] = POWERUP_BOMB;
+            printf("[GAME] Spawned BOMB power-up at (%d, %d)\n", x, y);
+        } else if (type_roll < 80) {
+            state->map[y][x] = POWERUP_FIRE;
+            printf("[GAME] Spawned FIRE power-up at (%d, %d)\n", x, y);
+        } else {
+            state->map[y][x] = POWERUP_SPEED;
+            printf("[GAME] Spawned SPEED power-up at (%d, %d)\n", x, y);
+        }
+    } else {
+        state->map[y][x] = EMPTY;
+    }
+}
+
+void create_explosion_line(ActiveGame *game, int sx, int sy, int dx, int dy, int range, int owner_id) {
+    GameWorld *state = &game->state;
+    Bomb *bombs = game->bombs;
+    Explosion *explosions = game->explosions;
+    for (int i = 0; i <= range; i++) {
+        int x = sx + dx * i;
+        int y = sy + dy * i;
+        
+        if (x < 0 || x >= state->width || y < 0 || y >= state->height) break;
+        
+        int tile = state->map[y][x];
+        
+        if (tile == WALL_HARD) break;
+        
+        for (int j = 0; j < game->explosion_slots; j++) {
+            if (!explosions[j].is_active) {
+                explosions[j].x = x;
+                explosions[j].y = y;
+                explosions[j].start_time = game->sim_time_ms;
+                explosions[j].is_active = 1;
+                break;
+            }
+        }
+        
+        if (tile == WALL_SOFT) {
+            if (owner_id >= 0 && owner_id < state->num_players) {
+                state->walls_destroyed[owner_id]++;
+            }
+            spawn_powerup(state, x, y);
+            break;
+        } else if (tile == BOMB) {
+            // FIXED: Need to trigger this bomb immediately!
+            // Find and detonate the bomb at this position
+            for (int b = 0; b < game->bomb_slots; b++) {
+                if (bombs[b].is_active && bombs[b].x == x && bombs[b].y == y) {
+                    // Force immediate detonation by setting plant_time to past
+                    bombs[b].plant_time = game->sim_time_ms - BOMB_TIMER - 1;
+                    printf("[GAME] Chain reaction! Bomb at (%d,%d) triggered!\n", x, y);
+                    break;
+                }
+            }
+            state->map[y][x] = EXPLOSION;
+            // Stop explosion propagation after hitting another bomb
+            if (i > 0) break;
+        } else {
+            state->map[y][x] = EXPLOSION;
+        }
+    }
+}
+
+// Sudden Death mode: Timer countdown and shrinking walls
+void apply_sudden_death_shrinking(GameWorld *state) {
+    if (state->game_mode != GAME_MODE_SUDDEN_DEATH) return;
+    
+    // Countdown timer
+    state->sudden_death_timer--;
+    int elapsed = SUDDEN_DEATH_SECONDS * state->tick_rate - state->sudden_death_timer;
+    
+    // Shrink every SHRINK_INTERVAL_SECONDS worth of ticks
+    if (elapsed > 0 && elapsed % (SHRINK_INTERVAL_SECONDS * state->tick_rate) == 0) {
+        state->shrink_zone_left++;
+        state->shrink_zone_right--;
+        state->shrink_zone_top++;
+        state->shrink_zone_bottom--;
+        
+        printf("[SUDDEN DEATH] Walls shrinking! Safe zone: (%d,%d) to (%d,%d)\n",
+               state->shrink_zone_left, state->shrink_zone_top,
+               state->shrink_zone_right, state->shrink_zone_bottom);
+        
+        // PHYSICAL WALLS: Fill dead zone with hard walls
+        for (int y = 0; y < state->height; y++) {
+            for (int x = 0; x < state->width; x++) {
+                 if (x < state->shrink_zone_left || x > state->shrink_zone_right ||
+                     y < state->shrink_zone_top || y > state->shrink_zone_bottom) {
+                     // Turn everything outside safe zone into a hard wall
+                     if (state->map[y][x] != WALL_HARD) {
+                         state->map[y][x] = WALL_HARD; 
+                     }
+                 }
+            }
+        }
+    }
+    
+    // CONTINUOUS DEATH CHECK: Kill players outside safe zone immediately
+    for (int i = 0; i < state->num_players; i++) {
+        if (state->players[i].is_alive) {
+            int px = state->players[i].x;
+            int py = state->players[i].y;
+            if (px < state->shrink_zone_left || px > state->shrink_zone_right ||
+                py < state->shrink_zone_top || py > state->shrink_zone_bottom) {
+                state->players[i].is_alive = 0;
+                printf("[SUDDEN DEATH] Player %s died in death zone at (%d,%d)\n", 
+                       state->players[i].username, px, py);
+            }
+        }
+    }
+    
+    // Timer expired - end game
+    if (state->sudden_death_timer <= 0) {
+        state->game_status = GAME_ENDED;
+        
+        // Find winner by most kills
+        int max_kills = -1;
+        int winner = -1;
+        for (int i = 0; i < state->num_players; i++) {
+            if (state->kills[i] > max_kills) {
+                max_kills = state->kills[i];
+                winner = i;
+            }
+        }
+        
+        state->winner_id = winner;
+        printf("[SUDDEN DEATH] Time's up! Winner: %s with %d kills\n", 
+               (winner >= 0) ? state->players[winner].username : "DRAW",
+               max_kills);
+    }
+}
+
+void update_game(ActiveGame *game) {
+    GameWorld *state = &game->state;
+    Bomb *bombs = game->bombs;
+    Explosion *explosions = game->explosions;
+    long long now = game->sim_time_ms;
+    
+    for (int i = 0; i < game->bomb_slots; i++) {
+        if (bombs[i].is_active && now - bombs[i].plant_time >= BOMB_TIMER) {
+            int x = bombs[i].x;
+            int y = bombs[i].y;
+            int owner_id = bombs[i].owner_id;
+            int range = bombs[i].range;
+            
+            printf("[GAME] Bomb at (%d,%d) exploding with range %d\n", x, y, range);
+            
+            create_explosion_line(game, x, y,  0, -1, range, owner_id);
+            create_explosion_line(game, x, y,  0,  1, range, owner_id);
+            create_explosion_line(game, x, y, -1,  0, range, owner_id);
+            create_explosion_line(game, x, y,  1,  0, range, owner_id);
+            
+            if (owner_id >= 0 && owner_id < state->num_players) {
+                state->players[owner_id].current_bombs--;
+                if (state->players[owner_id].current_bombs < 0) {
+                    state->players[owner_id].current_bombs = 0;
+                }
+            }
+            
+            bombs[i].is_active = 0;
+        }
+    }
+    
+    for (int i = 0; i < game->explosion_slots; i++) {
+        if (explosions[i].is_active && 
+            now - explosions[i].start_time >= EXPLOSION_TIMER) {
+            int x = explosions[i].x;
+            int y = explosions[i].y;
+            
+            if (state->map[y][x] == EXPLOSION) {
+                state->map[y][x] = EMPTY;
+            }
+            explosions[i].is_active = 0;
+
+            // Check if any player is hit by this explosion tile (only the
+            // players bucketed in this tile's grid cell can be)
+            int cell = (y / GRID_CELL_SIZE) * GRID_COLS + (x / GRID_CELL_SIZE);
+            for (int g = state->grid.cell_start[cell]; g < state->grid.cell_start[cell + 1]; g++) {
+                int p = state->grid.ids[g];
+                if (state->players[p].is_alive &&
+                    state->players[p].x == x && state->players[p].y == y) {
+                    
+                    state->players[p].is_alive = 0;
+                    
+                    // Try to find which bomb caused this explosion
+                    // Since we don't track explosion source, check recently detonated bombs
+                    int killer_id = -1;
+                    
+                    // Look for a bomb that detonated recently at a position that could reach this explosion
+                    for (int b = 0; b < game->bomb_slots; b++) {
+                        if (!bombs[b].is_active) { // Check inactive bombs (recently exploded)
+                            // Check if this bomb could have caused explosion at (x, y)
+                            int dist_x = abs(bombs[b].x - x);
+                            int dist_y = abs(bombs[b].y - y);
+                            
+                            // If explosion is in line with bomb and within range
+                            if ((dist_x == 0 && dist_y <= bombs[b].range) ||
+                                (dist_y == 0 && dist_x <= bombs[b].range)) {
+                                killer_id = bombs[b].owner_id;
+                                break;
+                            }
+                        }
+                    }
+                    
+                    // Attribute kill (don't count suicide)
+                    if (killer_id >= 0 && killer_id != p && killer_id < state->num_players) {
+                        state->kills[killer_id]++;
+                        printf("[GAME] Player %s killed %s! (Total kills: %d)\n",
+                               state->players[killer_id].username,
+                               state->players[p].username,
+                               state->kills[killer_id]);
+                    } else if (killer_id == p) {
+                        printf("[GAME] Player %s died from own bomb (suicide)\n",
+                               state->players[p].username);
+                    } else {
+                        printf("[GAME] Player %s died at (%d,%d)! (killer unknown)\n",
+                               state->players[p].username, x, y);
+                    }
+                }
+            }
+        }
+    }
+    
+    // Apply sudden death shrinking (if mode is active)
+    apply_sudden_death_shrinking(state);
+    
+    int alive = 0;
+    int last_alive = -1;
+    for (int i = 0; i < state->num_players; i++) {
+        Player *p = &state->players[i];
+        if (p->is_alive) {
+            // The player death check is now handled when explosions are cleared
+            // This block only counts alive players for game end condition
+            alive++;
+            last_alive = i;
+        }
+    }
+    
+    if (state->game_status == GAME_RUNNING && alive <= 1) {
+        state->game_status = GAME_ENDED;
+        state->winner_id = (alive == 1) ? last_alive : -1;
+        
+        // Calculate match duration
+        long long end_time = time(NULL);
+        state->match_duration_seconds = (int)(end_time - state->match_start_time);
+        
+        if (state->winner_id >= 0) {
+            printf("[GAME] Game ended. Winner: %s (Duration: %d seconds)\n", 
+                   state->players[state->winner_id].username, state->match_duration_seconds);
+        } else {
+            printf("[GAME] Game ended. Draw! (Duration: %d seconds)\n", 
+                   state->match_duration_seconds);
+        }
+    }
+}
+
+// === FOG OF WAR FUNCTIONS ===
+
+// Fill 'seen' with the tiles player_id has line of sight to (fog_radius,
+// walls block). Returns 0 when the player's view is not fogged at all.
+static int fog_visible_tiles(GameWorld *state, int player_id, uint64_t *seen) {
+    // No fog in non-fog-of-war modes
+    if (state->game_mode != GAME_MODE_FOG_OF_WAR) return 0;
+    
+    // Spectator views stay fully fogged
+    if (player_id < 0 || player_id >= state->num_players) {
+        memset(seen, 0, sizeof(uint64_t) * VIS_MAX_ROWS);
+        return 1;
+    }
+    
+    Player *p = &state->players[player_id];
+    
+    // Dead players see everything (spectator view)
+    if (!p->is_alive) return 0;
+    
+    vis_compute(&state->opacity, p->x, p->y, state->fog_radius, seen);
+    return 1;
+}
+
+// === VIEW ENCODING ===
+
+// Top-left world tile of the MAP_WIDTH x MAP_HEIGHT window sent to a player.
+// Standard maps are exactly one window; arena windows follow the player
+// (spectators follow the first player still alive).
+static void view_origin(GameWorld *state, int player_id, int *vx, int *vy) {
+    *vx = 0;
+    *vy = 0;
+    if (state->width <= MAP_WIDTH && state->height <= MAP_HEIGHT) return;
+
+    Player *focus = NULL;
+    if (player_id >= 0 && player_id < state->num_players) {
+        focus = &state->players[player_id];
+    }
+    for (int i = 0; !focus && i < state->num_players; i++) {
+        if (state->players[i].is_alive) focus = &state->players[i];
+    }
+    if (!focus) return;
+
+    *vx = focus->x - MAP_WIDTH / 2;
+    *vy = focus->y - MAP_HEIGHT / 2;
+    if (*vx > state->width - MAP_WIDTH) *vx = state->width - MAP_WIDTH;
+    if (*vy > state->height - MAP_HEIGHT) *vy = state->height - MAP_HEIGHT;
+    if (*vx < 0) *vx = 0;
+    if (*vy < 0) *vy = 0;
+}
+
+// Pick which players go into a view. Standard modes send everyone in lobby
+// order. Arena views send the recipient, the winner once the game is over,
+// and then the nearest alive players inside the window, found through the grid.
+static int select_view_players(GameWorld *state, int player_id, int vx, int vy, int *out) {
+    int n = 0;
+
+    if (state->game_mode != GAME_MODE_ARENA) {
+        for (int i = 0; i < state->num_players && n < MAX_VIEW_PLAYERS; i++) out[n++] = i;
+        return n;
+    }
+
+    if (player_id >= 0 && player_id < state->num_players) out[n++] = player_id;
+    if (state->game_status == GAME_ENDED && state->winner_id >= 0 && state->winner_id != player_id) {
+        out[n++] = state->winner_id;
+    }
+
+    int nearby[MAX_LOBBY_PLAYERS];
+    int dist[MAX_LOBBY_PLAYERS];
+    int count = grid_query(state, vx, vy, vx + MAP_WIDTH - 1, vy + MAP_HEIGHT - 1,
+                           nearby, MAX_LOBBY_PLAYERS);
+    int cx = vx + MAP_WIDTH / 2, cy = vy + MAP_HEIGHT / 2;
+    for (int i = 0; i < count; i++) {
+        Player *p = &state->players[nearby[i]];
+        dist[i] = abs(p->x - cx) + abs(p->y - cy);
+    }
+
+    // Partial selection sort: only the closest few are needed
+    while (n < MAX_VIEW_PLAYERS && count > 0) {
+        int best = 0;
+        for (int i = 1; i < count; i++) {
+            if (dist[i] < dist[best]) best = i;
+        }
+        int id = nearby[best];
+        nearby[best] = nearby[--count];
+        dist[best] = dist[count];
+
+        int dup = 0;
+        for (int j = 0; j < n; j++) {
+            if (out[j] == id) dup = 1;
+        }
+        if (!dup) out[n++] = id;
+    }
+    return n;
+}
+
+// Build the GameState a single recipient sees (player_id -1 = spectator)
+void encode_view(GameWorld *state, int player_id, GameState *out) {
+    memset(out, 0, sizeof(GameState));
+
+    int vx, vy;
+    view_origin(state, player_id, &vx, &vy);
+    uint64_t seen[VIS_MAX_ROWS];
+    int fogged = fog_visible_tiles(state, player_id, seen);
+    out->view_x = vx;
+    out->view_y = vy;
+    out->world_width = state->width;
+    out->world_height = state->height;
+
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            int wx = vx + x, wy = vy + y;
+            if (wx >= state->width || wy >= state->height) {
+                out->map[y][x] = WALL_HARD;
+                continue;
+            }
+            out->map[y][x] = state->map[wy][wx];
+            // Hide unseen tiles (keep hard walls for structure)
+            if (fogged && out->map[y][x] != WALL_HARD && !vis_is_set(seen, wx, wy)) {
+                out->map[y][x] = EMPTY;
+            }
+        }
+    }
+
+    int ids[MAX_VIEW_PLAYERS];
+    out->num_players = select_view_players(state, player_id, vx, vy, ids);
+    out->self_slot = -1;
+    out->winner_id = -1;
+    for (int slot = 0; slot < out->num_players; slot++) {
+        int id = ids[slot];
+        out->players[slot] = state->players[id];
+        out->kills[slot] = state->kills[id];
+        out->elo_changes[slot] = state->elo_changes[id];
+        if (id == player_id) out->self_slot = slot;
+        if (id == state->winner_id) out->winner_id = slot;
+
+        // Fog: move unseen players off-map (don't change is_alive!)
+        Player *p = &out->players[slot];
+        if (fogged && id != player_id && p->is_alive && !vis_is_set(seen, p->x, p->y)) {
+            p->x = -100;
+            p->y = -100;
+            p->px = -100 * TILE_FP;
+            p->py = -100 * TILE_FP;
+            p->move_dir = MOVE_NONE;
+        }
+    }
+
+    out->total_players = state->num_players;
+    for (int i = 0; i < state->num_players; i++) {
+        if (state->players[i].is_alive) out->alive_players++;
+    }
+
+    out->game_status = state->game_status;
+    out->match_start_time = state->match_start_time;
+    out->match_duration_seconds = state->match_duration_seconds;
+    out->end_game_time = state->end_game_time;
+    out->game_mode = state->game_mode;
+    out->fog_radius = state->fog_radius;
+    out->sudden_death_timer = state->sudden_death_timer;
+    out->shrink_zone_left = state->shrink_zone_left;
+    out->shrink_zone_right = state->shrink_zone_right;
+    out->shrink_zone_top = state->shrink_zone_top;
+    out->shrink_zone_bottom = state->shrink_zone_bottom;
+    out->start_game_time = state->start_game_time;
+    out->tick_rate = state->tick_rate;
+    out->tick = state->tick;
+}
+
+// === TICK PIPELINE (runs on the worker pool) ===
+
+// Encode the views for one tick. Classic modes share one view; fog of war
+// and arena get one view per player plus a spectator view.
+void encode_game_snapshot(GameWorld *state, GameSnapshot *out) {
+    out->per_player_views = (state->game_mode == GAME_MODE_FOG_OF_WAR ||
+                             state->game_mode == GAME_MODE_ARENA);
+    out->num_views = out->per_player_views ? state->num_players + 1 : 1;
+
+    for (int v = 0; v < out->num_views; v++) {
+        // Last view is for spectators (no player id)
+        int player_id = (out->per_player_views && v < state->num_players) ? v : -1;
+        encode_view(state, player_id, &out->views[v]);
+    }
+}
+
+// Called on the network thread. Returns 0 if the queue is full (input dropped).
+int game_queue_input(ActiveGame *game, int player_id, int type, int data) {
+    GameInputQueue *q = &game->inputs;
+    unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    if (tail - head >= GAME_INPUT_QUEUE_SIZE) return 0;
+
+    GameInput *in = &q->items[tail & (GAME_INPUT_QUEUE_SIZE - 1)];
+    in->player_id = player_id;
+    in->type = type;
+    in->data = data;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+static void apply_queued_inputs(ActiveGame *game) {
+    GameInputQueue *q = &game->inputs;
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    while (head != tail) {
+        GameInput *in = &q->items[head & (GAME_INPUT_QUEUE_SIZE - 1)];
+        if (in->type == MSG_MOVE) {
+            handle_move(game, in->player_id, in->data);
+        } else if (in->type == MSG_PLANT_BOMB) {
+            plant_bomb(game, in->player_id);
+        }
+        head++;
+    }
+    atomic_store_explicit(&q->head, head, memory_order_release);
+}
+
+// Readable when a tick task has finished; the network thread then drains the
+// output queues of the running lobbies
+static int pipeline_fd = -1;
+
+static void finish_game_tick(ActiveGame *game) {
+    atomic_store_explicit(&game->tick_running, 0, memory_order_release);
+    uint64_t one = 1;
+    if (write(pipeline_fd, &one, sizeof(one)) < 0) {
+        perror("[TICK] eventfd write");
+    }
+}
+
+// Worker task: apply inputs, run the owed fixed steps, encode the outgoing views.
+// A catch-up burst (steps_due > 1) only publishes the final state. The network
+// thread doesn't wait for it; it picks the views up from the output queue.
+void run_game_tick(void *arg) {
+    ActiveGame *game = (ActiveGame *)arg;
+    GameOutputQueue *q = &game->outputs;
+    int move_results[MAX_LOBBY_PLAYERS] = {0};
+    int steps = (game->steps_due > 0) ? game->steps_due : 1;
+
+    apply_queued_inputs(game);
+    for (int i = 0; i < steps && game->state.game_status == GAME_RUNNING; i++) {
+        game->state.tick++;
+        // From the tick count, so rates that don't divide 1000 don't drift
+        game->sim_time_ms = (long long)game->state.tick * 1000 / game->state.tick_rate;
+        move_players(game, move_results);
+        grid_build(&game->state);
+        update_game(game);
+    }
+    game->steps_due = 0;
+    refresh_opacity(&game->state);
+
+    unsigned int tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail - head >= GAME_OUTPUT_QUEUE_SIZE) {
+        // Network thread hasn't collected earlier views yet; it will get the next one
+        finish_game_tick(game);
+        return;
+    }
+
+    GameSnapshot *snap = &q->items[tail & (GAME_OUTPUT_QUEUE_SIZE - 1)];
+    memcpy(snap->move_results, move_results, sizeof(move_results));
+    encode_game_snapshot(&game->state, snap);
+
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    finish_game_tick(game);
+}
+
+int game_pipeline_init() {
+    pipeline_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (pipeline_fd < 0) {
+        perror("[TICK] eventfd");
+    }
+    return pipeline_fd;
+}
+
+int game_pipeline_fd() {
+    return pipeline_fd;
+}
+
+void game_pipeline_drain_fd() {
+    uint64_t count;
+    while (read(pipeline_fd, &count, sizeof(count)) > 0) {}
+}
+
+// Network thread: wait out a tick task still running on this game before
+// touching its state directly. Ticks take well under a millisecond, and only
+// rare paths (forfeit, rejoin, spectate, match end) need this.
+void game_wait_idle(ActiveGame *game) {
+    while (atomic_load_explicit(&game->tick_running, memory_order_acquire)) {
+        sched_yield();
+    }
+}
+
+// Called on the network thread: oldest uncollected snapshot, or NULL
+GameSnapshot* game_peek_snapshot(ActiveGame *game) {
+    GameOutputQueue *q = &game->outputs;
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    if (head == tail) return NULL;
+    return &q->items[head & (GAME_OUTPUT_QUEUE_SIZE - 1)];
+}
+
+void game_release_snapshot(ActiveGame *game) {
+    GameOutputQueue *q = &game->outputs;
+    unsigned int head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+}
@@ -27,43 +27,117 @@ const char* auth_code_to_message(int code) {
             return "Account does not exist";
         case AUTH_WRONG_PASSWORD:
             return "Incorrect password";
+        case AUTH_SERVER_BUSY:
+            return "Server is busy, please try again";
 
         default:
             return "Authentication failed";
     }
 }
 
-void handle_register(int socket_fd, ClientPacket *pkt) {
-    ClientInfo *client = find_client_by_socket(socket_fd);
-    if (!client) return;
-    
+// --- Password work on the auth pool ---
+// handle_register/handle_login do the quick checks, then queue the password
+// hash; the *_hashed/_verified callbacks finish the request on the main loop.
+// A client waits on at most one job, identified by its ticket, so a reply
+// never reaches a different client that inherited the socket number.
+static unsigned int next_ticket = 0;
+
+static void send_auth_code(int socket_fd, int code) {
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_AUTH_RESPONSE;
+    response.code = code;
+    strncpy(response.message, auth_code_to_message(code), sizeof(response.message) - 1);
+    send_response(socket_fd, &response);
+}
+
+static void submit_auth_job(ClientInfo *client, AuthJob *job) {
+    if (++next_ticket == 0) next_ticket = 1;
+    job->ticket = next_ticket;
+    job->socket_fd = client->socket_fd;
+
+    if (auth_pool_submit(job) != 0) {
+        log_event("AUTH", "Hashing queue full, turned away client %d", client->socket_fd);
+        send_auth_code(client->socket_fd, AUTH_SERVER_BUSY);
+    } else {
+        client->auth_ticket = job->ticket;
+    }
+    memset(job->password, 0, sizeof(job->password));
+}
+
+// The client this job answers, or NULL if it disconnected meanwhile
+static ClientInfo* waiting_client(const AuthJob *job) {
+    ClientInfo *client = find_client_by_socket(job->socket_fd);
+    if (!client || client->auth_ticket != job->ticket) return NULL;
+    client->auth_ticket = 0;
+    return client;
+}
+
+// Mark the client logged in and fill the success response. Returns -1, with
+// the client still logged out, if no session could be issued.
+static int sign_in(ClientInfo *client, const User *user, ServerPacket *response) {
+    char token[64];
+    if (session_issue(user->id, token, sizeof(token)) != 0) {
+        log_event("AUTH", "No session token for %s, sign-in refused", user->username);
+        return -1;
+    }
+
+    client->user_id = user->id;
+    strncpy(client->username, user->username, MAX_USERNAME - 1);
+    strncpy(client->display_name, user->display_name, MAX_DISPLAY_NAME - 1);
+    client->is_authenticated = 1;
+    client_set_lobby(client, client->lobby_id);  // Online for friends
+
+    response->code = AUTH_SUCCESS;
+    response->payload.auth.user_id = user->id;
+    strncpy(response->payload.auth.username, user->username, MAX_USERNAME - 1);
+    strncpy(response->payload.auth.display_name, user->display_name, MAX_DISPLAY_NAME - 1);
+    response->payload.auth.elo_rating = user->elo_rating;
+    strncpy(response->payload.auth.session_token, token, 63);
+    strncpy(client->session_token, token, 63);
+    return 0;
+}
+
+// SMART REJOIN: put a returning player back into the game they dropped from
+static void rejoin_running_game(ClientInfo *client, const char *username) {
+    for (int l = 0; l < lobby_count(); l++) {
+        Lobby *lb = lobby_at(l);
+        if (lb->status != LOBBY_PLAYING) continue;
+        GameWorld *gs = &lobby_game(lb->id)->state;
+        for (int p = 0; p < gs->num_players; p++) {
+            if (strcmp(gs->players[p].username, username) != 0) continue;
+
+            log_event("RECONNECT", "User %s found in active lobby %d", username, lb->id);
+            client_set_lobby(client, lb->id);
+            client->player_id_in_game = p;
+
+            send_lobby_update(client->socket_fd, lb);
+            broadcast_game_state(lb->id);
+            return;
+        }
+    }
+}
+
+static void register_hashed(AuthJob *job) {
+    ClientInfo *client = waiting_client(job);
+    if (!client) return;  // Nobody to answer; the account is not created
+
     ServerPacket response;
     memset(&response, 0, sizeof(ServerPacket));
-    
     response.type = MSG_AUTH_RESPONSE;
-    response.code = db_register_user(pkt->username, pkt->email, pkt->password);
+
+    int user_id = 0;
+    response.code = job->result;
+    if (response.code == AUTH_SUCCESS) {
+        response.code = db_insert_user(job->username, job->email, job->hash, job->salt, &user_id);
+    }
     
     if (response.code == AUTH_SUCCESS) {
         // Auto-login logic
         User user;
-        if (db_login_user(pkt->username, pkt->password, &user) == AUTH_SUCCESS) {
-            client->user_id = user.id;
-            strncpy(client->username, user.username, MAX_USERNAME - 1);
-            strncpy(client->display_name, user.display_name, MAX_DISPLAY_NAME - 1);
-            client->is_authenticated = 1;
-
-            response.payload.auth.user_id = user.id;
-            strncpy(response.payload.auth.username, user.username, MAX_USERNAME - 1);
-            strncpy(response.payload.auth.display_name, user.display_name, MAX_DISPLAY_NAME - 1);
-            response.payload.auth.elo_rating = user.elo_rating;
-
-            char token[64];
-            generate_session_token(token, 64);
-            if (db_update_session_token(user.id, token) == 0) {
-                strncpy(response.payload.auth.session_token, token, 63);
-                strncpy(client->session_token, token, 63);
-            }
-
+        memset(&user, 0, sizeof(User));
+        if (db_get_user_by_id(user_id, &user) == 0 && sign_in(client, &user, &response) == 0) {
+            db_touch_login(&user);
             strcpy(response.message, "Registration successful - welcome!");
             log_event("AUTH", "Registration + Auto-login: %s (ID: %d, ELO: %d)", 
                    user.username, user.id, user.elo_rating);
@@ -73,68 +147,92 @@ void handle_register(int socket_fd, ClientPacket *pkt) {
     } else {
         strncpy(response.message,auth_code_to_message(response.code),sizeof(response.message) - 1);
     }
-    send_response(socket_fd, &response);
+    send_response(client->socket_fd, &response);
 }
 
-void handle_login(int socket_fd, ClientPacket *pkt) {
+void handle_register(int socket_fd, ClientPacket *pkt) {
     ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || client->auth_ticket) return;  // The pending request will answer
+    
+    pkt->username[MAX_USERNAME - 1] = '\0';
+    pkt->email[sizeof(pkt->email) - 1] = '\0';
+    pkt->password[MAX_PASSWORD - 1] = '\0';
+    int code = db_check_registration(pkt->username, pkt->email, pkt->password);
+    if (code != AUTH_SUCCESS) {
+        send_auth_code(socket_fd, code);
+        return;
+    }
+
+    AuthJob job;
+    memset(&job, 0, sizeof(AuthJob));
+    job.type = AUTH_JOB_HASH;
+    job.on_done = register_hashed;
+    strncpy(job.username, pkt->username, MAX_USERNAME - 1);
+    strncpy(job.email, pkt->email, MAX_EMAIL - 1);
+    strncpy(job.password, pkt->password, MAX_PASSWORD - 1);
+    generate_salt(job.salt, sizeof(job.salt));
+    submit_auth_job(client, &job);
+}
+
+static void login_verified(AuthJob *job) {
+    User *user = &job->user;
+
+    // Store the upgraded hash even if the client has gone
+    if (job->result == AUTH_SUCCESS && job->rehashed) {
+        DbJob write;
+        memset(&write, 0, sizeof(write));
+        write.type = DB_JOB_PASSWORD_UPDATE;
+        write.data.password.user_id = user->id;
+        memcpy(write.data.password.hash, job->hash, PASSWORD_HASH_SIZE);
+        memcpy(write.data.password.salt, job->salt, PASSWORD_SALT_SIZE);
+        db_writer_submit(&write);
+        log_event("AUTH", "Rehashed password for %s (ID: %d)", user->username, user->id);
+    }
+
+    ClientInfo *client = waiting_client(job);
     if (!client) return;
 
+    if (job->result != AUTH_SUCCESS) {
+        if (job->result == AUTH_WRONG_PASSWORD) {
+            printf("[DB] Invalid password for: %s\n", user->username);
+        }
+        send_auth_code(client->socket_fd, job->result);
+        return;
+    }
+
     ServerPacket response;
     memset(&response, 0, sizeof(ServerPacket));
-    User user;
-    
     response.type = MSG_AUTH_RESPONSE;
-    response.code = db_login_user(pkt->username, pkt->password, &user);
     
-    if (response.code == AUTH_SUCCESS) {
-        client->user_id = user.id;
-        strncpy(client->username, user.username, MAX_USERNAME - 1);
-        strncpy(client->display_name, user.display_name, MAX_DISPLAY_NAME - 1);
-        client->is_authenticated = 1;
-        
-        response.payload.auth.user_id = user.id;
-        strncpy(response.payload.auth.username, user.username, MAX_USERNAME - 1);
-        strncpy(response.payload.auth.display_name, user.display_name, MAX_DISPLAY_NAME - 1);
-        response.payload.auth.elo_rating = user.elo_rating;
-        
-        char token[64];
-        generate_session_token(token, 64);
-        if (db_update_session_token(user.id, token) == 0) {
-            strncpy(response.payload.auth.session_token, token, 63);
-            strncpy(client->session_token, token, 63);
-        }
-        
-        strcpy(response.message, "Login successful");
-        log_event("AUTH", "Login: %s (ID: %d, ELO: %d)", user.username, user.id, user.elo_rating);
-        
-        // SMART REJOIN logic
-        for (int i = 0; i < MAX_LOBBIES; i++) {
-             Lobby *lb = find_lobby(i);
-             if (lb && lb->status == LOBBY_PLAYING) {
-                 GameState *gs = &active_games[i];
-                 for(int p=0; p < gs->num_players; p++) {
-                     if (strcmp(gs->players[p].username, user.username) == 0) {
-                         log_event("RECONNECT", "User %s found in active lobby %d", user.username, i);
-                         client->lobby_id = i;
-                         client->player_id_in_game = p;
-                         
-                         ServerPacket lobby_pkt;
-                         memset(&lobby_pkt, 0, sizeof(ServerPacket));
-                         lobby_pkt.type = MSG_LOBBY_UPDATE; 
-                         lobby_pkt.code = 0;
-                         lobby_pkt.payload.lobby = *lb;
-                         send_response(client->socket_fd, &lobby_pkt);
-                         broadcast_game_state(i);
-                         break;
-                     }
-                 }
-             }
-        }
-    } else {
-        strncpy(response.message,auth_code_to_message(response.code),sizeof(response.message) - 1);
+    if (sign_in(client, user, &response) != 0) {
+        send_auth_code(client->socket_fd, AUTH_FAIL);
+        return;
     }
-    send_response(socket_fd, &response);
+    db_touch_login(user);
+    strcpy(response.message, "Login successful");
+    log_event("AUTH", "Login: %s (ID: %d, ELO: %d)", user->username, user->id, user->elo_rating);
+    
+    rejoin_running_game(client, user->username);
+    send_response(client->socket_fd, &response);
+}
+
+void handle_login(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || client->auth_ticket) return;  // The pending request will answer
+
+    AuthJob job;
+    memset(&job, 0, sizeof(AuthJob));
+    pkt->username[MAX_USERNAME - 1] = '\0';
+    int code = db_get_login(pkt->username, &job.user, job.hash, job.salt);
+    if (code != AUTH_SUCCESS) {
+        send_auth_code(socket_fd, code);
+        return;
+    }
+
+    job.type = AUTH_JOB_VERIFY;
+    job.on_done = login_verified;
+    strncpy(job.password, pkt->password, MAX_PASSWORD - 1);
+    submit_auth_job(client, &job);
 }
 
 void handle_login_with_token(int socket_fd, ClientPacket *pkt) {
@@ -144,48 +242,20 @@ void handle_login_with_token(int socket_fd, ClientPacket *pkt) {
     ServerPacket response;
     memset(&response, 0, sizeof(ServerPacket));
     User user;
+    memset(&user, 0, sizeof(User));
     
     response.type = MSG_AUTH_RESPONSE;
-    if (db_get_user_by_token(pkt->session_token, &user) == 0) {
-        response.code = AUTH_SUCCESS;
-        client->user_id = user.id;
-        strncpy(client->username, user.username, MAX_USERNAME - 1);
-        strncpy(client->display_name, user.display_name, MAX_DISPLAY_NAME - 1);
-        client->is_authenticated = 1;
-        strncpy(client->session_token, user.session_token, 63);
-        
-        response.payload.auth.user_id = user.id;
-        strncpy(response.payload.auth.username, user.username, MAX_USERNAME - 1);
-        strncpy(response.payload.auth.display_name, user.display_name, MAX_DISPLAY_NAME - 1);
-        response.payload.auth.elo_rating = user.elo_rating;
-        strncpy(response.payload.auth.session_token, user.session_token, 63);
+    pkt->session_token[sizeof(pkt->session_token) - 1] = '\0';
+    int user_id = session_resolve(pkt->session_token);
+    if (user_id > 0 && db_get_user_by_id(user_id, &user) == 0 &&
+        sign_in(client, &user, &response) == 0) {
+        // Rotate: the presented token is spent, sign_in() issued a fresh one
+        session_revoke(pkt->session_token);
         strcpy(response.message, "Auto-login successful");
         
         log_event("AUTH", "Auto-Login: %s (ID: %d)", user.username, user.id);
         
-        // SMART REJOIN logic
-        for (int i = 0; i < MAX_LOBBIES; i++) {
-             Lobby *lb = find_lobby(i);
-             if (lb && lb->status == LOBBY_PLAYING) {
-                 GameState *gs = &active_games[i];
-                 for(int p=0; p < gs->num_players; p++) {
-                     if (strcmp(gs->players[p].username, user.username) == 0) {
-                         log_event("RECONNECT", "User %s found in active lobby %d", user.username, i);
-                         client->lobby_id = i;
-                         client->player_id_in_game = p;
-                         
-                         ServerPacket lobby_pkt;
-                         memset(&lobby_pkt, 0, sizeof(ServerPacket));
-                         lobby_pkt.type = MSG_LOBBY_UPDATE; 
-                         lobby_pkt.code = 0;
-                         lobby_pkt.payload.lobby = *lb;
-                         send_response(client->socket_fd, &lobby_pkt);
-                         broadcast_game_state(i);
-                         break;
-                     }
-                 }
-             }
-        }
+        rejoin_running_game(client, user.username);
     } else {
         response.code = AUTH_FAIL;
         strcpy(response.message, "Session expired or invalid");
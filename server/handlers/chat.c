@@ -1,7 +1,52 @@
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include "../server.h"
 
+// Slot for a new message: the next free one, or the oldest once full
+static ChatHistoryEntry* chat_push(LobbyChat *chat) {
+    ChatHistoryEntry *entry = &chat->messages[(chat->first + chat->count) % MAX_CHAT_HISTORY];
+    if (chat->count < MAX_CHAT_HISTORY) chat->count++;
+    else chat->first = (chat->first + 1) % MAX_CHAT_HISTORY;
+    return entry;
+}
+
+// i-th message, oldest first
+static const ChatHistoryEntry* chat_at(const LobbyChat *chat, int i) {
+    return &chat->messages[(chat->first + i) % MAX_CHAT_HISTORY];
+}
+
+static int backlog_record_size(const ChatHistoryEntry *entry) {
+    return 1 + (int)strlen(entry->sender_username) + 1 + (int)strlen(entry->message) + 1;
+}
+
+// Catch a client that just entered a room up on its chat, in one packet
+// holding as many of the newest messages as fit
+void send_chat_backlog(ClientInfo *client) {
+    LobbyChat *chat = lobby_chat(client->lobby_id);
+    if (!chat || chat->count == 0) return;
+
+    int from = chat->count;
+    int length = 0;
+    while (from > 0 && length + backlog_record_size(chat_at(chat, from - 1)) <= CHAT_BACKLOG_BYTES) {
+        length += backlog_record_size(chat_at(chat, --from));
+    }
+
+    ServerPacket packet;
+    memset(&packet, 0, offsetof(ServerPacket, payload.chat_backlog.records));
+    packet.type = MSG_CHAT_BACKLOG;
+    packet.code = length;
+    packet.payload.chat_backlog.lobby_id = client->lobby_id;
+    char *out = packet.payload.chat_backlog.records;
+    for (int i = from; i < chat->count; i++) {
+        const ChatHistoryEntry *entry = chat_at(chat, i);
+        *out++ = (char)(entry->player_id + 1);
+        out = stpcpy(out, entry->sender_username) + 1;
+        out = stpcpy(out, entry->message) + 1;
+    }
+    send_response(client->socket_fd, &packet);
+}
+
 void handle_chat(int socket_fd, ClientPacket *pkt) {
     ClientInfo *client = find_client_by_socket(socket_fd);
     if (!client) return;
@@ -32,29 +77,13 @@ void handle_chat(int socket_fd, ClientPacket *pkt) {
     if (sender_player_id < 0) return;  // Sender not found in lobby
     
     // Store in chat history
-    LobbyChat* chat = &lobby_chats[client->lobby_id];
-    if (chat->count < MAX_CHAT_HISTORY) {
-        ChatHistoryEntry* entry = &chat->messages[chat->count];
-        strncpy(entry->sender_username, client->username, MAX_USERNAME - 1);
-        entry->sender_username[MAX_USERNAME - 1] = '\0';
-        strncpy(entry->message, pkt->chat_message, 199);
-        entry->message[199] = '\0';
-        entry->timestamp = (uint32_t)time(NULL);
-        entry->player_id = sender_player_id;
-        chat->count++;
-    } else {
-        // Shift array and add new message (FIFO)
-        for (int i = 0; i < MAX_CHAT_HISTORY - 1; i++) {
-            chat->messages[i] = chat->messages[i + 1];
-        }
-        ChatHistoryEntry* entry = &chat->messages[MAX_CHAT_HISTORY - 1];
-        strncpy(entry->sender_username, client->username, MAX_USERNAME - 1);
-        entry->sender_username[MAX_USERNAME - 1] = '\0';
-        strncpy(entry->message, pkt->chat_message, 199);
-        entry->message[199] = '\0';
-        entry->timestamp = (uint32_t)time(NULL);
-        entry->player_id = sender_player_id;
-    }
+    ChatHistoryEntry* entry = chat_push(lobby_chat(client->lobby_id));
+    strncpy(entry->sender_username, client->username, MAX_USERNAME - 1);
+    entry->sender_username[MAX_USERNAME - 1] = '\0';
+    strncpy(entry->message, pkt->chat_message, 199);
+    entry->message[199] = '\0';
+    entry->timestamp = (uint32_t)time(NULL);
+    entry->player_id = sender_player_id;
     
     // Broadcast to all players in the lobby
     ServerPacket chat_msg;
@@ -2,6 +2,8 @@
 #include <string.h>
 #include "../server.h"
 
+// Moves and bombs are not applied here: they are queued for the lobby's next
+// tick, which runs on the worker pool and broadcasts the result.
 void handle_game_move(int socket_fd, ClientPacket *pkt) {
     ClientInfo *client = find_client_by_socket(socket_fd);
     if (!client) return;
@@ -10,7 +12,8 @@ void handle_game_move(int socket_fd, ClientPacket *pkt) {
     if (client->lobby_id != -1) {
         Lobby *lobby = find_lobby(client->lobby_id);
         if (lobby && lobby->status == LOBBY_PLAYING) {
-            GameState *gs = &active_games[client->lobby_id];
+            ActiveGame *game = lobby_game(client->lobby_id);
+            GameWorld *gs = &game->state;
             
             // Find player index in game state
             int p_id = -1;
@@ -22,28 +25,7 @@ void handle_game_move(int socket_fd, ClientPacket *pkt) {
             }
 
             if (p_id != -1) {
-                ServerPacket notif;
-                memset(&notif, 0, sizeof(ServerPacket));
-                
-                int move_result = handle_move(gs, p_id, pkt->data);
-                
-                // Check if power-up was involved
-                if (move_result == 11) {
-                    // Picked up power-up
-                    notif.type = MSG_NOTIFICATION;
-                    notif.code = 0;
-                    sprintf(notif.message, "Power-up collected!");
-                    send_response(client->socket_fd, &notif);
-                } else if (move_result == 12) {
-                    // Already at max
-                    notif.type = MSG_NOTIFICATION;
-                    notif.code = 1;
-                    sprintf(notif.message, "Already at maximum capacity!");
-                    send_response(client->socket_fd, &notif);
-                }
-                
-                // IMPORTANT: Broadcast immediately for responsiveness
-                broadcast_game_state(client->lobby_id);
+                game_queue_input(game, p_id, MSG_MOVE, pkt->data);
             }
         }
     }
@@ -57,7 +39,8 @@ void handle_plant_bomb(int socket_fd, ClientPacket *pkt) {
     if (client->lobby_id != -1) {
         Lobby *lobby = find_lobby(client->lobby_id);
         if (lobby && lobby->status == LOBBY_PLAYING) {
-            GameState *gs = &active_games[client->lobby_id];
+            ActiveGame *game = lobby_game(client->lobby_id);
+            GameWorld *gs = &game->state;
             
             int p_id = -1;
             for(int i=0; i<gs->num_players; i++) {
@@ -68,8 +51,7 @@ void handle_plant_bomb(int socket_fd, ClientPacket *pkt) {
             }
 
             if (p_id != -1) {
-                plant_bomb(gs, p_id);
-                broadcast_game_state(client->lobby_id);
+                game_queue_input(game, p_id, MSG_PLANT_BOMB, 0);
             }
         }
     }
@@ -91,8 +73,12 @@ void handle_plant_bomb(int socket_fd, ClientPacket *pkt) {
 void forfeit_player_from_game(int lobby_id, const char *username) {
     Lobby *lb = find_lobby(lobby_id);
     if (!lb || lb->status != LOBBY_PLAYING) return;
+    // Match is over and its results are being saved
+    ActiveGame *game = lobby_game(lobby_id);
+    if (game->results_submitted) return;
+    game_wait_idle(game);  // Its tick task may still be running
 
-    GameState *gs = &active_games[lobby_id];
+    GameWorld *gs = &game->state;
     int p_idx = -1;
     for (int i = 0; i < gs->num_players; i++) {
         if (strcmp(gs->players[i].username, username) == 0) {
@@ -134,28 +120,14 @@ void handle_leave_game(int socket_fd, ClientPacket *pkt) {
 
         // Try to leave as spectator first
         if (leave_spectator(lid, client->username) == 0) {
-            client->lobby_id = -1;
+            client_set_lobby(client, -1);
             client->player_id_in_game = -1;
             broadcast_lobby_update(lid);
-            broadcast_lobby_list();
-            
-            ServerPacket response;
-            memset(&response, 0, sizeof(ServerPacket));
-            response.type = MSG_LOBBY_LIST;
-            response.payload.lobby_list.count = get_lobby_list(response.payload.lobby_list.lobbies);
-            send_response(socket_fd, &response);
             return;
         }
 
         forfeit_player_from_game(lid, client->username);
         leave_lobby(lid, client->username);
-        client->lobby_id = -1;
-        broadcast_lobby_list();
-
-        ServerPacket response;
-        memset(&response, 0, sizeof(ServerPacket));
-        response.type = MSG_LOBBY_LIST;
-        response.payload.lobby_list.count = get_lobby_list(response.payload.lobby_list.lobbies);
-        send_response(socket_fd, &response);
+        client_set_lobby(client, -1);
     }
 }
@@ -6,15 +6,11 @@ void handle_create_lobby(int socket_fd, ClientPacket *pkt) {
     ClientInfo *client = find_client_by_socket(socket_fd);
     if (!client || !client->is_authenticated) return;
 
-    ServerPacket response;
-    memset(&response, 0, sizeof(ServerPacket));
-
-    int lid = create_lobby(pkt->room_name, client->username, pkt->is_private, pkt->access_code, pkt->game_mode);
+    matchmaking_cancel(client);  // Picking a room by hand leaves quick play
+    int lid = create_lobby(pkt->room_name, client->username, pkt->is_private, pkt->access_code, pkt->game_mode, pkt->tick_rate);
     if (lid >= 0) {
-        client->lobby_id = lid;
-        response.type = MSG_LOBBY_UPDATE;
-        response.payload.lobby = *find_lobby(lid);
-        send_response(socket_fd, &response);
+        client_set_lobby(client, lid);
+        send_lobby_update(socket_fd, find_lobby(lid));
         
         if (pkt->is_private) {
             log_event("LOBBY", "Private room created with code: %s", pkt->access_code);
@@ -32,9 +28,9 @@ void handle_join_lobby(int socket_fd, ClientPacket *pkt) {
     // Use join_lobby_with_code to support private rooms
     int join_res = join_lobby_with_code(pkt->lobby_id, client->username, pkt->access_code);
     if (join_res == 0) {
-        client->lobby_id = pkt->lobby_id;
+        matchmaking_cancel(client);
+        client_set_lobby(client, pkt->lobby_id);
         broadcast_lobby_update(pkt->lobby_id);
-        broadcast_lobby_list(); // keep lobby list in sync for others
     } else {
         response.type = MSG_ERROR;
         response.code = join_res;
@@ -61,23 +57,18 @@ void handle_spectate(int socket_fd, ClientPacket *pkt) {
     
     int res = join_spectator(pkt->lobby_id, client->username);
     if (res == 0) {
-        client->lobby_id = pkt->lobby_id;
+        matchmaking_cancel(client);
+        client_set_lobby(client, pkt->lobby_id);
         client->player_id_in_game = -1; // Mark as spectator
         
         Lobby *lb = find_lobby(pkt->lobby_id);
         
         // Send Lobby Update
-        response.type = MSG_LOBBY_UPDATE;
-        response.payload.lobby = *lb;
-        send_response(socket_fd, &response);
+        send_lobby_update(socket_fd, lb);
         
         // If game is running, send initial state
         if (lb->status == LOBBY_PLAYING) {
-             ServerPacket gs_pkt;
-             memset(&gs_pkt, 0, sizeof(ServerPacket));
-             gs_pkt.type = MSG_GAME_STATE;
-             gs_pkt.payload.game_state = active_games[pkt->lobby_id];
-             send_response(socket_fd, &gs_pkt);
+             send_game_state(client, pkt->lobby_id);
         }
         
         // Notify everyone else
@@ -104,38 +95,53 @@ void handle_leave_lobby(int socket_fd, ClientPacket *pkt) {
         printf("[DEBUG] handle_leave_lobby: Trying to remove spectator %s from lobby %d\n", client->username, old_lid);
         if (leave_spectator(old_lid, client->username) == 0) {
              printf("[DEBUG] handle_leave_lobby: Successfully removed spectator %s\n", client->username);
-             client->lobby_id = -1;
+             client_set_lobby(client, -1);
              client->player_id_in_game = -1;
              broadcast_lobby_update(old_lid);
-             broadcast_lobby_list();
-             
-             ServerPacket response;
-             memset(&response, 0, sizeof(ServerPacket));
-             response.type = MSG_LOBBY_LIST;
-             response.payload.lobby_list.count = get_lobby_list(response.payload.lobby_list.lobbies);
-             send_response(socket_fd, &response);
              return;
         }
 
         leave_lobby(old_lid, client->username);
-        client->lobby_id = -1;
+        client_set_lobby(client, -1);
         broadcast_lobby_update(old_lid);
-        broadcast_lobby_list();
-        
-        ServerPacket response;
-        memset(&response, 0, sizeof(ServerPacket));
-        response.type = MSG_LOBBY_LIST;
-        response.payload.lobby_list.count = get_lobby_list(response.payload.lobby_list.lobbies);
-        send_response(socket_fd, &response);
     }
 }
 
+// One-off list of the first LOBBY_LIST_MAX rooms (clients that predate the feed)
 void handle_list_lobbies(int socket_fd, ClientPacket *pkt) {
     (void)pkt; // unused
+    send_lobby_list(socket_fd);
+}
+
+// Lobby browser opened: catch up from pkt->data, then follow the deltas
+void handle_lobby_subscribe(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+    lobby_feed_subscribe(client, (uint32_t)pkt->data);
+}
+
+void handle_lobby_unsubscribe(int socket_fd, ClientPacket *pkt) {
+    (void)pkt;
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client) return;
+    lobby_feed_unsubscribe(client);
+}
+
+// One page of the rooms matching the requested filters, in the requested order
+void handle_browse_lobbies(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+
     ServerPacket response;
     memset(&response, 0, sizeof(ServerPacket));
-    response.type = MSG_LOBBY_LIST;
-    response.payload.lobby_list.count = get_lobby_list(response.payload.lobby_list.lobbies);
+    response.type = MSG_BROWSE_LOBBIES_RESPONSE;
+
+    int filters = pkt->data & ((1 << LOBBY_SORT_SHIFT) - 1);
+    int sort = pkt->data >> LOBBY_SORT_SHIFT;
+    response.code = lobby_browse(filters, pkt->game_mode, sort, pkt->cursor,
+                                 response.payload.lobby_page.lobbies, LOBBY_LIST_MAX,
+                                 &response.payload.lobby_page.total,
+                                 &response.payload.lobby_page.next_cursor);
     send_response(socket_fd, &response);
 }
 
@@ -159,13 +165,14 @@ void handle_start_game(int socket_fd, ClientPacket *pkt) {
         int start_res = start_game(client->lobby_id, client->username);
         if (start_res == 0) {
             Lobby *lb = find_lobby(client->lobby_id);
-            init_game(&active_games[client->lobby_id], lb);
+            ActiveGame *game = lobby_game(client->lobby_id);
+            init_game(game, lb);
             
-            // Initialize game update timer
-            last_game_update[client->lobby_id] = get_current_time_ms();
+            // Start ticking this lobby on the fixed grid
+            tick_scheduler_start(client->lobby_id, lb->tick_rate, get_current_time_ms());
             
             // Set player_id_in_game for each client in this lobby for fog of war
-            GameState *gs = &active_games[client->lobby_id];
+            GameWorld *gs = &game->state;
             for (int i = 0; i < num_clients; i++) {
                 if (clients[i].lobby_id == client->lobby_id) {
                     // Find this client's player ID in the game state
@@ -184,3 +191,26 @@ void handle_start_game(int socket_fd, ClientPacket *pkt) {
         }
     }
 }
+
+void handle_queue_join(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+
+    matchmaking_enqueue(client, pkt->game_mode);
+}
+
+void handle_queue_leave(int socket_fd, ClientPacket *pkt) {
+    (void)pkt;
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || client->queue_ticket < 0) return;
+
+    matchmaking_cancel(client);
+
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_QUEUE_STATUS;
+    response.code = QUEUE_LEFT;
+    response.payload.queue_status.lobby_id = -1;
+    response.payload.queue_status.expected_wait_ms = -1;
+    send_response(socket_fd, &response);
+}
@@ -2,6 +2,26 @@
 #include <string.h>
 #include "../server.h"
 
+// Friends, then incoming, then outgoing requests in one packet. The code
+// field carries the request counts (low byte incoming, next byte outgoing).
+static void send_friend_list(int socket_fd, int user_id) {
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_FRIEND_LIST_RESPONSE;
+    
+    FriendInfo *out = response.payload.friend_list.friends;
+    int max = 50;
+    int friend_count = friend_get_list(user_id, out, max);
+    int pending_count = friend_get_pending_requests(user_id, out + friend_count,
+                                                    max - friend_count);
+    int sent_count = friend_get_sent_requests(user_id, out + friend_count + pending_count,
+                                              max - friend_count - pending_count);
+    
+    response.payload.friend_list.count = friend_count + pending_count + sent_count;
+    response.code = pending_count | (sent_count << 8);
+    send_response(socket_fd, &response);
+}
+
 void handle_friend_request(int socket_fd, ClientPacket *pkt) {
     ClientInfo *client = find_client_by_socket(socket_fd);
     if (!client || !client->is_authenticated) return;
@@ -43,35 +63,7 @@ void handle_friend_accept(int socket_fd, ClientPacket *pkt) {
     
     send_response(socket_fd, &response);
     
-    // Refresh friend list if successful
-    if (result == 0) {
-        // Reuse handle_friend_list? Or manually send response. 
-        // Let's manually send to be safe and explicit.
-        ServerPacket list_resp;
-        memset(&list_resp, 0, sizeof(ServerPacket));
-        list_resp.type = MSG_FRIEND_LIST_RESPONSE;
-        
-        int friend_count = friend_get_list(client->user_id, list_resp.payload.friend_list.friends, 50);
-        list_resp.payload.friend_list.count = friend_count;
-        
-        FriendInfo pending[50];
-        int pending_count = friend_get_pending_requests(client->user_id, pending, 50);
-        
-        FriendInfo sent[50];
-        int sent_count = friend_get_sent_requests(client->user_id, sent, 50);
-
-        // Combine logic similar to main.c
-        if (friend_count + pending_count + sent_count <= 50) {
-            memcpy(&list_resp.payload.friend_list.friends[friend_count], 
-                   pending, sizeof(FriendInfo) * pending_count);
-            memcpy(&list_resp.payload.friend_list.friends[friend_count + pending_count],
-                   sent, sizeof(FriendInfo) * sent_count);
-            list_resp.payload.friend_list.count += pending_count + sent_count;
-        }
-        
-        list_resp.code = pending_count | (sent_count << 8);
-        send_response(socket_fd, &list_resp);
-    }
+    if (result == 0) send_friend_list(socket_fd, client->user_id);
 }
 
 void handle_friend_reject(int socket_fd, ClientPacket *pkt) {
@@ -90,32 +82,7 @@ void handle_friend_reject(int socket_fd, ClientPacket *pkt) {
     
     send_response(socket_fd, &response);
     
-    // Refresh list logic is usually good here too
-    if (result == 0) {
-        // Reuse logic? Or copy-paste. Copy-paste for now to keep it self-contained.
-        ServerPacket list_resp;
-        memset(&list_resp, 0, sizeof(ServerPacket));
-        list_resp.type = MSG_FRIEND_LIST_RESPONSE;
-         // ... (same refresh logic)
-        int friend_count = friend_get_list(client->user_id, list_resp.payload.friend_list.friends, 50);
-        list_resp.payload.friend_list.count = friend_count;
-        
-        FriendInfo pending[50];
-        int pending_count = friend_get_pending_requests(client->user_id, pending, 50);
-        
-        FriendInfo sent[50];
-        int sent_count = friend_get_sent_requests(client->user_id, sent, 50);
-        
-        if (friend_count + pending_count + sent_count <= 50) {
-            memcpy(&list_resp.payload.friend_list.friends[friend_count], 
-                   pending, sizeof(FriendInfo) * pending_count);
-             memcpy(&list_resp.payload.friend_list.friends[friend_count + pending_count],
-                   sent, sizeof(FriendInfo) * sent_count);
-            list_resp.payload.friend_list.count += pending_count + sent_count;
-        }
-        list_resp.code = pending_count | (sent_count << 8);
-        send_response(socket_fd, &list_resp);
-    }
+    if (result == 0) send_friend_list(socket_fd, client->user_id);
 }
 
 
@@ -135,99 +102,35 @@ void handle_friend_remove(int socket_fd, ClientPacket *pkt) {
     
     send_response(socket_fd, &response);
     
-    // Refresh friend list
-    if (result == 0) {
-        ServerPacket list_resp;
-        memset(&list_resp, 0, sizeof(ServerPacket));
-        list_resp.type = MSG_FRIEND_LIST_RESPONSE;
-        
-        int friend_count = friend_get_list(client->user_id, list_resp.payload.friend_list.friends, 50);
-        list_resp.payload.friend_list.count = friend_count;
-        
-        FriendInfo pending[50];
-        int pending_count = friend_get_pending_requests(client->user_id, pending, 50);
-        
-        FriendInfo sent[50];
-        int sent_count = friend_get_sent_requests(client->user_id, sent, 50);
-        
-        if (friend_count + pending_count + sent_count <= 50) {
-            memcpy(&list_resp.payload.friend_list.friends[friend_count], 
-                   pending, sizeof(FriendInfo) * pending_count);
-             memcpy(&list_resp.payload.friend_list.friends[friend_count + pending_count],
-                   sent, sizeof(FriendInfo) * sent_count);
-            list_resp.payload.friend_list.count += pending_count + sent_count;
-        }
-        list_resp.code = pending_count | (sent_count << 8);
-        send_response(socket_fd, &list_resp);
-    }
+    if (result == 0) send_friend_list(socket_fd, client->user_id);
 }
 
 void handle_friend_list(int socket_fd, ClientPacket *pkt) {
     (void)pkt;
     ClientInfo *client = find_client_by_socket(socket_fd);
     if (!client || !client->is_authenticated) return;
-
-    ServerPacket response;
-    memset(&response, 0, sizeof(ServerPacket));
-    response.type = MSG_FRIEND_LIST_RESPONSE;
-    
-    int friend_count = friend_get_list(client->user_id, response.payload.friend_list.friends, 50);
-    response.payload.friend_list.count = friend_count;
-    
-    FriendInfo pending[50];
-    int pending_count = friend_get_pending_requests(client->user_id, pending, 50);
-    
-    FriendInfo sent[50];
-    int sent_count = friend_get_sent_requests(client->user_id, sent, 50);
-
-    if (friend_count + pending_count + sent_count <= 50) {
-        memcpy(&response.payload.friend_list.friends[friend_count], 
-               pending, sizeof(FriendInfo) * pending_count);
-        memcpy(&response.payload.friend_list.friends[friend_count + pending_count],
-               sent, sizeof(FriendInfo) * sent_count);
-        response.payload.friend_list.count += pending_count + sent_count;
-    }
-    
-    response.code = pending_count | (sent_count << 8);
-    
-    // Check online status logic - using display_name now
-    for (int i = 0; i < response.payload.friend_list.count; i++) {
-        // Only check online status for confirmed friends (first friend_count items)
-        if (i < friend_count) {
-             response.payload.friend_list.friends[i].is_online = 0;
-             for (int c = 0; c < num_clients; c++) {
-                 if (clients[c].is_authenticated && 
-                     strcmp(clients[c].display_name, response.payload.friend_list.friends[i].display_name) == 0) {
-                     response.payload.friend_list.friends[i].is_online = 1;
-                     if (clients[c].lobby_id != -1) {
-                          response.payload.friend_list.friends[i].is_online = 2; // In game/lobby
-                     }
-                     break;
-                 }
-             }
-        }
-    }
-    
-    send_response(socket_fd, &response);
+    send_friend_list(socket_fd, client->user_id);
 }
 
 void handle_get_profile(int socket_fd, ClientPacket *pkt) {
     ClientInfo *client = find_client_by_socket(socket_fd);
     if (!client || !client->is_authenticated) return;
     
-    ServerPacket response;
-    memset(&response, 0, sizeof(ServerPacket));
-    response.type = MSG_PROFILE_RESPONSE;
-    
     int target_id = client->user_id;
     if (pkt->target_user_id > 0) {
         target_id = pkt->target_user_id;
     } else if (pkt->data > 0) {
         target_id = pkt->data;
     }
+    if (response_cache_send(socket_fd, CACHE_PROFILE, target_id)) return;
+    
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_PROFILE_RESPONSE;
     
     if (stats_get_profile(target_id, &response.payload.profile) == 0) {
         response.code = 0; // Success
+        response_cache_store(CACHE_PROFILE, target_id, &response);
     } else {
         response.code = 1; // Failed
         strcpy(response.message, "Could not load profile");
@@ -235,14 +138,123 @@ void handle_get_profile(int socket_fd, ClientPacket *pkt) {
     send_response(socket_fd, &response);
 }
 
+// Profile with per-mode totals and recent form (from the rollup tables)
+void handle_get_profile_detail(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+    
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_PROFILE_DETAIL_RESPONSE;
+    
+    int target_id = (pkt->target_user_id > 0) ? pkt->target_user_id : client->user_id;
+    if (stats_get_profile_detail(target_id, &response.payload.profile_detail) == 0) {
+        response.code = 0;
+    } else {
+        response.code = 1;
+        strcpy(response.message, "Could not load profile");
+    }
+    send_response(socket_fd, &response);
+}
+
 void handle_get_leaderboard(int socket_fd, ClientPacket *pkt) {
     (void)pkt;
+    if (response_cache_send(socket_fd, CACHE_LEADERBOARD, 0)) return;
     
     ServerPacket response;
     memset(&response, 0, sizeof(ServerPacket));
     response.type = MSG_LEADERBOARD_RESPONSE;
     response.payload.leaderboard.count = 
-        stats_get_leaderboard(response.payload.leaderboard.entries, 100);
+        leaderboard_top(response.payload.leaderboard.entries, 100);
+    response.payload.leaderboard.total_players = leaderboard_size();
+    response_cache_store(CACHE_LEADERBOARD, 0, &response);
+    send_response(socket_fd, &response);
+}
+
+void handle_get_my_rank(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+    
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_RANK_RESPONSE;
+    
+    int target_id = (pkt->data > 0) ? pkt->data : client->user_id;
+    if (leaderboard_rank(target_id, &response.payload.rank.entry) > 0) {
+        response.code = 0;
+    } else {
+        response.code = 1;
+        strcpy(response.message, "Player is not ranked");
+    }
+    response.payload.rank.total_players = leaderboard_size();
+    send_response(socket_fd, &response);
+}
+
+// Players ranked just above and below someone (default: the caller)
+void handle_get_leaderboard_around(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+    
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_LEADERBOARD_AROUND_RESPONSE;
+    
+    int target_id = (pkt->target_user_id > 0) ? pkt->target_user_id : client->user_id;
+    int radius = (pkt->data > 0) ? pkt->data : 5;
+    if (radius > 49) radius = 49;  // 99 rows fit the payload
+    
+    response.payload.leaderboard.count = leaderboard_around(
+        target_id, radius, response.payload.leaderboard.entries, 100);
+    response.payload.leaderboard.total_players = leaderboard_size();
+    response.code = (response.payload.leaderboard.count > 0) ? 0 : 1;
+    send_response(socket_fd, &response);
+}
+
+// One page of someone's matches (default: the caller), newest first
+void handle_get_match_history(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+    
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_MATCH_HISTORY_RESPONSE;
+    
+    int target_id = (pkt->target_user_id > 0) ? pkt->target_user_id : client->user_id;
+    int page_size = (pkt->data > 0) ? pkt->data : 20;
+    if (page_size > MATCH_HISTORY_PAGE_MAX) page_size = MATCH_HISTORY_PAGE_MAX;
+    
+    response.payload.match_history.user_id = target_id;
+    response.code = stats_get_match_history(target_id, pkt->cursor,
+                                            response.payload.match_history.entries, page_size,
+                                            &response.payload.match_history.next_cursor);
+    send_response(socket_fd, &response);
+}
+
+// Players whose display name matches a query: exact, prefix, then fuzzy
+void handle_search_users(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    if (!client || !client->is_authenticated) return;
+
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    response.type = MSG_SEARCH_USERS_RESPONSE;
+
+    char query[MAX_DISPLAY_NAME];
+    strncpy(query, pkt->target_display_name, MAX_DISPLAY_NAME - 1);
+    query[MAX_DISPLAY_NAME - 1] = '\0';
+    int max_count = (pkt->data > 0 && pkt->data < SEARCH_RESULTS_MAX) ? pkt->data : SEARCH_RESULTS_MAX;
+
+    UserSearchResult *results = response.payload.user_search.results;
+    int count = name_index_search(query, results, max_count);
+    for (int i = 0; i < count; i++) {
+        LeaderboardEntry entry;
+        if (leaderboard_lookup(results[i].user_id, &entry)) {
+            strncpy(results[i].display_name, entry.display_name, MAX_DISPLAY_NAME - 1);
+            results[i].elo_rating = entry.elo_rating;
+        }
+        results[i].is_online = presence_of(results[i].user_id);
+    }
+    response.code = count;
     send_response(socket_fd, &response);
 }
 
@@ -266,12 +278,7 @@ void handle_invite(int socket_fd, ClientPacket *pkt) {
     
     // Priority: Lookup by ID
     if (pkt->target_user_id > 0) {
-        for (int i = 0; i < num_clients; i++) {
-            if (clients[i].is_authenticated && clients[i].user_id == pkt->target_user_id) {
-                target_socket = clients[i].socket_fd;
-                break;
-            }
-        }
+        target_socket = presence_socket(pkt->target_user_id);
     }
     
     // Fallback: Lookup by display name (for backward compatibility or if ID missing)
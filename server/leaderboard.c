@@ -0,0 +1,309 @@
+/* server/leaderboard.c - In-memory ranked leaderboard index */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sqlite3.h>
+#include "server.h"
+
+// Every player, ordered by rating (ties: lower user id first), in an indexed
+// skiplist: each link records how many players it skips, so rank lookups and
+// "player at rank r" are O(log n) walks instead of ORDER BY over Users.
+// Loaded once at startup, then kept in step with every rating change.
+// Main loop only.
+#define LB_MAX_LEVEL 24
+
+typedef struct LbNode {
+    int user_id;
+    int elo_rating;
+    int wins;
+    char display_name[MAX_DISPLAY_NAME];
+    int height;
+    struct {
+        struct LbNode *next;
+        int span;              // Players passed by following 'next'
+    } level[];
+} LbNode;
+
+static LbNode *lb_head = NULL;
+static int lb_level = 1;
+static int lb_count = 0;
+static GameRng lb_rng;          // Node heights only; any fixed seed will do
+
+// user_id -> node, grown on demand (ids are dense AUTOINCREMENT keys)
+static LbNode **by_id = NULL;
+static int by_id_cap = 0;
+
+// Does 'a' rank above (elo_rating, user_id)?
+static int ranks_before(const LbNode *a, int elo_rating, int user_id) {
+    if (a->elo_rating != elo_rating) return a->elo_rating > elo_rating;
+    return a->user_id < user_id;
+}
+
+static LbNode* node_alloc(int height) {
+    LbNode *node = calloc(1, sizeof(LbNode) + height * sizeof(node->level[0]));
+    if (node) node->height = height;
+    return node;
+}
+
+static int random_height() {
+    int h = 1;
+    while (h < LB_MAX_LEVEL && (rng_next(&lb_rng) & 3) == 0) h++;  // p = 1/4
+    return h;
+}
+
+static void list_insert(LbNode *node) {
+    LbNode *update[LB_MAX_LEVEL];
+    int rank[LB_MAX_LEVEL];
+    LbNode *x = lb_head;
+
+    for (int i = lb_level - 1; i >= 0; i--) {
+        rank[i] = (i == lb_level - 1) ? 0 : rank[i + 1];
+        while (x->level[i].next &&
+               ranks_before(x->level[i].next, node->elo_rating, node->user_id)) {
+            rank[i] += x->level[i].span;
+            x = x->level[i].next;
+        }
+        update[i] = x;
+    }
+
+    if (node->height > lb_level) {
+        for (int i = lb_level; i < node->height; i++) {
+            rank[i] = 0;
+            update[i] = lb_head;
+            update[i]->level[i].span = lb_count;
+        }
+        lb_level = node->height;
+    }
+
+    for (int i = 0; i < node->height; i++) {
+        node->level[i].next = update[i]->level[i].next;
+        update[i]->level[i].next = node;
+        node->level[i].span = update[i]->level[i].span - (rank[0] - rank[i]);
+        update[i]->level[i].span = (rank[0] - rank[i]) + 1;
+    }
+    for (int i = node->height; i < lb_level; i++) {
+        update[i]->level[i].span++;
+    }
+    lb_count++;
+}
+
+static void list_remove(LbNode *node) {
+    LbNode *update[LB_MAX_LEVEL];
+    LbNode *x = lb_head;
+
+    for (int i = lb_level - 1; i >= 0; i--) {
+        while (x->level[i].next && x->level[i].next != node &&
+               ranks_before(x->level[i].next, node->elo_rating, node->user_id)) {
+            x = x->level[i].next;
+        }
+        update[i] = x;
+    }
+
+    for (int i = 0; i < lb_level; i++) {
+        if (update[i]->level[i].next == node) {
+            update[i]->level[i].span += node->level[i].span - 1;
+            update[i]->level[i].next = node->level[i].next;
+        } else {
+            update[i]->level[i].span--;
+        }
+    }
+    while (lb_level > 1 && lb_head->level[lb_level - 1].next == NULL) {
+        lb_level--;
+    }
+    lb_count--;
+}
+
+// 1-based rank of 'node'
+static int node_rank(const LbNode *node) {
+    LbNode *x = lb_head;
+    int rank = 0;
+    for (int i = lb_level - 1; i >= 0; i--) {
+        while (x->level[i].next &&
+               (x->level[i].next == node ||
+                ranks_before(x->level[i].next, node->elo_rating, node->user_id))) {
+            rank += x->level[i].span;
+            x = x->level[i].next;
+        }
+        if (x == node) return rank;
+    }
+    return 0;
+}
+
+// Node at 1-based 'rank', or NULL past the end
+static LbNode* node_at(int rank) {
+    if (rank < 1 || rank > lb_count) return NULL;
+    LbNode *x = lb_head;
+    int traversed = 0;
+    for (int i = lb_level - 1; i >= 0; i--) {
+        while (x->level[i].next && traversed + x->level[i].span <= rank) {
+            traversed += x->level[i].span;
+            x = x->level[i].next;
+        }
+        if (traversed == rank) return x;
+    }
+    return NULL;
+}
+
+static LbNode* find_user(int user_id) {
+    if (user_id <= 0 || user_id >= by_id_cap) return NULL;
+    return by_id[user_id];
+}
+
+static void fill_entry(LeaderboardEntry *out, const LbNode *node, int rank) {
+    memset(out, 0, sizeof(*out));
+    out->rank = rank;
+    out->user_id = node->user_id;
+    memcpy(out->display_name, node->display_name, MAX_DISPLAY_NAME);  // Always terminated
+    out->elo_rating = node->elo_rating;
+    out->wins = node->wins;
+}
+
+// Up to 'max_count' consecutive entries starting at 'rank'
+static int copy_from(int rank, LeaderboardEntry *out, int max_count) {
+    int count = 0;
+    for (LbNode *x = node_at(rank); x && count < max_count; x = x->level[0].next) {
+        fill_entry(&out[count], x, rank + count);
+        count++;
+    }
+    return count;
+}
+
+// Add a player or replace their entry
+void leaderboard_set(int user_id, const char *display_name, int elo_rating, int wins) {
+    if (user_id <= 0 || !lb_head) return;
+
+    if (user_id >= by_id_cap) {
+        int cap = by_id_cap ? by_id_cap : 1024;
+        while (cap <= user_id) cap *= 2;
+        LbNode **grown = realloc(by_id, cap * sizeof(*grown));
+        if (!grown) {
+            fprintf(stderr, "[RANK] Out of memory growing index to %d users\n", cap);
+            return;
+        }
+        memset(grown + by_id_cap, 0, (cap - by_id_cap) * sizeof(*grown));
+        by_id = grown;
+        by_id_cap = cap;
+    }
+
+    LbNode *node = by_id[user_id];
+    if (!node) {
+        node = node_alloc(random_height());
+        if (!node) return;
+        node->user_id = user_id;
+        node->elo_rating = elo_rating;
+        by_id[user_id] = node;
+        list_insert(node);
+    } else if (node->elo_rating != elo_rating) {
+        list_remove(node);
+        node->elo_rating = elo_rating;
+        list_insert(node);
+    }
+    strncpy(node->display_name, display_name, MAX_DISPLAY_NAME - 1);
+    node->display_name[MAX_DISPLAY_NAME - 1] = '\0';
+    node->wins = wins;
+    name_index_set(user_id, display_name);
+    response_cache_invalidate(CACHE_LEADERBOARD, CACHE_ALL_KEYS);
+}
+
+// Apply a committed match result. elo_rating < 0 keeps the current rating.
+void leaderboard_update(int user_id, int elo_rating, int wins_delta) {
+    LbNode *node = find_user(user_id);
+    if (!node) return;
+    if (elo_rating >= 0 && elo_rating != node->elo_rating) {
+        list_remove(node);
+        node->elo_rating = elo_rating;
+        list_insert(node);
+    }
+    node->wins += wins_delta;
+    response_cache_invalidate(CACHE_LEADERBOARD, CACHE_ALL_KEYS);
+}
+
+// Re-read one player from the database (new account, renamed)
+void leaderboard_refresh_user(int user_id) {
+    ProfileData profile;
+    memset(&profile, 0, sizeof(profile));
+    if (stats_get_profile(user_id, &profile) == 0) {
+        leaderboard_set(user_id, profile.display_name, profile.elo_rating, profile.wins);
+    }
+}
+
+// Build the index from Users/Statistics. Call once after db_init().
+int leaderboard_load() {
+    rng_seed(&lb_rng, 0x1eade7b0a7dULL);
+    lb_head = node_alloc(LB_MAX_LEVEL);
+    if (!lb_head) return -1;
+
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_LEADERBOARD_LOAD);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        leaderboard_set(sqlite3_column_int(stmt, 0),
+                        (const char *)sqlite3_column_text(stmt, 1),
+                        sqlite3_column_int(stmt, 2),
+                        sqlite3_column_int(stmt, 3));
+    }
+    stmt_release(&db_stmts, STMT_LEADERBOARD_LOAD);
+
+    if (rc != SQLITE_DONE) {
+        fprintf(stderr, "[RANK] Failed to load leaderboard: %s\n", sqlite3_errmsg(db_stmts.conn));
+        return -1;
+    }
+    printf("[RANK] Leaderboard index loaded: %d players, %d searchable names\n",
+           lb_count, name_index_size());
+    return 0;
+}
+
+void leaderboard_free() {
+    LbNode *x = lb_head;
+    while (x) {
+        LbNode *next = x->level[0].next;
+        free(x);
+        x = next;
+    }
+    free(by_id);
+    lb_head = NULL;
+    by_id = NULL;
+    by_id_cap = 0;
+    lb_count = 0;
+    lb_level = 1;
+}
+
+int leaderboard_size() {
+    return lb_count;
+}
+
+// Top 'max_count' players
+int leaderboard_top(LeaderboardEntry *out, int max_count) {
+    return copy_from(1, out, max_count);
+}
+
+// A player's exact rank (1-based) and entry; 0 if they are not ranked
+int leaderboard_rank(int user_id, LeaderboardEntry *out) {
+    LbNode *node = find_user(user_id);
+    if (!node) return 0;
+    int rank = node_rank(node);
+    if (out) fill_entry(out, node, rank);
+    return rank;
+}
+
+// Display name and rating in O(1), for lists that show other players.
+// out->rank is left 0. Returns 0 for unknown users.
+int leaderboard_lookup(int user_id, LeaderboardEntry *out) {
+    LbNode *node = find_user(user_id);
+    if (!node) return 0;
+    fill_entry(out, node, 0);
+    return 1;
+}
+
+// Up to 'radius' players either side of 'user_id', shifted to stay within
+// the table at the top and bottom. Returns the number of entries written.
+int leaderboard_around(int user_id, int radius, LeaderboardEntry *out, int max_count) {
+    int rank = leaderboard_rank(user_id, NULL);
+    if (rank == 0) return 0;
+
+    int window = 2 * radius + 1;
+    if (window > max_count) window = max_count;
+    int first = rank - window / 2;
+    if (first + window - 1 > lb_count) first = lb_count - window + 1;
+    if (first < 1) first = 1;
+    return copy_from(first, out, window);
+}
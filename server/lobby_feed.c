@@ -0,0 +1,107 @@
+/* server/lobby_feed.c - Versioned lobby list deltas for lobby browsers */
+#include <stdio.h>
+#include <string.h>
+#include "server.h"
+#include "../common/packet.h"
+
+// Clients on the lobby browser subscribe with the last version they saw.
+// Every change to a room's LobbySummary bumps the feed version and goes to
+// subscribers as one MSG_LOBBY_DELTA, so churn costs one small packet per
+// subscriber instead of the whole list to everyone. The last LOBBY_FEED_LOG
+// deltas are kept: a subscriber that is at most that far behind is caught up
+// from them, anyone older (or new) gets the list again in chunks.
+// Main loop only.
+
+// Starts at 1: clients take version 0 to mean "no list", so even the empty
+// list a fresh server sends must carry a real version for deltas to apply
+static uint32_t feed_version = 1;
+static LobbyDelta recent[LOBBY_FEED_LOG];   // Version v lives at v % LOBBY_FEED_LOG
+
+static struct {
+    long long deltas;          // Changes published
+    long long delta_packets;   // Sent to subscribers, live or replayed
+    long long resyncs;         // Full lists sent
+    long long resync_packets;
+    long long bytes;
+} feed_stats;
+
+static void send_counted(int socket_fd, ServerPacket *packet) {
+    feed_stats.bytes += server_packet_wire_size(packet);
+    send_response(socket_fd, packet);
+}
+
+static void send_delta(int socket_fd, const LobbyDelta *delta) {
+    ServerPacket packet;
+    memset(&packet, 0, SERVER_PACKET_HEADER_SIZE);
+    packet.type = MSG_LOBBY_DELTA;
+    packet.payload.lobby_delta = *delta;
+    feed_stats.delta_packets++;
+    send_counted(socket_fd, &packet);
+}
+
+// The whole list as of feed_version, LOBBY_LIST_MAX rooms per packet
+static void send_full_list(int socket_fd) {
+    ServerPacket packet;
+    memset(&packet, 0, sizeof(ServerPacket));
+    packet.type = MSG_LOBBY_LIST;
+    packet.payload.lobby_list.version = feed_version;
+
+    int total = lobby_count();
+    int sent = 0;
+    do {
+        int count = 0;
+        while (count < LOBBY_LIST_MAX && sent + count < total) {
+            lobby_summarize(lobby_at(sent + count), &packet.payload.lobby_list.lobbies[count]);
+            count++;
+        }
+        packet.payload.lobby_list.count = count;
+        packet.code = (sent == 0 ? LOBBY_LIST_FIRST : 0) |
+                      (sent + count == total ? LOBBY_LIST_LAST : 0);
+        sent += count;
+        feed_stats.resync_packets++;
+        send_counted(socket_fd, &packet);
+    } while (sent < total);
+    feed_stats.resyncs++;
+}
+
+// A room was added, changed or removed: tell every subscriber
+void lobby_feed_publish(int op, const Lobby *lobby) {
+    LobbyDelta *delta = &recent[++feed_version % LOBBY_FEED_LOG];
+    memset(delta, 0, sizeof(LobbyDelta));
+    delta->version = feed_version;
+    delta->op = op;
+    if (op == LOBBY_DELTA_REMOVE) delta->lobby.id = lobby->id;
+    else lobby_summarize(lobby, &delta->lobby);
+    feed_stats.deltas++;
+
+    for (int i = 0; i < num_clients; i++) {
+        if (clients[i].lobby_feed) send_delta(clients[i].socket_fd, delta);
+    }
+}
+
+// Start sending deltas to 'client', first bringing it up to date from
+// 'known_version' (0 = it has no list)
+void lobby_feed_subscribe(ClientInfo *client, uint32_t known_version) {
+    client->lobby_feed = 1;
+    if (known_version == feed_version && known_version != 0) return;
+
+    uint32_t behind = feed_version - known_version;
+    if (known_version != 0 && known_version < feed_version && behind <= LOBBY_FEED_LOG) {
+        for (uint32_t v = known_version + 1; v <= feed_version; v++) {
+            send_delta(client->socket_fd, &recent[v % LOBBY_FEED_LOG]);
+        }
+        return;
+    }
+    send_full_list(client->socket_fd);
+}
+
+void lobby_feed_unsubscribe(ClientInfo *client) {
+    client->lobby_feed = 0;
+}
+
+void lobby_feed_report() {
+    printf("[LOBBY] Feed at version %u: %lld changes, %lld delta packets, "
+           "%lld full lists (%lld packets), %lld bytes\n",
+           feed_version, feed_stats.deltas, feed_stats.delta_packets,
+           feed_stats.resyncs, feed_stats.resync_packets, feed_stats.bytes);
+}
@@ -1,308 +1,569 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "../common/protocol.h"
-#include "server.h"
-
-Lobby lobbies[MAX_LOBBIES];
-
-void init_lobbies() {
-    for (int i = 0; i < MAX_LOBBIES; i++) {
-        lobbies[i].id = -1;
-        lobbies[i].num_players = 0;
-        lobbies[i].status = LOBBY_WAITING;
-    }
-    printf("[LOBBY] System initialized\n");
-}
-
-Lobby* find_lobby(int lobby_id) {
-    for (int i = 0; i < MAX_LOBBIES; i++) {
-        if (lobbies[i].id == lobby_id) {
-            return &lobbies[i];
-        }
-    }
-    return NULL;
-}
-
-int get_lobby_list(LobbySummary *out_lobbies) {
-    int count = 0;
-    for (int i = 0; i < MAX_LOBBIES; i++) {
-        if (lobbies[i].id != -1) {
-             out_lobbies[count].id = lobbies[i].id;
-             strncpy(out_lobbies[count].name, lobbies[i].name, MAX_ROOM_NAME - 1);
-             out_lobbies[count].name[MAX_ROOM_NAME - 1] = '\0';
-             out_lobbies[count].num_players = lobbies[i].num_players;
-             out_lobbies[count].max_players = MAX_CLIENTS; // or derive from game mode if needed
-             out_lobbies[count].spectator_count = lobbies[i].spectator_count;
-             out_lobbies[count].game_mode = lobbies[i].game_mode;
-             out_lobbies[count].status = lobbies[i].status;
-             out_lobbies[count].is_private = lobbies[i].is_private;
-             out_lobbies[count].is_locked = lobbies[i].is_locked;
-             count++;
-        }
-    }
-    return count;
-}
-
-// Create a new lobby
-int create_lobby(const char *room_name, const char *host_username, int is_private, const char *access_code, int game_mode) {
-    int slot = -1;
-    for (int i = 0; i < MAX_LOBBIES; i++) {
-        if (lobbies[i].id == -1) {
-            slot = i;
-            break;
-        }
-    }
-    
-    if (slot == -1) {
-        printf("[LOBBY] No slots available\n");
-        return -1;
-    }
-    
-    Lobby *lobby = &lobbies[slot];
-    lobby->id = slot;  // Use slot index as ID for consistency
-    strncpy(lobby->name, room_name, MAX_ROOM_NAME - 1);
-    lobby->name[MAX_ROOM_NAME - 1] = '\0';
-    lobby->num_players = 1;
-    lobby->host_id = 0;
-    lobby->host_id = 0;
-    lobby->status = LOBBY_WAITING;
-    lobby->spectator_count = 0; // Initialize spectators
-    lobby->is_private = is_private;
-    lobby->is_locked = 0;
-    lobby->game_mode = game_mode;  // Store game mode selection
-    
-    // Set access code for private rooms
-    if (is_private && access_code) {
-        strncpy(lobby->access_code, access_code, 7);
-        lobby->access_code[7] = '\0';
-    } else {
-        lobby->access_code[0] = '\0';
-    }
-    
-    // Store host username for display
-    strncpy(lobby->host_username, host_username, MAX_USERNAME - 1);
-    lobby->host_username[MAX_USERNAME - 1] = '\0';
-    
-    Player *host = &lobby->players[0];
-    host->id = 0;
-    strncpy(host->username, host_username, MAX_USERNAME - 1);
-    host->username[MAX_USERNAME - 1] = '\0';
-    host->is_ready = 1;
-    host->is_alive = 0;
-    
-    printf("[LOBBY] Created: '%s' (ID:%d, Mode:%d) by %s\n", 
-           room_name, lobby->id, game_mode, host_username);
-    return lobby->id;
-}
-
-// Join an existing lobby with optional access code
-int join_lobby_with_code(int lobby_id, const char *username, const char *access_code) {
-    if (lobby_id < 0 || lobby_id >= MAX_LOBBIES || lobbies[lobby_id].id == -1) return ERR_LOBBY_NOT_FOUND; // Assuming id == -1 means inactive
-    Lobby *lobby = &lobbies[lobby_id];
-    
-    // Check if the lobby is locked
-    if (lobby->is_locked) {
-        printf("[LOBBY] Cannot join lobby %d - room is locked\n", lobby_id);
-        return ERR_LOBBY_LOCKED;  // Error code for locked room
-    }
-    
-    // Check if room is full
-    if (lobby->num_players >= MAX_CLIENTS) return ERR_LOBBY_FULL;
-    
-    // Check if private and code is required
-    if (lobby->is_private) {
-        if (!access_code || strcmp(lobby->access_code, access_code) != 0) {
-            printf("[LOBBY] Invalid access code for private lobby %d\n", lobby_id);
-            return ERR_LOBBY_WRONG_ACCESS_CODE;  // Error code for wrong access code
-        }
-    }
-    
-    // **NEW: Check if user is already in this lobby**
-    for (int i = 0; i < lobby->num_players; i++) {
-        if (strcmp(lobby->players[i].username, username) == 0) {
-            printf("[LOBBY] User %s already in lobby %d - rejecting duplicate join\n", username, lobby_id);
-            return ERR_LOBBY_DUPLICATE_USER;  // Error code for duplicate user
-        }
-    }
-
-    // **NEW: Check if user is spectating this lobby**
-    for (int i = 0; i < lobby->spectator_count; i++) {
-        if (strcmp(lobby->spectators[i], username) == 0) {
-            printf("[LOBBY] User %s is spectating lobby %d - rejecting player join\n", username, lobby_id);
-            return ERR_LOBBY_DUPLICATE_USER;
-        }
-    }
-    
-    // Add player to lobby
-    Player *p = &lobby->players[lobby->num_players];
-    p->id = lobby->num_players; // Assign ID based on index
-    strncpy(p->username, username, MAX_USERNAME - 1);
-    p->username[MAX_USERNAME - 1] = '\0';
-    p->is_ready = 0;
-    p->is_alive = 0; // Initialize is_alive
-    lobby->num_players++;
-    printf("[LOBBY] %s joined lobby %d (%d/%d players)\n", username, lobby_id, lobby->num_players, MAX_CLIENTS);
-    return 0;
-}
-
-// Wrapper for backwards compatibility
-int join_lobby(int lobby_id, const char *username) {
-    return join_lobby_with_code(lobby_id, username, NULL);
-}
-
-int leave_lobby(int lobby_id, const char *username) {
-    Lobby *lobby = find_lobby(lobby_id);
-    if (!lobby) return ERR_LOBBY_NOT_FOUND;
-    
-    int player_idx = -1;
-    for (int i = 0; i < lobby->num_players; i++) {
-        if (strcmp(lobby->players[i].username, username) == 0) {
-            player_idx = i;
-            break;
-        }
-    }
-    
-    if (player_idx == -1) return ERR_LOBBY_NOT_FOUND;
-    
-    // Shift array
-    for (int i = player_idx; i < lobby->num_players - 1; i++) {
-        lobby->players[i] = lobby->players[i + 1];
-        lobby->players[i].id = i;
-    }
-    lobby->num_players--;
-    
-    printf("[LOBBY] %s left lobby %d\n", username, lobby_id);
-    
-    // Transfer host
-    if (player_idx == lobby->host_id && lobby->num_players > 0) {
-        lobby->host_id = 0;
-        lobby->players[0].is_ready = 1;
-        printf("[LOBBY] New host: %s\n", lobby->players[0].username);
-    }
-    
-    // Delete if empty
-    if (lobby->num_players == 0) {
-        lobby->id = -1;
-        printf("[LOBBY] Deleted lobby %d (empty)\n", lobby_id);
-    }
-    
-    return 0;
-}
-
-int toggle_ready(int lobby_id, const char *username) {
-    Lobby *lobby = find_lobby(lobby_id);
-    if (!lobby) return ERR_LOBBY_NOT_FOUND;
-    
-    for (int i = 0; i < lobby->num_players; i++) {
-        if (strcmp(lobby->players[i].username, username) == 0) {
-            if (i != lobby->host_id) {
-                lobby->players[i].is_ready = !lobby->players[i].is_ready;
-                printf("[LOBBY] %s ready: %d\n", 
-                       username, lobby->players[i].is_ready);
-            }
-            return 0;
-        }
-    }
-    return ERR_LOBBY_NOT_FOUND;
-}
-
-int can_start_game(int lobby_id) {
-    Lobby *lobby = find_lobby(lobby_id);
-    if (!lobby) return 0;
-    if (lobby->num_players < 2) return 0;
-    
-    for (int i = 0; i < lobby->num_players; i++) {
-        if (!lobby->players[i].is_ready) return 0;
-    }
-    return 1;
-}
-
-int start_game(int lobby_id, const char *username) {
-    Lobby *lobby = find_lobby(lobby_id);
-    if (!lobby) return ERR_LOBBY_NOT_FOUND;
-    
-    // Check host
-    if (strcmp(lobby->players[lobby->host_id].username, username) != 0) {
-        return ERR_NOT_HOST;
-    }
-    
-    if (!can_start_game(lobby_id)) {
-        return ERR_NOT_ENOUGH_PLAYERS;
-    }
-    
-    lobby->status = LOBBY_PLAYING;
-    printf("[LOBBY] Game started in lobby %d\n", lobby_id);
-    return 0;
-}
-
-
-
-int find_user_lobby(const char *username) {
-    for (int i = 0; i < MAX_LOBBIES; i++) {
-        if (lobbies[i].id == -1) continue;
-        for (int j = 0; j < lobbies[i].num_players; j++) {
-            if (strcmp(lobbies[i].players[j].username, username) == 0) {
-                return lobbies[i].id;
-            }
-        }
-    }
-    return -1;
-}
-
-// Join as spectator
-int join_spectator(int lobby_id, const char *username) {
-    if (lobby_id < 0 || lobby_id >= MAX_LOBBIES || lobbies[lobby_id].id == -1) return ERR_LOBBY_NOT_FOUND;
-    Lobby *lobby = &lobbies[lobby_id];
-    
-    // Check if full
-    if (lobby->spectator_count >= MAX_SPECTATORS) return ERR_LOBBY_FULL;
-    
-    // Check duplications in spectators
-    for (int i = 0; i < lobby->spectator_count; i++) {
-        if (strcmp(lobby->spectators[i], username) == 0) {
-            return ERR_LOBBY_DUPLICATE_USER;
-        }
-    }
-    
-    // Check duplications in players (cannot spectate if playing)
-    for (int i = 0; i < lobby->num_players; i++) {
-        if (strcmp(lobby->players[i].username, username) == 0) {
-            return ERR_LOBBY_DUPLICATE_USER;
-        }
-    }
-    
-    // Add spectator
-    strncpy(lobby->spectators[lobby->spectator_count], username, MAX_USERNAME - 1);
-    lobby->spectators[lobby->spectator_count][MAX_USERNAME - 1] = '\0';
-    lobby->spectator_count++;
-    
-    printf("[LOBBY] %s spectating lobby %d (%d/%d spectators)\n", 
-           username, lobby_id, lobby->spectator_count, MAX_SPECTATORS);
-    return 0;
-}
-
-// Leave spectator mode
-int leave_spectator(int lobby_id, const char *username) {
-    Lobby *lobby = find_lobby(lobby_id);
-    if (!lobby) return ERR_LOBBY_NOT_FOUND;
-    
-    int idx = -1;
-    for (int i = 0; i < lobby->spectator_count; i++) {
-        if (strcmp(lobby->spectators[i], username) == 0) {
-            idx = i;
-            break;
-        }
-    }
-    
-    if (idx == -1) return ERR_LOBBY_NOT_FOUND;
-    
-    // Shift array
-    for (int i = idx; i < lobby->spectator_count - 1; i++) {
-        strncpy(lobby->spectators[i], lobby->spectators[i+1], MAX_USERNAME);
-    }
-    lobby->spectator_count--;
-    
-    printf("[LOBBY] %s stopped spectating lobby %d\n", username, lobby_id);
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../common/protocol.h"
+#include "server.h"
+
+// Lobbies live in individually allocated slots that are never freed or
+// moved, so an ActiveGame handed to a tick task stays put. A lobby id is a
+// handle: slot index in the low LOBBY_SLOT_BITS, the slot's generation above.
+// Freeing a lobby bumps the generation, so an id held by an old client or a
+// late callback stops resolving instead of naming the slot's next occupant.
+// Free slots form a LIFO list; live[] packs the ids in use for iteration.
+// Main loop only.
+typedef struct {
+    Lobby lobby;               // lobby.id == handle while in use, -1 when free
+    ActiveGame game;
+    LobbyChat chat;
+    TickSchedule schedule;
+    int generation;
+    int next_free;             // Free list link (-1 = end)
+    int live_index;            // Position in live[] while in use
+    uint32_t serial;           // Creation order, for sorting
+    int browse_mode;           // Browse bucket (-1 = not filed)
+    int browse_class;
+    int browse_index;          // Position in that bucket
+} LobbySlot;
+
+static LobbySlot **slots = NULL;
+static int num_slots = 0;
+static int slots_cap = 0;
+static int free_head = -1;
+static int *live = NULL;       // Ids in use, in no particular order
+static int num_live = 0;
+static uint32_t next_serial = 0;
+
+// Browse index: rooms bucketed by game mode and by which browse filters they
+// pass, so a query reads only the buckets its filters allow. A bucket is an
+// unordered id array; each slot knows where it sits. Re-filed from
+// lobby_list_changed(), which sees every change to the fields involved.
+#define BROWSE_JOINABLE 1
+#define BROWSE_FREE_SLOTS 2
+#define BROWSE_PUBLIC 4
+#define BROWSE_CLASSES 8
+
+typedef struct {
+    int *ids;
+    int count;
+    int capacity;
+} BrowseBucket;
+
+static BrowseBucket buckets[NUM_GAME_MODES][BROWSE_CLASSES];
+
+static LobbySlot* slot_of(int lobby_id) {
+    if (lobby_id < 0) return NULL;
+    int index = lobby_id & (LOBBY_MAX_SLOTS - 1);
+    if (index >= num_slots || slots[index]->lobby.id != lobby_id) return NULL;
+    return slots[index];
+}
+
+// A cleared slot for a new lobby, or NULL at LOBBY_MAX_SLOTS / out of memory
+static LobbySlot* slot_alloc() {
+    int index = free_head;
+    if (index >= 0) {
+        free_head = slots[index]->next_free;
+    } else {
+        if (num_slots == LOBBY_MAX_SLOTS) return NULL;
+        if (num_slots == slots_cap) {
+            int cap = slots_cap ? slots_cap * 2 : 16;
+            LobbySlot **grown_slots = realloc(slots, cap * sizeof(*grown_slots));
+            if (grown_slots) slots = grown_slots;
+            int *grown_live = realloc(live, cap * sizeof(int));
+            if (grown_live) live = grown_live;
+            if (!grown_slots || !grown_live) return NULL;
+            slots_cap = cap;
+        }
+        LobbySlot *fresh = calloc(1, sizeof(LobbySlot));
+        if (!fresh) return NULL;
+        fresh->lobby.id = -1;
+        index = num_slots;
+        slots[num_slots++] = fresh;
+    }
+
+    LobbySlot *slot = slots[index];
+    int generation = slot->generation % LOBBY_MAX_GENERATION + 1;  // 1.., never 0
+    memset(slot, 0, sizeof(LobbySlot));
+    slot->generation = generation;
+    slot->lobby.id = generation << LOBBY_SLOT_BITS | index;
+    slot->next_free = -1;
+    slot->serial = ++next_serial;
+    slot->browse_mode = -1;
+    slot->live_index = num_live;
+    live[num_live++] = slot->lobby.id;
+    return slot;
+}
+
+static void slot_free(LobbySlot *slot) {
+    int index = slot->lobby.id & (LOBBY_MAX_SLOTS - 1);
+    tick_scheduler_stop(slot->lobby.id);
+    game_wait_idle(&slot->game);  // slot_alloc() clears it for the next lobby
+
+    int last = live[--num_live];
+    live[slot->live_index] = last;
+    slots[last & (LOBBY_MAX_SLOTS - 1)]->live_index = slot->live_index;
+
+    slot->lobby.id = -1;
+    slot->next_free = free_head;
+    free_head = index;
+}
+
+void init_lobbies() {
+    printf("[LOBBY] System initialized (up to %d lobbies)\n", LOBBY_MAX_SLOTS);
+}
+
+void free_lobbies() {
+    for (int m = 0; m < NUM_GAME_MODES; m++) {
+        for (int c = 0; c < BROWSE_CLASSES; c++) free(buckets[m][c].ids);
+    }
+    memset(buckets, 0, sizeof(buckets));
+    for (int i = 0; i < num_slots; i++) free(slots[i]);
+    free(slots);
+    free(live);
+    slots = NULL;
+    live = NULL;
+    num_slots = slots_cap = num_live = 0;
+    free_head = -1;
+}
+
+Lobby* find_lobby(int lobby_id) {
+    LobbySlot *slot = slot_of(lobby_id);
+    return slot ? &slot->lobby : NULL;
+}
+
+ActiveGame* lobby_game(int lobby_id) {
+    LobbySlot *slot = slot_of(lobby_id);
+    return slot ? &slot->game : NULL;
+}
+
+LobbyChat* lobby_chat(int lobby_id) {
+    LobbySlot *slot = slot_of(lobby_id);
+    return slot ? &slot->chat : NULL;
+}
+
+TickSchedule* lobby_schedule(int lobby_id) {
+    LobbySlot *slot = slot_of(lobby_id);
+    return slot ? &slot->schedule : NULL;
+}
+
+// Lobbies in use; lobby_at(0 .. lobby_count() - 1) visits each once, as long
+// as none is created or deleted along the way
+int lobby_count() {
+    return num_live;
+}
+
+Lobby* lobby_at(int index) {
+    return (index >= 0 && index < num_live) ? find_lobby(live[index]) : NULL;
+}
+
+void lobby_summarize(const Lobby *lobby, LobbySummary *out) {
+    out->id = lobby->id;
+    strncpy(out->name, lobby->name, MAX_ROOM_NAME - 1);
+    out->name[MAX_ROOM_NAME - 1] = '\0';
+    out->num_players = lobby->num_players;
+    out->max_players = lobby->max_players;
+    out->spectator_count = lobby->spectator_count;
+    out->game_mode = lobby->game_mode;
+    out->status = lobby->status;
+    out->is_private = lobby->is_private;
+    out->is_locked = lobby->is_locked;
+}
+
+int get_lobby_list(LobbySummary *out_lobbies) {
+    int count = 0;
+    for (int i = 0; i < num_live && count < LOBBY_LIST_MAX; i++) {
+        lobby_summarize(lobby_at(i), &out_lobbies[count++]);
+    }
+    return count;
+}
+
+static int browse_class_of(const Lobby *lobby) {
+    int free_slots = lobby->num_players < lobby->max_players;
+    int class = 0;
+    if (free_slots) class |= BROWSE_FREE_SLOTS;
+    if (free_slots && lobby->status == LOBBY_WAITING && !lobby->is_locked) class |= BROWSE_JOINABLE;
+    if (!lobby->is_private) class |= BROWSE_PUBLIC;
+    return class;
+}
+
+static void browse_unfile(LobbySlot *slot) {
+    if (slot->browse_mode < 0) return;
+    BrowseBucket *bucket = &buckets[slot->browse_mode][slot->browse_class];
+    int last = bucket->ids[--bucket->count];
+    bucket->ids[slot->browse_index] = last;
+    slots[last & (LOBBY_MAX_SLOTS - 1)]->browse_index = slot->browse_index;
+    slot->browse_mode = -1;
+}
+
+// Put the slot in the bucket its lobby belongs in now
+static void browse_file(LobbySlot *slot) {
+    int mode = slot->lobby.game_mode;
+    int class = browse_class_of(&slot->lobby);
+    if (slot->browse_mode == mode && slot->browse_class == class) return;
+    browse_unfile(slot);
+
+    BrowseBucket *bucket = &buckets[mode][class];
+    if (bucket->count == bucket->capacity) {
+        int cap = bucket->capacity ? bucket->capacity * 2 : 16;
+        int *grown = realloc(bucket->ids, cap * sizeof(int));
+        if (!grown) {
+            fprintf(stderr, "[LOBBY] Out of memory filing lobby %d for browsing\n", slot->lobby.id);
+            return;
+        }
+        bucket->ids = grown;
+        bucket->capacity = cap;
+    }
+    slot->browse_mode = mode;
+    slot->browse_class = class;
+    slot->browse_index = bucket->count;
+    bucket->ids[bucket->count++] = slot->lobby.id;
+}
+
+// Every change to a field shown in LobbySummary goes through here
+static void lobby_list_changed(int op, const Lobby *lobby) {
+    LobbySlot *slot = slot_of(lobby->id);
+    if (op == LOBBY_DELTA_REMOVE) browse_unfile(slot);
+    else browse_file(slot);
+    response_cache_invalidate(CACHE_LOBBY_LIST, CACHE_ALL_KEYS);
+    lobby_feed_publish(op, lobby);
+}
+
+// Sort position under LOBBY_SORT_*, ascending and unique: the low half is
+// creation order (newest first), which breaks ties and keeps cursors stable
+static uint64_t browse_key(const LobbySlot *slot, int sort) {
+    const Lobby *lobby = &slot->lobby;
+    uint64_t newest = UINT32_MAX - slot->serial;
+    switch (sort) {
+        case LOBBY_SORT_FULLEST:
+            return (uint64_t)(MAX_ARENA_PLAYERS - lobby->num_players) << 32 | newest;
+        case LOBBY_SORT_MOST_FREE:
+            return (uint64_t)(MAX_ARENA_PLAYERS - (lobby->max_players - lobby->num_players)) << 32 | newest;
+        default:
+            return newest;
+    }
+}
+
+// One page of the rooms passing 'filters' (LOBBY_FILTER_*), ordered by 'sort'
+// (LOBBY_SORT_*). 'cursor' is 0 for the first page, else the next_cursor of
+// the previous one; rooms changing between pages may move across the cut.
+// Only buckets the filters allow are read. Returns the rooms in this page;
+// *total is how many pass the filters, *next_cursor 0 after the last page.
+int lobby_browse(int filters, int game_mode, int sort, uint64_t cursor,
+                 LobbySummary *out, int max_count, int *total, uint64_t *next_cursor) {
+    *total = 0;
+    *next_cursor = 0;
+    if (max_count > LOBBY_LIST_MAX) max_count = LOBBY_LIST_MAX;
+    if (max_count <= 0) return 0;
+
+    int mode_first = 0, mode_last = NUM_GAME_MODES - 1;
+    if (filters & LOBBY_FILTER_MODE) {
+        if (game_mode < 0 || game_mode >= NUM_GAME_MODES) return 0;
+        mode_first = mode_last = game_mode;
+    }
+    int required = 0;
+    if (filters & LOBBY_FILTER_JOINABLE) required |= BROWSE_JOINABLE;
+    if (filters & LOBBY_FILTER_FREE_SLOTS) required |= BROWSE_FREE_SLOTS;
+    if (filters & LOBBY_FILTER_PUBLIC) required |= BROWSE_PUBLIC;
+
+    // Smallest keys at or past the cursor, kept sorted
+    struct { uint64_t key; const LobbySlot *slot; } page[LOBBY_LIST_MAX];
+    int count = 0;
+    int remaining = 0;         // Rooms at or past the cursor
+    for (int m = mode_first; m <= mode_last; m++) {
+        for (int c = 0; c < BROWSE_CLASSES; c++) {
+            if ((c & required) != required) continue;
+            const BrowseBucket *bucket = &buckets[m][c];
+            *total += bucket->count;
+            for (int i = 0; i < bucket->count; i++) {
+                const LobbySlot *slot = slot_of(bucket->ids[i]);
+                uint64_t key = browse_key(slot, sort);
+                if (key < cursor) continue;
+                remaining++;
+                if (count == max_count && key >= page[count - 1].key) continue;
+                if (count < max_count) count++;
+                int k = count - 1;
+                while (k > 0 && page[k - 1].key > key) {
+                    page[k] = page[k - 1];
+                    k--;
+                }
+                page[k].key = key;
+                page[k].slot = slot;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) lobby_summarize(&page[i].slot->lobby, &out[i]);
+    if (remaining > count) *next_cursor = page[count - 1].key + 1;
+    return count;
+}
+
+// For changes made outside this file (a match result landing)
+void lobby_summary_changed(int lobby_id) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (lobby) lobby_list_changed(LOBBY_DELTA_UPDATE, lobby);
+}
+
+// Create a new lobby
+int create_lobby(const char *room_name, const char *host_username, int is_private, const char *access_code, int game_mode, int tick_rate) {
+    LobbySlot *slot = slot_alloc();
+    if (!slot) {
+        printf("[LOBBY] No slots available\n");
+        return -1;
+    }
+    if (game_mode < 0 || game_mode >= NUM_GAME_MODES) game_mode = GAME_MODE_CLASSIC;
+    
+    Lobby *lobby = &slot->lobby;
+    strncpy(lobby->name, room_name, MAX_ROOM_NAME - 1);
+    lobby->name[MAX_ROOM_NAME - 1] = '\0';
+    lobby->num_players = 1;
+    lobby->host_id = 0;
+    lobby->host_id = 0;
+    lobby->status = LOBBY_WAITING;
+    lobby->spectator_count = 0; // Initialize spectators
+    lobby->is_private = is_private;
+    lobby->is_locked = 0;
+    lobby->game_mode = game_mode;  // Store game mode selection
+    lobby->max_players = (game_mode == GAME_MODE_ARENA) ? MAX_ARENA_PLAYERS : MAX_CLIENTS;
+    lobby->tick_rate = tick_scheduler_clamp_rate(tick_rate);
+    
+    // Set access code for private rooms
+    if (is_private && access_code) {
+        strncpy(lobby->access_code, access_code, 7);
+        lobby->access_code[7] = '\0';
+    } else {
+        lobby->access_code[0] = '\0';
+    }
+    
+    // Store host username for display
+    strncpy(lobby->host_username, host_username, MAX_USERNAME - 1);
+    lobby->host_username[MAX_USERNAME - 1] = '\0';
+    
+    Player *host = &lobby->players[0];
+    host->id = 0;
+    strncpy(host->username, host_username, MAX_USERNAME - 1);
+    host->username[MAX_USERNAME - 1] = '\0';
+    host->is_ready = 1;
+    host->is_alive = 0;
+    
+    printf("[LOBBY] Created: '%s' (ID:%d, Mode:%d, %d Hz) by %s\n", 
+           room_name, lobby->id, game_mode, lobby->tick_rate, host_username);
+    lobby_list_changed(LOBBY_DELTA_ADD, lobby);
+    return lobby->id;
+}
+
+// Join an existing lobby with optional access code
+int join_lobby_with_code(int lobby_id, const char *username, const char *access_code) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return ERR_LOBBY_NOT_FOUND;
+    
+    // Check if the lobby is locked
+    if (lobby->is_locked) {
+        printf("[LOBBY] Cannot join lobby %d - room is locked\n", lobby_id);
+        return ERR_LOBBY_LOCKED;  // Error code for locked room
+    }
+    
+    // Check if room is full
+    if (lobby->num_players >= lobby->max_players) return ERR_LOBBY_FULL;
+    
+    // Check if private and code is required
+    if (lobby->is_private) {
+        if (!access_code || strcmp(lobby->access_code, access_code) != 0) {
+            printf("[LOBBY] Invalid access code for private lobby %d\n", lobby_id);
+            return ERR_LOBBY_WRONG_ACCESS_CODE;  // Error code for wrong access code
+        }
+    }
+    
+    // **NEW: Check if user is already in this lobby**
+    for (int i = 0; i < lobby->num_players; i++) {
+        if (strcmp(lobby->players[i].username, username) == 0) {
+            printf("[LOBBY] User %s already in lobby %d - rejecting duplicate join\n", username, lobby_id);
+            return ERR_LOBBY_DUPLICATE_USER;  // Error code for duplicate user
+        }
+    }
+
+    // **NEW: Check if user is spectating this lobby**
+    for (int i = 0; i < lobby->spectator_count; i++) {
+        if (strcmp(lobby->spectators[i], username) == 0) {
+            printf("[LOBBY] User %s is spectating lobby %d - rejecting player join\n", username, lobby_id);
+            return ERR_LOBBY_DUPLICATE_USER;
+        }
+    }
+    
+    // Add player to lobby
+    Player *p = &lobby->players[lobby->num_players];
+    p->id = lobby->num_players; // Assign ID based on index
+    strncpy(p->username, username, MAX_USERNAME - 1);
+    p->username[MAX_USERNAME - 1] = '\0';
+    p->is_ready = 0;
+    p->is_alive = 0; // Initialize is_alive
+    lobby->num_players++;
+    printf("[LOBBY] %s joined lobby %d (%d/%d players)\n", username, lobby_id, lobby->num_players, lobby->max_players);
+    lobby_list_changed(LOBBY_DELTA_UPDATE, lobby);
+    return 0;
+}
+
+// Wrapper for backwards compatibility
+int join_lobby(int lobby_id, const char *username) {
+    return join_lobby_with_code(lobby_id, username, NULL);
+}
+
+int leave_lobby(int lobby_id, const char *username) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return ERR_LOBBY_NOT_FOUND;
+    
+    int player_idx = -1;
+    for (int i = 0; i < lobby->num_players; i++) {
+        if (strcmp(lobby->players[i].username, username) == 0) {
+            player_idx = i;
+            break;
+        }
+    }
+    
+    if (player_idx == -1) return ERR_LOBBY_NOT_FOUND;
+    
+    // Shift array
+    for (int i = player_idx; i < lobby->num_players - 1; i++) {
+        lobby->players[i] = lobby->players[i + 1];
+        lobby->players[i].id = i;
+    }
+    lobby->num_players--;
+    
+    printf("[LOBBY] %s left lobby %d\n", username, lobby_id);
+    
+    // Transfer host
+    if (player_idx == lobby->host_id && lobby->num_players > 0) {
+        lobby->host_id = 0;
+        lobby->players[0].is_ready = 1;
+        printf("[LOBBY] New host: %s\n", lobby->players[0].username);
+    }
+    
+    // Delete if empty
+    if (lobby->num_players == 0) {
+        lobby_list_changed(LOBBY_DELTA_REMOVE, lobby);
+        slot_free(slot_of(lobby_id));
+        printf("[LOBBY] Deleted lobby %d (empty)\n", lobby_id);
+        return 0;
+    }
+    
+    lobby_list_changed(LOBBY_DELTA_UPDATE, lobby);
+    return 0;
+}
+
+int toggle_ready(int lobby_id, const char *username) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return ERR_LOBBY_NOT_FOUND;
+    
+    for (int i = 0; i < lobby->num_players; i++) {
+        if (strcmp(lobby->players[i].username, username) == 0) {
+            if (i != lobby->host_id) {
+                lobby->players[i].is_ready = !lobby->players[i].is_ready;
+                printf("[LOBBY] %s ready: %d\n", 
+                       username, lobby->players[i].is_ready);
+            }
+            return 0;
+        }
+    }
+    return ERR_LOBBY_NOT_FOUND;
+}
+
+int can_start_game(int lobby_id) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return 0;
+    if (lobby->num_players < 2) return 0;
+    
+    for (int i = 0; i < lobby->num_players; i++) {
+        if (!lobby->players[i].is_ready) return 0;
+    }
+    return 1;
+}
+
+int start_game(int lobby_id, const char *username) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return ERR_LOBBY_NOT_FOUND;
+    
+    // Check host
+    if (strcmp(lobby->players[lobby->host_id].username, username) != 0) {
+        return ERR_NOT_HOST;
+    }
+    
+    if (!can_start_game(lobby_id)) {
+        return ERR_NOT_ENOUGH_PLAYERS;
+    }
+    
+    lobby->status = LOBBY_PLAYING;
+    printf("[LOBBY] Game started in lobby %d\n", lobby_id);
+    lobby_list_changed(LOBBY_DELTA_UPDATE, lobby);
+    return 0;
+}
+
+
+
+int find_user_lobby(const char *username) {
+    for (int i = 0; i < num_live; i++) {
+        Lobby *lobby = lobby_at(i);
+        for (int j = 0; j < lobby->num_players; j++) {
+            if (strcmp(lobby->players[j].username, username) == 0) {
+                return lobby->id;
+            }
+        }
+    }
+    return -1;
+}
+
+// Join as spectator
+int join_spectator(int lobby_id, const char *username) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return ERR_LOBBY_NOT_FOUND;
+    
+    // Check if full
+    if (lobby->spectator_count >= MAX_SPECTATORS) return ERR_LOBBY_FULL;
+    
+    // Check duplications in spectators
+    for (int i = 0; i < lobby->spectator_count; i++) {
+        if (strcmp(lobby->spectators[i], username) == 0) {
+            return ERR_LOBBY_DUPLICATE_USER;
+        }
+    }
+    
+    // Check duplications in players (cannot spectate if playing)
+    for (int i = 0; i < lobby->num_players; i++) {
+        if (strcmp(lobby->players[i].username, username) == 0) {
+            return ERR_LOBBY_DUPLICATE_USER;
+        }
+    }
+    
+    // Add spectator
+    strncpy(lobby->spectators[lobby->spectator_count], username, MAX_USERNAME - 1);
+    lobby->spectators[lobby->spectator_count][MAX_USERNAME - 1] = '\0';
+    lobby->spectator_count++;
+    
+    printf("[LOBBY] %s spectating lobby %d (%d/%d spectators)\n", 
+           username, lobby_id, lobby->spectator_count, MAX_SPECTATORS);
+    lobby_list_changed(LOBBY_DELTA_UPDATE, lobby);
+    return 0;
+}
+
+// Leave spectator mode
+int leave_spectator(int lobby_id, const char *username) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return ERR_LOBBY_NOT_FOUND;
+    
+    int idx = -1;
+    for (int i = 0; i < lobby->spectator_count; i++) {
+        if (strcmp(lobby->spectators[i], username) == 0) {
+            idx = i;
+            break;
+        }
+    }
+    
+    if (idx == -1) return ERR_LOBBY_NOT_FOUND;
+    
+    // Shift array
+    for (int i = idx; i < lobby->spectator_count - 1; i++) {
+        strncpy(lobby->spectators[i], lobby->spectators[i+1], MAX_USERNAME);
+    }
+    lobby->spectator_count--;
+    
+    printf("[LOBBY] %s stopped spectating lobby %d\n", username, lobby_id);
+    lobby_list_changed(LOBBY_DELTA_UPDATE, lobby);
+    return 0;
+}
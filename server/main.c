@@ -1,476 +1,721 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <unistd.h>
-#include <sys/socket.h>
-#include <sys/select.h>
-#include <netinet/in.h>
-#include <sys/time.h>
-#include <time.h>
-#include "../common/protocol.h"
-#include <stdarg.h>
-#include "server.h"
-
-// --- Logging Helper ---
-void log_event(const char *category, const char *format, ...) {
-    time_t now;
-    time(&now);
-    char buf[20]; // YYYY-MM-DD HH:MM:SS
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&now));
-    
-    printf("[%s] [%s] ", buf, category);
-    
-    va_list args;
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    
-    printf("\n");
-    fflush(stdout); // Ensure immediate output
-}
-
-// --- Structures & Globals ---
-
-
-ClientInfo clients[MAX_CLIENTS * MAX_LOBBIES];
-int num_clients = 0;
-
-// Chat history storage (server-side only)
-
-
-
-LobbyChat lobby_chats[MAX_LOBBIES];
-
-// Helper function to check if a user is online
-int is_user_online(int user_id) {
-    for (int i = 0; i < num_clients; i++) {
-        if (clients[i].is_authenticated && clients[i].user_id == user_id) {
-            return 1;  // Online
-        }
-    }
-    return 0;  // Offline
-}
-
-GameState active_games[MAX_LOBBIES];
-
-// --- THÊM: Tracking game update timing ---
-long long last_game_update[MAX_LOBBIES];
-
-ClientInfo* find_client_by_socket(int socket_fd) {
-    for (int i = 0; i < num_clients; i++) {
-        if (clients[i].socket_fd == socket_fd) return &clients[i];
-    }
-    return NULL;
-}
-
-void send_response(int socket_fd, ServerPacket *packet) {
-    send(socket_fd, packet, sizeof(ServerPacket), 0);
-}
-
-// Broadcast full lobby list to all authenticated clients
-void broadcast_lobby_list() {
-    ServerPacket packet;
-    packet.type = MSG_LOBBY_LIST;
-    packet.payload.lobby_list.count = get_lobby_list(packet.payload.lobby_list.lobbies);
-
-    for (int i = 0; i < num_clients; i++) {
-        if (clients[i].is_authenticated) {
-            send_response(clients[i].socket_fd, &packet);
-        }
-    }
-}
-
-void broadcast_lobby_update(int lobby_id) {
-    Lobby *lobby = find_lobby(lobby_id);
-    if (!lobby) return;
-    
-    ServerPacket packet;
-    packet.type = MSG_LOBBY_UPDATE;
-    packet.code = 0;
-    packet.payload.lobby = *lobby;
-    
-    for (int i = 0; i < num_clients; i++) {
-        if (clients[i].lobby_id == lobby_id) {
-            send_response(clients[i].socket_fd, &packet);
-        }
-    }
-}
-
-void broadcast_game_state(int lobby_id) {
-    GameState *full_state = &active_games[lobby_id];
-    
-    // Send per-player filtered state in fog of war mode
-    for (int i = 0; i < num_clients; i++) {
-        if (clients[i].lobby_id == lobby_id && clients[i].is_authenticated) {
-            ServerPacket packet;
-            memset(&packet, 0, sizeof(ServerPacket));
-            packet.type = MSG_GAME_STATE;
-            
-            if (full_state->game_mode == GAME_MODE_FOG_OF_WAR) {
-                // Filter state for this specific player
-                GameState filtered_state;
-                filter_game_state(full_state, clients[i].player_id_in_game, &filtered_state);
-                packet.payload.game_state = filtered_state;
-            } else {
-                // Send full state for classic mode
-                packet.payload.game_state = *full_state;
-            }
-            
-            send_response(clients[i].socket_fd, &packet);
-        }
-    }
-}
-
-// --- THÊM: Get current time in milliseconds ---
-long long get_current_time_ms() {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000LL;
-}
-
-// Forfeit Logic moved to handlers/game.c
-
-// Generate a random session token
-void generate_session_token(char *buffer, size_t length) {
-    const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-    if (length > 0) {
-        for (size_t i = 0; i < length - 1; i++) {
-            int key = rand() % (int)(sizeof(charset) - 1);
-            buffer[i] = charset[key];
-        }
-        buffer[length - 1] = '\0';
-    }
-}
-
-// --- Packet Handling ---
-
-void handle_client_packet(int socket_fd, ClientPacket *pkt) {
-    ClientInfo *client = find_client_by_socket(socket_fd);
-    ServerPacket response;
-    memset(&response, 0, sizeof(ServerPacket));
-    
-    if (!client) return;
-
-    // Logic xử lý Game Input (Move, Bomb)
-    // Logic xử lý Game Input (Move, Bomb)
-    if (pkt->type == MSG_MOVE) {
-        handle_game_move(socket_fd, pkt);
-        return;
-    } else if (pkt->type == MSG_PLANT_BOMB) {
-        handle_plant_bomb(socket_fd, pkt);
-        return;
-    }
-
-    // Logic xử lý System Input
-    switch (pkt->type) {
-        case MSG_REGISTER:
-            handle_register(socket_fd, pkt);
-            break;
-            
-        case MSG_LOGIN:
-            handle_login(socket_fd, pkt);
-            break;
-            
-        case MSG_LOGIN_WITH_TOKEN:
-            handle_login_with_token(socket_fd, pkt);
-            break;
-            
-        case MSG_RECONNECT:
-            // Explicit reconnect request (usually used if socket drops mid-game)
-            // Logic similar to Login with Token but might be stricter about existing session
-            break;
-
-        case MSG_CREATE_LOBBY:
-            handle_create_lobby(socket_fd, pkt);
-            break;
-
-        case MSG_SPECTATE:
-            handle_spectate(socket_fd, pkt);
-            break;
-
-        case MSG_JOIN_LOBBY:
-            handle_join_lobby(socket_fd, pkt);
-            break;
-        
-        case MSG_LEAVE_LOBBY:
-            handle_leave_lobby(socket_fd, pkt);
-            break;
-
-        case MSG_LIST_LOBBIES:
-            handle_list_lobbies(socket_fd, pkt);
-            break;
-
-        case MSG_LEAVE_GAME:
-            handle_leave_game(socket_fd, pkt);
-            break;
-
-        case MSG_READY:
-            handle_ready(socket_fd, pkt);
-            break;
-
-        case MSG_START_GAME:
-            handle_start_game(socket_fd, pkt);
-            break;
-            
-        case MSG_FRIEND_REQUEST:
-            handle_friend_request(socket_fd, pkt);
-            break;
-        case MSG_FRIEND_ACCEPT:
-            handle_friend_accept(socket_fd, pkt);
-            break;
-        case MSG_FRIEND_DECLINE:
-            handle_friend_reject(socket_fd, pkt);
-            break;
-        case MSG_FRIEND_REMOVE:
-            handle_friend_remove(socket_fd, pkt);
-            break;
-        case MSG_FRIEND_LIST:
-            handle_friend_list(socket_fd, pkt);
-            break;
-        case MSG_GET_PROFILE:
-            handle_get_profile(socket_fd, pkt);
-            break;
-        case MSG_GET_LEADERBOARD:
-            handle_get_leaderboard(socket_fd, pkt);
-            break;
-        case MSG_FRIEND_INVITE:
-            handle_invite(socket_fd, pkt);
-            break;
-
-        case MSG_CHAT:
-            handle_chat(socket_fd, pkt);
-            break;
-    }
-}
-
-int main() {
-    printf("╔════════════════════════════════════╗\n");
-    printf("║  Bomberman Server v4.0 (SQLite3)  ║\n");
-    printf("║  Game tick rate: 20 Hz (50ms)     ║\n");
-    printf("╚════════════════════════════════════╝\n\n");
-    
-    if (db_init() != 0) {
-        fprintf(stderr, "Failed to initialize database\n");
-        return 1;
-    }
-    
-    srand(time(NULL));
-    init_lobbies();
-    int server_fd = init_server_socket();
-    
-    for (int i = 0; i < MAX_LOBBIES; i++) {
-        last_game_update[i] = 0;
-    }
-    
-    fd_set readfds;
-    struct timeval tv;
-    int max_fd;
-
-    printf("SERVER STARTED on PORT %d\n\n", PORT);
-
-    while (1) {
-        FD_ZERO(&readfds);
-        FD_SET(server_fd, &readfds);
-        max_fd = server_fd;
-
-        for (int i = 0; i < num_clients; i++) {
-            if (clients[i].socket_fd > 0) {
-                FD_SET(clients[i].socket_fd, &readfds);
-                if (clients[i].socket_fd > max_fd) max_fd = clients[i].socket_fd;
-            }
-        }
-
-        // THAY ĐÔI: Giảm timeout để game loop chạy mượt hơn
-        tv.tv_sec = 0;
-        tv.tv_usec = 10000; // 10ms instead of 15ms
-
-        int activity = select(max_fd + 1, &readfds, NULL, NULL, &tv);
-        
-        if (activity < 0) {
-            // Error handling (có thể log nếu cần)
-        }
-
-        // 1. New Connections
-        if (FD_ISSET(server_fd, &readfds)) {
-            struct sockaddr_in addr;
-            socklen_t len = sizeof(addr);
-            int new_sock = accept(server_fd, (struct sockaddr*)&addr, &len);
-            if (new_sock >= 0) {
-                ClientInfo *cl = &clients[num_clients++];
-                cl->socket_fd = new_sock;
-                cl->lobby_id = -1;
-                cl->player_id_in_game = -1;
-                cl->is_authenticated = 0;
-                cl->username[0] = '\0';
-                log_event("CONNECTION", "Client %d connected", new_sock);
-            }
-        }
-
-        // 2. Client Data
-        for (int i = 0; i < num_clients; i++) {
-            int sd = clients[i].socket_fd;
-            if (FD_ISSET(sd, &readfds)) {
-                ClientPacket pkt;
-                int n = recv(sd, &pkt, sizeof(pkt), 0);
-                if (n <= 0) {
-                    // Client disconnected
-                    log_event("DISCONNECT", "Client %d (%s)", sd, 
-                           clients[i].username[0] ? clients[i].username : "unknown");
-
-                    // CHECK: Is this user in an active game?
-                    int handled = 0;
-                    if (clients[i].lobby_id != -1 && clients[i].is_authenticated) {
-                        Lobby *lb = find_lobby(clients[i].lobby_id);
-                        if (lb && lb->status == LOBBY_PLAYING) {
-                            // DO NOT FORFEIT YET! Just close the socket.
-                            // The player object in GameState remains "alive" but un-controlled.
-                            // Ideally, mark them as "DISCONNECTED" in GameState struct if you have a flag, 
-                            // or just let them stand still.
-                            printf("[SESSION] User %s preserved in lobby %d for reconnect.\n", clients[i].username, clients[i].lobby_id);
-                            
-                            // Remove ClientInfo from active socket list, BUT we rely on Database/GameState 
-                            // to persist the "Player". 
-                            // Issue: `clients[]` array is the only link between socket and game.
-                            // If we remove `clients[i]`, we lose the map socket -> player.
-                            // New Logic: When RECONNECT comes in, we scan Active Games to find the player.
-                            handled = 1; 
-                        }
-                    }
-
-                    if (!handled && clients[i].lobby_id != -1) {
-                         // Normal leave (not in game, or game waiting)
-                         leave_lobby(clients[i].lobby_id, clients[i].username);
-                         broadcast_lobby_update(clients[i].lobby_id);
-                         broadcast_lobby_list();
-                    }
-                    
-                    
-                    close(sd);
-                    clients[i] = clients[num_clients-1];
-                    num_clients--;
-                    i--;
-                } else {
-                    handle_client_packet(sd, &pkt);
-                }
-            }
-        }
-
-        // 3. *** CRITICAL: REALTIME GAME LOOP với TIMING CONTROL ***
-        long long now = get_current_time_ms();
-        const long long GAME_TICK_INTERVAL = 50; // 50ms = 20 ticks/second
-        
-        for (int i = 0; i < MAX_LOBBIES; i++) {
-            Lobby *lb = find_lobby(i);
-            if (lb && lb->status == LOBBY_PLAYING) {
-                
-                // KIỂM TRA: Chỉ update khi đủ thời gian
-                if (now - last_game_update[i] >= GAME_TICK_INTERVAL) {
-                    
-                    // Update game logic (bombs, explosions, deaths)
-                    update_game(&active_games[i]);
-                    
-                    // Check if game just ended and calculate ELO BEFORE broadcasting
-                    if (active_games[i].game_status == GAME_ENDED) {
-                        GameState *gs = &active_games[i];
-                        
-                        // Only calculate ELO once (check if not already calculated)
-                        int already_calculated = 0;
-                        for (int p = 0; p < gs->num_players; p++) {
-                            if (gs->elo_changes[p] != 0) {
-                                already_calculated = 1;
-                                break;
-                            }
-                        }
-                        
-                        if (!already_calculated) {
-                            log_event("GAME", "Lobby %d ended. Winner: %d", i, gs->winner_id);
-                            
-                            // Prepare data for stats recording
-                            int player_ids[MAX_CLIENTS];
-                            int placements[MAX_CLIENTS];
-                            int kills[MAX_CLIENTS];
-                            
-                            // Get actual player IDs and populate kills
-                            for (int p = 0; p < gs->num_players; p++) {
-                                // Find user_id by username
-                                int found_user_id = -1;
-                                for (int k = 0; k < num_clients; k++) {
-                                    if (clients[k].is_authenticated && 
-                                        strcmp(clients[k].username, gs->players[p].username) == 0) {
-                                        found_user_id = clients[k].user_id;
-                                        break;
-                                    }
-                                }
-                                
-                                player_ids[p] = found_user_id;
-                                placements[p] = (p == gs->winner_id) ? 1 : 2;
-                                kills[p] = gs->kills[p];
-                                
-                                log_event("ELO", "Player %s (user_id: %d) -> Placement: %d, Kills: %d", 
-                                       gs->players[p].username, player_ids[p], placements[p], kills[p]);
-                            }
-                            
-                            // Update ELO ratings and get changes BEFORE broadcasting
-                            int elo_changes_temp[MAX_CLIENTS] = {0};
-                            if (elo_update_after_match(player_ids, placements, gs->num_players, elo_changes_temp) == 0) {
-                                printf("[ELO] Successfully updated ELO ratings\n");
-                                
-                                // Store ELO changes in game state for client display
-                                printf("[ELO] Storing ELO changes in game state:\n");
-                                for (int p = 0; p < gs->num_players; p++) {
-                                    gs->elo_changes[p] = elo_changes_temp[p];
-                                    printf("[ELO]   Player %d: elo_changes[%d] = %d\n", p, p, gs->elo_changes[p]);
-                                }
-                            } else {
-                                printf("[ELO] ERROR: Failed to update ELO ratings\n");
-                            }
-                            
-                            // Record match statistics with actual duration
-                            int duration_seconds = gs->match_duration_seconds;
-                            int match_id = stats_record_match(player_ids, placements, kills, 
-                                                             gs->num_players, gs->winner_id, 
-                                                             duration_seconds);
-                            
-                            if (match_id >= 0) {
-                                log_event("STATS", "Match recorded with ID: %d (Duration: %d seconds)", 
-                                       match_id, duration_seconds);
-                            } else {
-                                printf("[STATS] ERROR: Failed to record match\n");
-                            }
-                            
-                            // Send notification to players about ELO changes
-                            for (int j = 0; j < num_clients; j++) {
-                                if (clients[j].lobby_id == i && clients[j].is_authenticated) {
-                                    ServerPacket notif;
-                                    memset(&notif, 0, sizeof(ServerPacket));
-                                    notif.type = MSG_NOTIFICATION;
-                                    notif.code = 0;
-                                    
-                                    if (gs->winner_id >= 0 && 
-                                        strcmp(clients[j].username, gs->players[gs->winner_id].username) == 0) {
-                                        sprintf(notif.message, "Victory! ELO updated.");
-                                    } else {
-                                        sprintf(notif.message, "Match ended. ELO updated.");
-                                    }
-                                    
-                                    send_response(clients[j].socket_fd, &notif);
-                                }
-                            }
-                            
-                            lb->status = LOBBY_WAITING;
-                            broadcast_lobby_update(i);
-                        }
-                    }
-                    
-                    // Broadcast state to all players (NOW with ELO changes populated!)
-                    broadcast_game_state(i);
-                    
-                    // Update timer
-                    last_game_update[i] = now;
-                }
-            }
-        }
-    }
-    
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <sys/time.h>
+#include <time.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include "../common/protocol.h"
+#include "../common/packet.h"
+#include <stdarg.h>
+#include "server.h"
+
+// --- Logging Helper ---
+void log_event(const char *category, const char *format, ...) {
+    time_t now;
+    time(&now);
+    char buf[20]; // YYYY-MM-DD HH:MM:SS
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    
+    printf("[%s] [%s] ", buf, category);
+    
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    
+    printf("\n");
+    fflush(stdout); // Ensure immediate output
+}
+
+// --- Structures & Globals ---
+
+
+ClientInfo clients[MAX_CONNECTIONS];
+int num_clients = 0;
+
+// Move a client in or out of a lobby (-1) and tell their friends. Inside a
+// room nobody is browsing, so the lobby feed stops too; entering one replays
+// its chat.
+void client_set_lobby(ClientInfo *client, int lobby_id) {
+    int entered = lobby_id >= 0 && lobby_id != client->lobby_id;
+    client->lobby_id = lobby_id;
+    if (lobby_id >= 0) lobby_feed_unsubscribe(client);
+    if (entered) send_chat_backlog(client);
+    if (client->is_authenticated) {
+        presence_set(client->user_id, client->socket_fd, lobby_id);
+    }
+}
+
+// Worker pool that runs per-lobby ticks (sized to the cores)
+static WorkerPool *tick_pool = NULL;
+static volatile sig_atomic_t shutdown_requested = 0;
+
+static void request_shutdown(int sig) {
+    (void)sig;
+    shutdown_requested = 1;  // select() returns EINTR and the loop exits
+}
+
+ClientInfo* find_client_by_socket(int socket_fd) {
+    for (int i = 0; i < num_clients; i++) {
+        if (clients[i].socket_fd == socket_fd) return &clients[i];
+    }
+    return NULL;
+}
+
+// Only the header and the payload member used by this type go on the wire
+void send_response(int socket_fd, ServerPacket *packet) {
+    send(socket_fd, packet, server_packet_wire_size(packet), 0);
+}
+
+// Lobby list, built at most once per lobby change
+void send_lobby_list(int socket_fd) {
+    if (response_cache_send(socket_fd, CACHE_LOBBY_LIST, 0)) return;
+
+    ServerPacket packet;
+    memset(&packet, 0, sizeof(ServerPacket));
+    packet.type = MSG_LOBBY_LIST;
+    packet.payload.lobby_list.count = get_lobby_list(packet.payload.lobby_list.lobbies);
+    response_cache_store(CACHE_LOBBY_LIST, 0, &packet);
+    send_response(socket_fd, &packet);
+}
+
+static void fill_lobby_update(ServerPacket *packet, const Lobby *lobby) {
+    memset(packet, 0, SERVER_PACKET_HEADER_SIZE);
+    packet->type = MSG_LOBBY_UPDATE;
+    packet->code = lobby->num_players;
+    packet->payload.lobby = *lobby;
+}
+
+void send_lobby_update(int socket_fd, const Lobby *lobby) {
+    ServerPacket packet;
+    fill_lobby_update(&packet, lobby);
+    send_response(socket_fd, &packet);
+}
+
+void broadcast_lobby_update(int lobby_id) {
+    Lobby *lobby = find_lobby(lobby_id);
+    if (!lobby) return;
+    
+    ServerPacket packet;
+    fill_lobby_update(&packet, lobby);
+    
+    for (int i = 0; i < num_clients; i++) {
+        if (clients[i].lobby_id == lobby_id) {
+            send_response(clients[i].socket_fd, &packet);
+        }
+    }
+}
+
+// Send the current game state to one client, as seen from their slot
+void send_game_state(ClientInfo *client, int lobby_id) {
+    ActiveGame *game = lobby_game(lobby_id);
+    if (!game) return;
+    game_wait_idle(game);
+    GameWorld *world = &game->state;
+    ServerPacket packet;
+    memset(&packet, 0, SERVER_PACKET_HEADER_SIZE);
+    packet.type = MSG_GAME_STATE;
+    encode_view(world, client->player_id_in_game, &packet.payload.game_state);
+    
+    send_response(client->socket_fd, &packet);
+}
+
+void broadcast_game_state(int lobby_id) {
+    for (int i = 0; i < num_clients; i++) {
+        if (clients[i].lobby_id == lobby_id && clients[i].is_authenticated) {
+            send_game_state(&clients[i], lobby_id);
+        }
+    }
+}
+
+// --- THÊM: Get current time in milliseconds ---
+long long get_current_time_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000LL;
+}
+
+// Forfeit Logic moved to handlers/game.c
+
+// Generate a random session token (kernel CSPRNG, never the game RNG).
+// Returns -1, with buffer empty, if the CSPRNG failed.
+int generate_session_token(char *buffer, size_t length) {
+    const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    if (secure_random_string(buffer, length, charset, sizeof(charset) - 1) != 0) {
+        log_event("AUTH", "Failed to generate session token");
+        return -1;
+    }
+    return 0;
+}
+
+// A finished match is saved (runs on the main loop, via the DB writer).
+// Players get the final state and their lobby back only now, so the
+// post-match screen shows real rating changes.
+static void on_match_committed(DbJob *job) {
+    DbMatchJob *m = &job->data.match;
+    int i = m->lobby_id;
+    if (job->result == 0) {
+        log_event("STATS", "Match recorded with ID: %d (Duration: %d seconds)", 
+               m->match_id, m->duration_seconds);
+        // Keep the ranked index in step, even if the lobby has moved on
+        for (int p = 0; p < m->num_players; p++) {
+            leaderboard_update(m->player_ids[p], m->rated ? m->new_ratings[p] : -1,
+                               p == m->winner_id);
+            response_cache_invalidate(CACHE_PROFILE, m->player_ids[p]);
+        }
+    } else {
+        printf("[STATS] ERROR: Failed to record match\n");
+    }
+    
+    Lobby *lb = find_lobby(i);
+    ActiveGame *game = lobby_game(i);
+    if (!lb || lb->status != LOBBY_PLAYING || game->state.seed != m->seed) {
+        printf("[ELO] Lobby %d moved on before its results were saved\n", i);
+        return;
+    }
+    GameWorld *gs = &game->state;
+    
+    if (m->rated) {
+        // Store ELO changes in game state for client display
+        // (stats_commit_match() has already logged each player's change)
+        for (int p = 0; p < gs->num_players; p++) {
+            gs->elo_changes[p] = m->elo_changes[p];
+        }
+        log_event("ELO", "Lobby %d: ratings updated", i);
+    } else if (job->result == 0) {
+        // Fewer than two players, or someone without an account: not an error
+        log_event("ELO", "Lobby %d: unrated match, ratings unchanged", i);
+    }
+    
+    // Send notification to players about ELO changes
+    for (int j = 0; j < num_clients; j++) {
+        if (clients[j].lobby_id == i && clients[j].is_authenticated) {
+            ServerPacket notif;
+            memset(&notif, 0, sizeof(ServerPacket));
+            notif.type = MSG_NOTIFICATION;
+            notif.code = 0;
+            
+            if (gs->winner_id >= 0 && 
+                strcmp(clients[j].username, gs->players[gs->winner_id].username) == 0) {
+                sprintf(notif.message, "Victory! ELO updated.");
+            } else {
+                sprintf(notif.message, "Match ended. ELO updated.");
+            }
+            
+            send_response(clients[j].socket_fd, &notif);
+        }
+    }
+    
+    lb->status = LOBBY_WAITING;
+    lobby_summary_changed(i);
+    broadcast_lobby_update(i);
+    // Views were encoded before ELO changes existed; re-encode
+    broadcast_game_state(i);
+}
+
+// Queue the results of a game that just ended (ELO, statistics). The lobby
+// stops ticking now; on_match_committed() finishes up once the write lands.
+static void process_finished_game(int i) {
+    Lobby *lb = find_lobby(i);
+    if (!lb) return;
+    ActiveGame *game = lobby_game(i);
+    GameWorld *gs = &game->state;
+    
+    if (game->results_submitted) return;
+    game->results_submitted = 1;
+    tick_scheduler_stop(i);
+    game_wait_idle(game);  // A tick submitted before this one was drained
+    
+    log_event("GAME", "Lobby %d ended. Winner: %d", i, gs->winner_id);
+    
+    // Prepare data for stats recording
+    DbJob job;
+    memset(&job, 0, sizeof(job));
+    DbMatchJob *m = &job.data.match;
+    m->lobby_id = i;
+    m->seed = gs->seed;
+    m->num_players = gs->num_players;
+    m->winner_id = gs->winner_id;
+    m->duration_seconds = gs->match_duration_seconds;
+    m->game_mode = gs->game_mode;
+    
+    // Get actual player IDs and populate kills
+    for (int p = 0; p < gs->num_players; p++) {
+        // Find user_id by username
+        int found_user_id = -1;
+        for (int k = 0; k < num_clients; k++) {
+            if (clients[k].is_authenticated && 
+                strcmp(clients[k].username, gs->players[p].username) == 0) {
+                found_user_id = clients[k].user_id;
+                break;
+            }
+        }
+        
+        m->player_ids[p] = found_user_id;
+        m->placements[p] = (p == gs->winner_id) ? 1 : 2;
+        m->kills[p] = gs->kills[p];
+        m->bombs_planted[p] = gs->bombs_planted[p];
+        m->walls_destroyed[p] = gs->walls_destroyed[p];
+        
+        log_event("ELO", "Player %s (user_id: %d) -> Placement: %d, Kills: %d", 
+               gs->players[p].username, m->player_ids[p], m->placements[p], m->kills[p]);
+    }
+    
+    // Ratings, history and statistics in one transaction
+    job.type = DB_JOB_MATCH_COMMIT;
+    job.on_done = on_match_committed;
+    db_writer_submit(&job);
+}
+
+// Send the views encoded by a tick task to everyone in the lobby
+static void send_game_snapshot(int lobby_id, GameSnapshot *snap) {
+    static ServerPacket packet;
+    packet.type = MSG_GAME_STATE;
+    packet.code = 0;
+    packet.message[0] = '\0';
+
+    for (int i = 0; i < num_clients; i++) {
+        if (clients[i].lobby_id == lobby_id && clients[i].is_authenticated) {
+            int view = 0;
+            if (snap->per_player_views) {
+                int pid = clients[i].player_id_in_game;
+                view = (pid >= 0 && pid < snap->num_views - 1) ? pid : snap->num_views - 1;
+            }
+            packet.payload.game_state = snap->views[view];
+            send_response(clients[i].socket_fd, &packet);
+        }
+    }
+}
+
+// Power-up feedback for moves applied during the tick
+static void send_tick_notifications(int lobby_id, GameSnapshot *snap) {
+    GameWorld *gs = &lobby_game(lobby_id)->state;
+    for (int p = 0; p < gs->num_players; p++) {
+        if (snap->move_results[p] != 11 && snap->move_results[p] != 12) continue;
+        
+        for (int i = 0; i < num_clients; i++) {
+            if (clients[i].lobby_id == lobby_id && clients[i].is_authenticated &&
+                strcmp(clients[i].username, gs->players[p].username) == 0) {
+                ServerPacket notif;
+                memset(&notif, 0, sizeof(ServerPacket));
+                notif.type = MSG_NOTIFICATION;
+                if (snap->move_results[p] == 11) {
+                    // Picked up power-up
+                    notif.code = 0;
+                    sprintf(notif.message, "Power-up collected!");
+                } else {
+                    // Already at max
+                    notif.code = 1;
+                    sprintf(notif.message, "Already at maximum capacity!");
+                }
+                send_response(clients[i].socket_fd, &notif);
+                break;
+            }
+        }
+    }
+}
+
+// --- Packet Handling ---
+
+void handle_client_packet(int socket_fd, ClientPacket *pkt) {
+    ClientInfo *client = find_client_by_socket(socket_fd);
+    ServerPacket response;
+    memset(&response, 0, sizeof(ServerPacket));
+    
+    if (!client) return;
+
+    // Logic xử lý Game Input (Move, Bomb)
+    // Logic xử lý Game Input (Move, Bomb)
+    if (pkt->type == MSG_MOVE) {
+        handle_game_move(socket_fd, pkt);
+        return;
+    } else if (pkt->type == MSG_PLANT_BOMB) {
+        handle_plant_bomb(socket_fd, pkt);
+        return;
+    }
+
+    // Logic xử lý System Input
+    switch (pkt->type) {
+        case MSG_REGISTER:
+            handle_register(socket_fd, pkt);
+            break;
+            
+        case MSG_LOGIN:
+            handle_login(socket_fd, pkt);
+            break;
+            
+        case MSG_LOGIN_WITH_TOKEN:
+            handle_login_with_token(socket_fd, pkt);
+            break;
+            
+        case MSG_RECONNECT:
+            // Explicit reconnect request (usually used if socket drops mid-game)
+            // Logic similar to Login with Token but might be stricter about existing session
+            break;
+
+        case MSG_CREATE_LOBBY:
+            handle_create_lobby(socket_fd, pkt);
+            break;
+
+        case MSG_SPECTATE:
+            handle_spectate(socket_fd, pkt);
+            break;
+
+        case MSG_JOIN_LOBBY:
+            handle_join_lobby(socket_fd, pkt);
+            break;
+        
+        case MSG_LEAVE_LOBBY:
+            handle_leave_lobby(socket_fd, pkt);
+            break;
+
+        case MSG_LIST_LOBBIES:
+            handle_list_lobbies(socket_fd, pkt);
+            break;
+        case MSG_LOBBY_SUBSCRIBE:
+            handle_lobby_subscribe(socket_fd, pkt);
+            break;
+        case MSG_LOBBY_UNSUBSCRIBE:
+            handle_lobby_unsubscribe(socket_fd, pkt);
+            break;
+        case MSG_BROWSE_LOBBIES:
+            handle_browse_lobbies(socket_fd, pkt);
+            break;
+
+        case MSG_QUEUE_JOIN:
+            handle_queue_join(socket_fd, pkt);
+            break;
+
+        case MSG_QUEUE_LEAVE:
+            handle_queue_leave(socket_fd, pkt);
+            break;
+
+        case MSG_LEAVE_GAME:
+            handle_leave_game(socket_fd, pkt);
+            break;
+
+        case MSG_READY:
+            handle_ready(socket_fd, pkt);
+            break;
+
+        case MSG_START_GAME:
+            handle_start_game(socket_fd, pkt);
+            break;
+            
+        case MSG_FRIEND_REQUEST:
+            handle_friend_request(socket_fd, pkt);
+            break;
+        case MSG_FRIEND_ACCEPT:
+            handle_friend_accept(socket_fd, pkt);
+            break;
+        case MSG_FRIEND_DECLINE:
+            handle_friend_reject(socket_fd, pkt);
+            break;
+        case MSG_FRIEND_REMOVE:
+            handle_friend_remove(socket_fd, pkt);
+            break;
+        case MSG_FRIEND_LIST:
+            handle_friend_list(socket_fd, pkt);
+            break;
+        case MSG_GET_PROFILE:
+            handle_get_profile(socket_fd, pkt);
+            break;
+        case MSG_GET_LEADERBOARD:
+            handle_get_leaderboard(socket_fd, pkt);
+            break;
+        case MSG_GET_MY_RANK:
+            handle_get_my_rank(socket_fd, pkt);
+            break;
+        case MSG_GET_LEADERBOARD_AROUND:
+            handle_get_leaderboard_around(socket_fd, pkt);
+            break;
+        case MSG_GET_MATCH_HISTORY:
+            handle_get_match_history(socket_fd, pkt);
+            break;
+        case MSG_GET_PROFILE_DETAIL:
+            handle_get_profile_detail(socket_fd, pkt);
+            break;
+        case MSG_SEARCH_USERS:
+            handle_search_users(socket_fd, pkt);
+            break;
+        case MSG_FRIEND_INVITE:
+            handle_invite(socket_fd, pkt);
+            break;
+
+        case MSG_CHAT:
+            handle_chat(socket_fd, pkt);
+            break;
+    }
+}
+
+int main(int argc, char **argv) {
+    printf("╔════════════════════════════════════╗\n");
+    printf("║  Bomberman Server v4.0 (SQLite3)  ║\n");
+    printf("║  Default tick rate: %2d Hz         ║\n", DEFAULT_TICK_RATE);
+    printf("╚════════════════════════════════════╝\n\n");
+    
+    if (db_init() != 0) {
+        fprintf(stderr, "Failed to initialize database\n");
+        return 1;
+    }
+    // Maintenance: regenerate the statistics rollups from match history, then exit
+    if (argc > 1 && strcmp(argv[1], "--rebuild-stats") == 0) {
+        int rc = stats_rebuild_rollups();
+        db_close();
+        return rc == 0 ? 0 : 1;
+    }
+    // Maintenance: replay match history through the current ELO rules, then exit
+    if (argc > 1 && strcmp(argv[1], "--recompute-elo") == 0) {
+        int rc = elo_recompute(argc > 2 && strcmp(argv[2], "--dry-run") == 0);
+        db_close();
+        return rc == 0 ? 0 : 1;
+    }
+    if (db_writer_start() != 0) {
+        fprintf(stderr, "Failed to start database writer\n");
+        return 1;
+    }
+    if (auth_pool_start(AUTH_WORKERS) != 0) {
+        fprintf(stderr, "Failed to start auth pool\n");
+        return 1;
+    }
+    if (leaderboard_load() != 0) {
+        fprintf(stderr, "Failed to load leaderboard\n");
+        return 1;
+    }
+    if (friend_graph_load() != 0) {
+        fprintf(stderr, "Failed to load friend graph\n");
+        return 1;
+    }
+    if (session_store_load() != 0) {
+        fprintf(stderr, "Failed to load session tokens\n");
+        return 1;
+    }
+    
+    // A client dropping mid-broadcast must not kill the server; send() then
+    // just fails with EPIPE and the socket is reaped on the next read
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, request_shutdown);
+    signal(SIGTERM, request_shutdown);
+    vis_init();  // Fog of war ray tables, before any tick task can use them
+    init_lobbies();
+    
+    // One helper per core: the main thread submits ticks and goes back to
+    // the network instead of running them
+    tick_pool = worker_pool_create(worker_pool_default_threads());
+    int pipeline_fd = game_pipeline_init();
+    if (!tick_pool || pipeline_fd < 0) {
+        fprintf(stderr, "Failed to start worker pool\n");
+        return 1;
+    }
+    int server_fd = init_server_socket();
+    
+    // Lobby ticks are driven by a timerfd armed for the next deadline
+    int tick_fd = tick_scheduler_init();
+    if (tick_fd < 0) {
+        fprintf(stderr, "Failed to start tick scheduler\n");
+        return 1;
+    }
+    
+    fd_set readfds;
+    int max_fd;
+
+    printf("SERVER STARTED on PORT %d\n\n", PORT);
+
+    while (!shutdown_requested) {
+        FD_ZERO(&readfds);
+        FD_SET(server_fd, &readfds);
+        FD_SET(tick_fd, &readfds);
+        max_fd = (server_fd > tick_fd) ? server_fd : tick_fd;
+        FD_SET(pipeline_fd, &readfds);
+        if (pipeline_fd > max_fd) max_fd = pipeline_fd;
+        int db_fd = db_writer_fd();
+        FD_SET(db_fd, &readfds);
+        if (db_fd > max_fd) max_fd = db_fd;
+        int auth_fd = auth_pool_fd();
+        FD_SET(auth_fd, &readfds);
+        if (auth_fd > max_fd) max_fd = auth_fd;
+
+        for (int i = 0; i < num_clients; i++) {
+            if (clients[i].socket_fd > 0) {
+                FD_SET(clients[i].socket_fd, &readfds);
+                if (clients[i].socket_fd > max_fd) max_fd = clients[i].socket_fd;
+            }
+        }
+
+        // No polling timeout: the timerfd wakes us exactly at the next tick,
+        // and only a waiting quick play queue needs a wake-up of its own
+        tick_scheduler_arm();
+        int mm_timeout = matchmaking_timeout_ms();
+        struct timeval tv = {mm_timeout / 1000, (mm_timeout % 1000) * 1000};
+        int activity = select(max_fd + 1, &readfds, NULL, NULL, mm_timeout >= 0 ? &tv : NULL);
+        
+        if (activity < 0) {
+            // Interrupted (e.g. shutdown signal); fd sets are not valid
+            continue;
+        }
+
+        // 0. Finished database writes (match results, tokens)
+        if (FD_ISSET(db_fd, &readfds)) {
+            db_writer_dispatch();
+        }
+        session_store_sweep();  // No-op until SESSION_SWEEP_SECONDS have passed
+        matchmaking_sweep();    // Widened windows, every MM_SWEEP_MS
+
+        // 0b. Finished password hashes (logins, registrations)
+        if (FD_ISSET(auth_fd, &readfds)) {
+            auth_pool_dispatch();
+        }
+
+        // 1. New Connections
+        if (FD_ISSET(server_fd, &readfds)) {
+            struct sockaddr_in addr;
+            socklen_t len = sizeof(addr);
+            int new_sock = accept(server_fd, (struct sockaddr*)&addr, &len);
+            if (new_sock >= 0 && num_clients >= MAX_CONNECTIONS) {
+                log_event("CONNECTION", "Rejected client %d: %d connections already open",
+                          new_sock, num_clients);
+                close(new_sock);
+            } else if (new_sock >= 0) {
+                ClientInfo *cl = &clients[num_clients++];
+                cl->socket_fd = new_sock;
+                cl->lobby_id = -1;
+                cl->player_id_in_game = -1;
+                cl->is_authenticated = 0;
+                cl->auth_ticket = 0;
+                cl->queue_ticket = -1;
+                cl->lobby_feed = 0;
+                cl->username[0] = '\0';
+                log_event("CONNECTION", "Client %d connected", new_sock);
+            }
+        }
+
+        // 2. Client Data
+        for (int i = 0; i < num_clients; i++) {
+            int sd = clients[i].socket_fd;
+            if (FD_ISSET(sd, &readfds)) {
+                ClientPacket pkt;
+                int n = recv(sd, &pkt, sizeof(pkt), 0);
+                if (n <= 0) {
+                    // Client disconnected
+                    log_event("DISCONNECT", "Client %d (%s)", sd, 
+                           clients[i].username[0] ? clients[i].username : "unknown");
+
+                    // CHECK: Is this user in an active game?
+                    int handled = 0;
+                    if (clients[i].lobby_id != -1 && clients[i].is_authenticated) {
+                        Lobby *lb = find_lobby(clients[i].lobby_id);
+                        if (lb && lb->status == LOBBY_PLAYING) {
+                            // DO NOT FORFEIT YET! Just close the socket.
+                            // The player object in GameState remains "alive" but un-controlled.
+                            // Ideally, mark them as "DISCONNECTED" in GameState struct if you have a flag, 
+                            // or just let them stand still.
+                            printf("[SESSION] User %s preserved in lobby %d for reconnect.\n", clients[i].username, clients[i].lobby_id);
+                            
+                            // Remove ClientInfo from active socket list, BUT we rely on Database/GameState 
+                            // to persist the "Player". 
+                            // Issue: `clients[]` array is the only link between socket and game.
+                            // If we remove `clients[i]`, we lose the map socket -> player.
+                            // New Logic: When RECONNECT comes in, we scan Active Games to find the player.
+                            handled = 1; 
+                        }
+                    }
+
+                    if (!handled && clients[i].lobby_id != -1) {
+                         // Normal leave (not in game, or game waiting)
+                         leave_lobby(clients[i].lobby_id, clients[i].username);
+                         broadcast_lobby_update(clients[i].lobby_id);
+                    }
+                    
+                    
+                    matchmaking_cancel(&clients[i]);
+                    if (clients[i].is_authenticated) {
+                        presence_clear(clients[i].user_id, sd);
+                    }
+                    close(sd);
+                    clients[i] = clients[num_clients-1];
+                    num_clients--;
+                    i--;
+                } else {
+                    handle_client_packet(sd, &pkt);
+                }
+            }
+        }
+
+        // 3. *** CRITICAL: REALTIME GAME LOOP với TIMING CONTROL ***
+        // Every due lobby becomes an independent task on the worker pool.
+        // Each lobby owes a whole number of fixed steps (capped after a stall).
+        // A lobby whose previous tick is still running keeps its steps for
+        // the next pass instead of this thread waiting for it.
+        long long now = get_current_time_ms();
+        TickDue *due;
+        int num_due = tick_scheduler_collect(now, &due);
+        
+        for (int d = 0; d < num_due; d++) {
+            int i = due[d].lobby_id;
+            Lobby *lb = find_lobby(i);
+            if (!lb || lb->status != LOBBY_PLAYING) {
+                // Game ended or lobby vanished without going through the tick path
+                tick_scheduler_stop(i);
+                continue;
+            }
+            ActiveGame *game = lobby_game(i);
+            game->steps_owed += due[d].steps;
+            if (atomic_load_explicit(&game->tick_running, memory_order_acquire)) continue;
+            
+            game->steps_due = game->steps_owed;
+            if (game->steps_due > MAX_CATCHUP_TICKS) {
+                tick_scheduler_skip(i, game->steps_due - MAX_CATCHUP_TICKS);
+                game->steps_due = MAX_CATCHUP_TICKS;
+            }
+            game->steps_owed = 0;
+            atomic_store_explicit(&game->tick_running, 1, memory_order_relaxed);
+            worker_pool_submit(tick_pool, run_game_tick, game);
+        }
+        
+        // 4. Views published by finished tick tasks. Walk backwards: a match
+        // ending here stops its lobby, which moves the last id into its place.
+        if (FD_ISSET(pipeline_fd, &readfds)) {
+            game_pipeline_drain_fd();
+        }
+        const int *running;
+        for (int r = tick_scheduler_running(&running) - 1; r >= 0; r--) {
+            int i = running[r];
+            ActiveGame *game = lobby_game(i);
+            if (!game) continue;
+            GameSnapshot *snap;
+            while ((snap = game_peek_snapshot(game)) != NULL) {
+                send_tick_notifications(i, snap);
+                
+                // The final state goes out with ELO changes, once the writer has them
+                if (snap->views[0].game_status == GAME_ENDED) {
+                    process_finished_game(i);
+                } else {
+                    send_game_snapshot(i, snap);
+                }
+                game_release_snapshot(game);
+            }
+        }
+    }
+    
+    printf("\nShutting down...\n");
+    worker_pool_destroy(tick_pool);
+    auth_pool_stop();
+    db_writer_stop();  // Drains queued writes first
+    db_close();  // Logs per-statement stats
+    response_cache_report();
+    response_cache_free();
+    matchmaking_report();
+    lobby_feed_report();
+    friend_graph_free();
+    leaderboard_free();
+    name_index_free();
+    tick_scheduler_free();
+    free_lobbies();
+    session_store_free();
+    return 0;
+}
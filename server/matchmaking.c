@@ -0,0 +1,373 @@
+/* server/matchmaking.c - Quick play queue: rating buckets per game mode */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../common/protocol.h"
+#include "server.h"
+
+// Each game mode keeps its waiting players in MM_NUM_BUCKETS FIFO lists by
+// rating, plus a Fenwick tree of bucket sizes. Joining is an O(1) list append
+// and an O(log buckets) tree update; the tree then says in O(log buckets)
+// whether enough players sit inside the joiner's window before any list is
+// walked. A match is gathered outwards from the anchor's bucket, oldest
+// first, so the closest ratings that have waited longest go together.
+//
+// Windows grow with waiting time, so every MM_SWEEP_MS the sweep retries
+// each mode's waiting players from the oldest. Main loop only.
+typedef struct {
+    int socket_fd;
+    int user_id;
+    int rating;
+    int game_mode;
+    int bucket;
+    long long enqueued_ms;
+    unsigned int seq;          // Enqueue order; unlike enqueued_ms, never tied
+    int prev, next;            // Bucket list; next doubles as the free list
+    int older, newer;          // Age list, across buckets
+    int in_use;
+} Ticket;
+
+typedef struct {
+    int head[MM_NUM_BUCKETS], tail[MM_NUM_BUCKETS];
+    int fenwick[MM_NUM_BUCKETS + 1];
+    int oldest, newest;
+    int size;
+
+    int waits_ms[MM_WAIT_SAMPLES];  // Ring of recent queue times
+    int num_waits;
+    int matches;
+    int players_matched;
+} ModeQueue;
+
+static Ticket tickets[MAX_CONNECTIONS];  // One per connection at most
+static int free_ticket = -1;
+static unsigned int next_seq = 0;
+static int initialized = 0;
+static ModeQueue queues[NUM_GAME_MODES];
+static long long last_sweep = 0;
+static long long last_report = 0;
+static int matches_since_report = 0;
+
+static void init_queues() {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        tickets[i].in_use = 0;
+        tickets[i].next = i + 1 < MAX_CONNECTIONS ? i + 1 : -1;
+    }
+    free_ticket = 0;
+    for (int m = 0; m < NUM_GAME_MODES; m++) {
+        ModeQueue *q = &queues[m];
+        memset(q, 0, sizeof(*q));
+        for (int b = 0; b < MM_NUM_BUCKETS; b++) q->head[b] = q->tail[b] = -1;
+        q->oldest = q->newest = -1;
+    }
+    last_sweep = last_report = get_current_time_ms();
+    initialized = 1;
+}
+
+// Quick play makes 2-4 player rooms; arenas need far more players
+static int mode_queued(int game_mode) {
+    return game_mode >= 0 && game_mode < NUM_GAME_MODES && game_mode != GAME_MODE_ARENA;
+}
+
+static int bucket_of(int rating) {
+    if (rating < 0) return 0;
+    int b = rating / MM_BUCKET_WIDTH;
+    return b < MM_NUM_BUCKETS ? b : MM_NUM_BUCKETS - 1;
+}
+
+// --- Fenwick tree over bucket sizes ---
+
+static void fenwick_add(ModeQueue *q, int bucket, int delta) {
+    for (int i = bucket + 1; i <= MM_NUM_BUCKETS; i += i & -i) q->fenwick[i] += delta;
+}
+
+// Players in buckets [0, bucket]
+static int fenwick_prefix(const ModeQueue *q, int bucket) {
+    int sum = 0;
+    for (int i = bucket + 1; i > 0; i -= i & -i) sum += q->fenwick[i];
+    return sum;
+}
+
+static int count_between(const ModeQueue *q, int lo_bucket, int hi_bucket) {
+    return fenwick_prefix(q, hi_bucket) - (lo_bucket > 0 ? fenwick_prefix(q, lo_bucket - 1) : 0);
+}
+
+// --- Tickets ---
+
+static int window_for(long long wait_ms) {
+    long long window = MM_BASE_WINDOW + MM_WIDEN_PER_SECOND * (wait_ms / 1000);
+    return window < MM_MAX_WINDOW ? (int)window : MM_MAX_WINDOW;
+}
+
+static int players_wanted(long long wait_ms) {
+    int wanted = MAX_CLIENTS - (int)(wait_ms / (MM_SHRINK_SECONDS * 1000LL));
+    return wanted > 2 ? wanted : 2;
+}
+
+static void link_ticket(ModeQueue *q, int t) {
+    Ticket *tk = &tickets[t];
+    tk->prev = q->tail[tk->bucket];
+    tk->next = -1;
+    if (tk->prev >= 0) tickets[tk->prev].next = t;
+    else q->head[tk->bucket] = t;
+    q->tail[tk->bucket] = t;
+
+    tk->older = q->newest;
+    tk->newer = -1;
+    if (tk->older >= 0) tickets[tk->older].newer = t;
+    else q->oldest = t;
+    q->newest = t;
+
+    fenwick_add(q, tk->bucket, 1);
+    q->size++;
+}
+
+static void unlink_ticket(ModeQueue *q, int t) {
+    Ticket *tk = &tickets[t];
+    if (tk->prev >= 0) tickets[tk->prev].next = tk->next;
+    else q->head[tk->bucket] = tk->next;
+    if (tk->next >= 0) tickets[tk->next].prev = tk->prev;
+    else q->tail[tk->bucket] = tk->prev;
+
+    if (tk->older >= 0) tickets[tk->older].newer = tk->newer;
+    else q->oldest = tk->newer;
+    if (tk->newer >= 0) tickets[tk->newer].older = tk->older;
+    else q->newest = tk->older;
+
+    fenwick_add(q, tk->bucket, -1);
+    q->size--;
+
+    tk->in_use = 0;
+    tk->next = free_ticket;
+    free_ticket = t;
+}
+
+// --- Queue times ---
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// p50/p90/p99 of the recent queue times; returns how many samples there were
+static int wait_percentiles(const ModeQueue *q, int *p50, int *p90, int *p99) {
+    int n = q->num_waits < MM_WAIT_SAMPLES ? q->num_waits : MM_WAIT_SAMPLES;
+    if (n == 0) return 0;
+    int sorted[MM_WAIT_SAMPLES];
+    memcpy(sorted, q->waits_ms, n * sizeof(int));
+    qsort(sorted, n, sizeof(int), cmp_int);
+    *p50 = sorted[n / 2];
+    *p90 = sorted[(n * 90) / 100];
+    *p99 = sorted[(n * 99) / 100];
+    return n;
+}
+
+static void send_status(ClientInfo *client, int code, const Ticket *tk, long long now, int lobby_id,
+                        const char *message) {
+    ServerPacket packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.type = MSG_QUEUE_STATUS;
+    packet.code = code;
+    if (message) snprintf(packet.message, sizeof(packet.message), "%s", message);
+
+    QueueStatus *st = &packet.payload.queue_status;
+    st->lobby_id = lobby_id;
+    st->expected_wait_ms = -1;
+    if (tk) {
+        const ModeQueue *q = &queues[tk->game_mode];
+        int p50, p90, p99;
+        st->game_mode = tk->game_mode;
+        st->rating = tk->rating;
+        st->wait_ms = (int)(now - tk->enqueued_ms);
+        st->window = window_for(now - tk->enqueued_ms);
+        st->queue_size = q->size;
+        if (wait_percentiles(q, &p50, &p90, &p99) > 0) st->expected_wait_ms = p50;
+    }
+    send_response(client->socket_fd, &packet);
+}
+
+// --- Matching ---
+
+// Put the gathered tickets into a fresh room, the longest waiting as host.
+// Returns the lobby id, or -1 if no room could be made (they stay queued).
+static int form_match(ModeQueue *q, const int *picked, int n, long long now) {
+    // picked[0] is the anchor, which on enqueue is the newest ticket
+    int h = 0;
+    for (int i = 1; i < n; i++) {
+        if (tickets[picked[i]].seq < tickets[picked[h]].seq) h = i;
+    }
+    const Ticket *host = &tickets[picked[h]];
+    ClientInfo *host_client = find_client_by_socket(host->socket_fd);
+    if (!host_client) return -1;
+
+    char room_name[MAX_ROOM_NAME];
+    snprintf(room_name, sizeof(room_name), "Quick Play ~%d", host->rating);
+    int lobby_id = create_lobby(room_name, host_client->username, 0, NULL, host->game_mode, 0);
+    if (lobby_id < 0) return -1;
+
+    for (int i = 0; i < n; i++) {
+        Ticket *tk = &tickets[picked[i]];
+        ClientInfo *client = find_client_by_socket(tk->socket_fd);
+        if (!client) continue;
+        client->queue_ticket = -1;
+        if (i != h && join_lobby(lobby_id, client->username) != 0) {
+            // Same account queued from two connections
+            send_status(client, QUEUE_LEFT, tk, now, -1, "Could not join the match");
+            continue;
+        }
+        client_set_lobby(client, lobby_id);
+
+        int wait_ms = (int)(now - tk->enqueued_ms);
+        q->waits_ms[q->num_waits++ % MM_WAIT_SAMPLES] = wait_ms;
+        send_status(client, QUEUE_MATCHED, tk, now, lobby_id, NULL);
+    }
+
+    // Everyone asked to play: the host can start right away
+    Lobby *lobby = find_lobby(lobby_id);
+    for (int i = 0; i < lobby->num_players; i++) lobby->players[i].is_ready = 1;
+
+    log_event("MATCH", "Quick play: %d players into lobby %d (mode %d, ratings around %d)",
+              lobby->num_players, lobby_id, host->game_mode, host->rating);
+    for (int i = 0; i < n; i++) unlink_ticket(q, picked[i]);
+    q->matches++;
+    q->players_matched += n;
+    matches_since_report++;
+
+    broadcast_lobby_update(lobby_id);
+    return lobby_id;
+}
+
+// Try to build a match around ticket 'anchor' with its current window.
+// Returns 1 if one was formed, 0 if not enough players, -1 if no room free.
+static int try_match(ModeQueue *q, int anchor, long long now) {
+    const Ticket *a = &tickets[anchor];
+    long long wait_ms = now - a->enqueued_ms;
+    int window = window_for(wait_ms);
+    int wanted = players_wanted(wait_ms);
+
+    int lo = bucket_of(a->rating - window), hi = bucket_of(a->rating + window);
+    if (count_between(q, lo, hi) < wanted) return 0;
+
+    // Buckets nearest the anchor first; oldest first within a bucket
+    int picked[MAX_CLIENTS];
+    int n = 0;
+    picked[n++] = anchor;
+    for (int d = 0; n < wanted && (a->bucket - d >= lo || a->bucket + d <= hi); d++) {
+        for (int side = 0; side < 2 && n < wanted; side++) {
+            int b = side == 0 ? a->bucket - d : a->bucket + d;
+            if (b < lo || b > hi || (side == 1 && d == 0)) continue;
+            for (int t = q->head[b]; t >= 0 && n < wanted; t = tickets[t].next) {
+                if (t != anchor && abs(tickets[t].rating - a->rating) <= window) picked[n++] = t;
+            }
+        }
+    }
+    if (n < wanted) return 0;
+    return form_match(q, picked, n, now) >= 0 ? 1 : -1;
+}
+
+// --- Public API ---
+
+// Queue an authenticated client outside any room. Answers with
+// MSG_QUEUE_STATUS (waiting, matched or rejected); returns 0 if queued or matched.
+int matchmaking_enqueue(ClientInfo *client, int game_mode) {
+    if (!initialized) init_queues();
+    long long now = get_current_time_ms();
+
+    const char *reject = NULL;
+    if (!mode_queued(game_mode)) reject = "Quick play is not available for this mode";
+    else if (client->lobby_id != -1) reject = "Leave your room first";
+    else if (client->queue_ticket >= 0) reject = "Already in the queue";
+    else if (free_ticket < 0) reject = "Queue is full";
+    if (reject) {
+        send_status(client, QUEUE_REJECTED, NULL, now, -1, reject);
+        return -1;
+    }
+
+    LeaderboardEntry entry;
+    int rating = leaderboard_lookup(client->user_id, &entry) ? entry.elo_rating : 1200;
+
+    int t = free_ticket;
+    Ticket *tk = &tickets[t];
+    free_ticket = tk->next;
+    memset(tk, 0, sizeof(*tk));
+    tk->in_use = 1;
+    tk->socket_fd = client->socket_fd;
+    tk->user_id = client->user_id;
+    tk->rating = rating;
+    tk->game_mode = game_mode;
+    tk->bucket = bucket_of(rating);
+    tk->enqueued_ms = now;
+    tk->seq = ++next_seq;
+    client->queue_ticket = t;
+
+    ModeQueue *q = &queues[game_mode];
+    link_ticket(q, t);
+    if (try_match(q, t, now) != 1) {
+        send_status(client, QUEUE_WAITING, tk, now, -1, NULL);
+    }
+    return 0;
+}
+
+// Drop a client's ticket (left the queue, joined a room or disconnected)
+void matchmaking_cancel(ClientInfo *client) {
+    int t = client->queue_ticket;
+    if (t < 0) return;
+    client->queue_ticket = -1;
+    if (t >= MAX_CONNECTIONS || !tickets[t].in_use || tickets[t].socket_fd != client->socket_fd) return;
+    unlink_ticket(&queues[tickets[t].game_mode], t);
+}
+
+// Retry everyone whose window has grown since they joined. Cheap to call on
+// every loop iteration: it only runs every MM_SWEEP_MS.
+void matchmaking_sweep() {
+    if (!initialized) return;
+    long long now = get_current_time_ms();
+    if (now - last_sweep < MM_SWEEP_MS) return;
+    last_sweep = now;
+
+    for (int m = 0; m < NUM_GAME_MODES; m++) {
+        ModeQueue *q = &queues[m];
+        int t = q->oldest;
+        while (t >= 0) {
+            int result = try_match(q, t, now);
+            if (result < 0) break;           // No room free; try again next sweep
+            t = result == 1 ? q->oldest : tickets[t].newer;  // A match may remove any ticket
+        }
+    }
+
+    if (matches_since_report > 0 && now - last_report >= MM_REPORT_SECONDS * 1000LL) {
+        matchmaking_report();
+    }
+}
+
+// Milliseconds until the next sweep is due, or -1 while nobody is waiting.
+// The main loop bounds select() by this so windows widen on an idle server.
+int matchmaking_timeout_ms() {
+    if (!initialized) return -1;
+    int waiting = 0;
+    for (int m = 0; m < NUM_GAME_MODES; m++) waiting += queues[m].size;
+    if (waiting == 0) return -1;
+    long long left = last_sweep + MM_SWEEP_MS - get_current_time_ms();
+    return left > 0 ? (int)left : 0;
+}
+
+// Log queue-time percentiles per mode
+void matchmaking_report() {
+    if (!initialized) return;
+    for (int m = 0; m < NUM_GAME_MODES; m++) {
+        ModeQueue *q = &queues[m];
+        int p50, p90, p99;
+        int n = wait_percentiles(q, &p50, &p90, &p99);
+        if (n == 0 && q->size == 0) continue;
+        if (n == 0) {
+            log_event("MATCH", "Mode %d: %d waiting, no matches yet", m, q->size);
+            continue;
+        }
+        log_event("MATCH", "Mode %d: %d matches, %d players, %d waiting; queue time over last %d: "
+                  "p50 %.1f s, p90 %.1f s, p99 %.1f s",
+                  m, q->matches, q->players_matched, q->size, n,
+                  p50 / 1000.0, p90 / 1000.0, p99 / 1000.0);
+    }
+    last_report = get_current_time_ms();
+    matches_since_report = 0;
+}
@@ -0,0 +1,297 @@
+/* server/name_index.c - Display name search: sorted keys plus trigram postings */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "server.h"
+
+// Names are matched case-insensitively on a lowercased key per user.
+//
+// Prefix: user ids sorted by key. A query is one binary search, then a walk
+// while keys still start with it; results come out alphabetically, so an
+// exact match is always first.
+//
+// Fuzzy: every key is split into trigrams, padded so the start and end of the
+// name count ("  a", " ab", "abc", ..., "yz "). Each trigram hashes to a
+// posting list of user ids. A query (not padded at the end: it may be a
+// partial word) bumps a counter for every id on its trigrams' lists, and ids
+// sharing enough of them are scored exactly: the share of the query's
+// trigrams the name contains, ties going to the closer overall match
+// (Jaccard). That catches typos and infixes ("bomb" -> "TheBomber") without
+// scanning every name.
+//
+// Kept in step from leaderboard_set(): load, registration and rename.
+// Main loop only.
+#define NGRAM_BUCKETS 65536        // Power of two
+#define NGRAM_MAX (MAX_DISPLAY_NAME + 1)
+#define FUZZY_MIN_QUERY 3          // Shorter queries are prefix-only
+#define FUZZY_MIN_COVERAGE 0.4
+
+typedef struct {
+    int *ids;
+    int count;
+    int capacity;
+} Posting;
+
+static char (*keys)[MAX_DISPLAY_NAME] = NULL;  // By user id; "" = not indexed
+static int keys_cap = 0;
+
+static int *sorted = NULL;         // User ids in key order
+static int sorted_count = 0;
+static int sorted_cap = 0;
+
+static Posting postings[NGRAM_BUCKETS];
+
+// Per-query scratch, by user id: hits[] is valid where stamp[] == generation
+static int *hits = NULL;
+static unsigned int *stamp = NULL;
+static unsigned int generation = 0;
+
+static void make_key(const char *name, char *key) {
+    int i = 0;
+    for (; name[i] && i < MAX_DISPLAY_NAME - 1; i++) key[i] = (char)tolower((unsigned char)name[i]);
+    key[i] = '\0';
+}
+
+static int cmp_uint(const void *a, const void *b) {
+    unsigned int x = *(const unsigned int *)a, y = *(const unsigned int *)b;
+    return (x > y) - (x < y);
+}
+
+// Distinct trigrams of 'key' as 24-bit codes, sorted. Returns how many.
+static int trigrams(const char *key, int pad_end, unsigned int *out) {
+    char padded[MAX_DISPLAY_NAME + 3];
+    int len = snprintf(padded, sizeof(padded), pad_end ? "  %s " : "  %s", key);
+    int n = 0;
+    for (int i = 0; i + 3 <= len; i++) {
+        unsigned int g = (unsigned char)padded[i] << 16 | (unsigned char)padded[i + 1] << 8 |
+                         (unsigned char)padded[i + 2];
+        out[n++] = g;
+    }
+    qsort(out, n, sizeof(unsigned int), cmp_uint);
+    int distinct = 0;
+    for (int i = 0; i < n; i++) {
+        if (distinct == 0 || out[distinct - 1] != out[i]) out[distinct++] = out[i];
+    }
+    return distinct;
+}
+
+static Posting* posting_of(unsigned int gram) {
+    return &postings[(gram * 2654435761u) >> 16 & (NGRAM_BUCKETS - 1)];
+}
+
+static int posting_add(Posting *p, int id) {
+    if (p->count == p->capacity) {
+        int cap = p->capacity ? p->capacity * 2 : 4;
+        int *grown = realloc(p->ids, cap * sizeof(int));
+        if (!grown) return -1;
+        p->ids = grown;
+        p->capacity = cap;
+    }
+    p->ids[p->count++] = id;
+    return 0;
+}
+
+static void posting_remove(Posting *p, int id) {
+    for (int i = 0; i < p->count; i++) {
+        if (p->ids[i] == id) {
+            p->ids[i] = p->ids[--p->count];  // Order does not matter
+            return;
+        }
+    }
+}
+
+// Key order, ties by user id
+static int key_before(int a, int b) {
+    int c = strcmp(keys[a], keys[b]);
+    return c != 0 ? c < 0 : a < b;
+}
+
+static int sorted_position(int user_id) {
+    int lo = 0, hi = sorted_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (key_before(sorted[mid], user_id)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int grow_users(int user_id) {
+    int cap = keys_cap ? keys_cap : 1024;
+    while (cap <= user_id) cap *= 2;
+    char (*grown_keys)[MAX_DISPLAY_NAME] = realloc(keys, cap * sizeof(*keys));
+    if (grown_keys) keys = grown_keys;
+    int *grown_hits = realloc(hits, cap * sizeof(int));
+    if (grown_hits) hits = grown_hits;
+    unsigned int *grown_stamp = realloc(stamp, cap * sizeof(unsigned int));
+    if (grown_stamp) stamp = grown_stamp;
+    if (!grown_keys || !grown_hits || !grown_stamp) return -1;
+
+    memset(keys + keys_cap, 0, (cap - keys_cap) * sizeof(*keys));
+    memset(stamp + keys_cap, 0, (cap - keys_cap) * sizeof(unsigned int));
+    keys_cap = cap;
+    return 0;
+}
+
+static void unindex(int user_id) {
+    unsigned int grams[NGRAM_MAX];
+    int n = trigrams(keys[user_id], 1, grams);
+    for (int i = 0; i < n; i++) posting_remove(posting_of(grams[i]), user_id);
+
+    int pos = sorted_position(user_id);
+    if (pos < sorted_count && sorted[pos] == user_id) {
+        memmove(&sorted[pos], &sorted[pos + 1], (sorted_count - pos - 1) * sizeof(int));
+        sorted_count--;
+    }
+    keys[user_id][0] = '\0';
+}
+
+// Index a user under 'display_name', replacing any earlier name
+void name_index_set(int user_id, const char *display_name) {
+    if (user_id <= 0 || !display_name) return;
+    if (user_id >= keys_cap && grow_users(user_id) != 0) {
+        fprintf(stderr, "[SEARCH] Out of memory growing name index\n");
+        return;
+    }
+
+    char key[MAX_DISPLAY_NAME];
+    make_key(display_name, key);
+    if (strcmp(keys[user_id], key) == 0) return;
+    if (keys[user_id][0]) unindex(user_id);
+    if (!key[0]) return;
+
+    if (sorted_count == sorted_cap) {
+        int cap = sorted_cap ? sorted_cap * 2 : 1024;
+        int *grown = realloc(sorted, cap * sizeof(int));
+        if (!grown) return;
+        sorted = grown;
+        sorted_cap = cap;
+    }
+    strcpy(keys[user_id], key);
+    int pos = sorted_position(user_id);
+    memmove(&sorted[pos + 1], &sorted[pos], (sorted_count - pos) * sizeof(int));
+    sorted[pos] = user_id;
+    sorted_count++;
+
+    unsigned int grams[NGRAM_MAX];
+    int n = trigrams(key, 1, grams);
+    for (int i = 0; i < n; i++) posting_add(posting_of(grams[i]), user_id);
+}
+
+void name_index_free() {
+    for (int i = 0; i < NGRAM_BUCKETS; i++) free(postings[i].ids);
+    memset(postings, 0, sizeof(postings));
+    free(keys);
+    free(sorted);
+    free(hits);
+    free(stamp);
+    keys = NULL;
+    sorted = NULL;
+    hits = NULL;
+    stamp = NULL;
+    keys_cap = sorted_count = sorted_cap = 0;
+}
+
+typedef struct {
+    int user_id;
+    double coverage;           // Share of the query's trigrams in the name
+    double similarity;         // Jaccard of both trigram sets
+} FuzzyHit;
+
+// Best first
+static int cmp_fuzzy(const FuzzyHit *x, const FuzzyHit *y) {
+    if (x->coverage != y->coverage) return x->coverage < y->coverage ? 1 : -1;
+    if (x->similarity != y->similarity) return x->similarity < y->similarity ? 1 : -1;
+    return (x->user_id > y->user_id) - (x->user_id < y->user_id);
+}
+
+// Up to 'max_count' matches for 'query': the exact name, then prefix matches
+// alphabetically, then fuzzy matches by similarity. Fills user_id and match;
+// returns the number of results.
+int name_index_search(const char *query, UserSearchResult *out, int max_count) {
+    char key[MAX_DISPLAY_NAME];
+    make_key(query, key);
+    size_t len = strlen(key);
+    if (len == 0 || max_count <= 0 || sorted_count == 0) return 0;
+
+    // 1. Prefix range
+    int count = 0;
+    int lo = 0, hi = sorted_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (strcmp(keys[sorted[mid]], key) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    for (int i = lo; i < sorted_count && count < max_count; i++) {
+        const char *k = keys[sorted[i]];
+        if (strncmp(k, key, len) != 0) break;
+        out[count].user_id = sorted[i];
+        out[count].match = k[len] == '\0' ? SEARCH_MATCH_EXACT : SEARCH_MATCH_PREFIX;
+        count++;
+    }
+    if (count == max_count || len < FUZZY_MIN_QUERY) return count;
+
+    // 2. Trigram candidates, skipping names already returned as prefixes
+    unsigned int grams[NGRAM_MAX];
+    int n = trigrams(key, 0, grams);
+    if (++generation == 0) {
+        memset(stamp, 0, keys_cap * sizeof(unsigned int));
+        generation = 1;
+    }
+    for (int i = 0; i < count; i++) {
+        stamp[out[i].user_id] = generation;
+        hits[out[i].user_id] = -NGRAM_MAX;
+    }
+
+    FuzzyHit best[SEARCH_RESULTS_MAX];
+    int num_best = 0;
+    int needed = (int)(n * FUZZY_MIN_COVERAGE + 0.999);
+    for (int g = 0; g < n; g++) {
+        const Posting *p = posting_of(grams[g]);
+        for (int j = 0; j < p->count; j++) {
+            int id = p->ids[j];
+            if (stamp[id] != generation) {
+                stamp[id] = generation;
+                hits[id] = 0;
+            }
+            if (++hits[id] != needed) continue;
+
+            // Enough shared buckets (trigrams can collide) to compare exactly
+            unsigned int other[NGRAM_MAX];
+            int m = trigrams(keys[id], 1, other);
+            int shared = 0;
+            for (int a = 0, b = 0; a < n && b < m;) {
+                if (grams[a] == other[b]) { shared++; a++; b++; }
+                else if (grams[a] < other[b]) a++;
+                else b++;
+            }
+            double coverage = (double)shared / n;
+            if (coverage < FUZZY_MIN_COVERAGE) continue;
+
+            // Keep the best (max_count - count), worst last
+            int room = max_count - count;
+            if (room > SEARCH_RESULTS_MAX) room = SEARCH_RESULTS_MAX;
+            FuzzyHit hit = {id, coverage, (double)shared / (n + m - shared)};
+            if (num_best == room && cmp_fuzzy(&hit, &best[num_best - 1]) >= 0) continue;
+            if (num_best < room) num_best++;
+            int k = num_best - 1;
+            while (k > 0 && cmp_fuzzy(&hit, &best[k - 1]) < 0) {
+                best[k] = best[k - 1];
+                k--;
+            }
+            best[k] = hit;
+        }
+    }
+
+    for (int i = 0; i < num_best && count < max_count; i++) {
+        out[count].user_id = best[i].user_id;
+        out[count].match = SEARCH_MATCH_FUZZY;
+        count++;
+    }
+    return count;
+}
+
+int name_index_size() {
+    return sorted_count;
+}
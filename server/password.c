@@ -0,0 +1,241 @@
+/* server/password.c - Password hashing: scrypt (RFC 7914) over HMAC-SHA256 */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "server.h"
+
+// Stored hashes look like "$scrypt$ln=14,r=8,p=1$<64 hex digits>"; the salt
+// stays in its own column. The cost parameters travel with each hash, so
+// raising PASSWORD_SCRYPT_* only affects new hashes, and password_verify()
+// reports older ones (and pre-scrypt djb2 hashes) as needing a rehash.
+// Each call allocates 128 * r * 2^ln bytes: run it on the auth pool, never
+// on the main loop.
+
+// --- HMAC-SHA256 / PBKDF2 ---
+
+typedef struct {
+    Sha256 inner;              // Already fed key ^ ipad
+    Sha256 outer;              // Already fed key ^ opad
+} HmacKey;
+
+static void hmac_init(HmacKey *k, const uint8_t *key, size_t key_len) {
+    uint8_t block[64], digest[SHA256_SIZE];
+    if (key_len > sizeof(block)) {
+        sha256(key, key_len, digest);
+        key = digest;
+        key_len = SHA256_SIZE;
+    }
+    memset(block, 0, sizeof(block));
+    memcpy(block, key, key_len);
+
+    for (int i = 0; i < 64; i++) block[i] ^= 0x36;
+    sha256_init(&k->inner);
+    sha256_update(&k->inner, block, 64);
+    for (int i = 0; i < 64; i++) block[i] ^= 0x36 ^ 0x5c;
+    sha256_init(&k->outer);
+    sha256_update(&k->outer, block, 64);
+}
+
+static void hmac_finish(const HmacKey *k, Sha256 *inner, uint8_t out[SHA256_SIZE]) {
+    uint8_t digest[SHA256_SIZE];
+    sha256_final(inner, digest);
+    Sha256 outer = k->outer;
+    sha256_update(&outer, digest, SHA256_SIZE);
+    sha256_final(&outer, out);
+}
+
+// PBKDF2-HMAC-SHA256 with one iteration per block, which is all scrypt uses
+static void pbkdf2_sha256(const uint8_t *pw, size_t pw_len, const uint8_t *salt, size_t salt_len,
+                          uint8_t *out, size_t out_len) {
+    HmacKey key;
+    hmac_init(&key, pw, pw_len);
+
+    Sha256 salted = key.inner;
+    sha256_update(&salted, salt, salt_len);
+
+    for (uint32_t block = 1; out_len > 0; block++) {
+        uint8_t counter[4] = {block >> 24, block >> 16, block >> 8, block};
+        uint8_t t[SHA256_SIZE];
+        Sha256 inner = salted;
+        sha256_update(&inner, counter, 4);
+        hmac_finish(&key, &inner, t);
+
+        size_t n = out_len < SHA256_SIZE ? out_len : SHA256_SIZE;
+        memcpy(out, t, n);
+        out += n;
+        out_len -= n;
+    }
+}
+
+// --- scrypt core ---
+
+static inline uint32_t rol(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+static void salsa20_8(uint32_t b[16]) {
+    uint32_t x[16];
+    memcpy(x, b, sizeof(x));
+    for (int i = 0; i < 8; i += 2) {
+        x[ 4] ^= rol(x[ 0] + x[12],  7);  x[ 8] ^= rol(x[ 4] + x[ 0],  9);
+        x[12] ^= rol(x[ 8] + x[ 4], 13);  x[ 0] ^= rol(x[12] + x[ 8], 18);
+        x[ 9] ^= rol(x[ 5] + x[ 1],  7);  x[13] ^= rol(x[ 9] + x[ 5],  9);
+        x[ 1] ^= rol(x[13] + x[ 9], 13);  x[ 5] ^= rol(x[ 1] + x[13], 18);
+        x[14] ^= rol(x[10] + x[ 6],  7);  x[ 2] ^= rol(x[14] + x[10],  9);
+        x[ 6] ^= rol(x[ 2] + x[14], 13);  x[10] ^= rol(x[ 6] + x[ 2], 18);
+        x[ 3] ^= rol(x[15] + x[11],  7);  x[ 7] ^= rol(x[ 3] + x[15],  9);
+        x[11] ^= rol(x[ 7] + x[ 3], 13);  x[15] ^= rol(x[11] + x[ 7], 18);
+        x[ 1] ^= rol(x[ 0] + x[ 3],  7);  x[ 2] ^= rol(x[ 1] + x[ 0],  9);
+        x[ 3] ^= rol(x[ 2] + x[ 1], 13);  x[ 0] ^= rol(x[ 3] + x[ 2], 18);
+        x[ 6] ^= rol(x[ 5] + x[ 4],  7);  x[ 7] ^= rol(x[ 6] + x[ 5],  9);
+        x[ 4] ^= rol(x[ 7] + x[ 6], 13);  x[ 5] ^= rol(x[ 4] + x[ 7], 18);
+        x[11] ^= rol(x[10] + x[ 9],  7);  x[ 8] ^= rol(x[11] + x[10],  9);
+        x[ 9] ^= rol(x[ 8] + x[11], 13);  x[10] ^= rol(x[ 9] + x[ 8], 18);
+        x[12] ^= rol(x[15] + x[14],  7);  x[13] ^= rol(x[12] + x[15],  9);
+        x[14] ^= rol(x[13] + x[12], 13);  x[15] ^= rol(x[14] + x[13], 18);
+    }
+    for (int i = 0; i < 16; i++) b[i] += x[i];
+}
+
+// B (2r blocks of 16 words) -> Y, even blocks first, then odd
+static void blockmix(const uint32_t *b, uint32_t *y, int r) {
+    uint32_t x[16];
+    memcpy(x, &b[(2 * r - 1) * 16], sizeof(x));
+    for (int i = 0; i < 2 * r; i++) {
+        for (int k = 0; k < 16; k++) x[k] ^= b[i * 16 + k];
+        salsa20_8(x);
+        memcpy(&y[((i & 1) * r + i / 2) * 16], x, sizeof(x));
+    }
+}
+
+// Mixes one 128*r byte block in place. v holds n blocks, xy two more.
+static void romix(uint8_t *block, int r, uint64_t n, uint32_t *v, uint32_t *xy) {
+    size_t words = 32 * (size_t)r;
+    uint32_t *x = xy, *y = xy + words;
+
+    for (size_t k = 0; k < words; k++) {
+        const uint8_t *p = &block[k * 4];
+        x[k] = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+    }
+    for (uint64_t i = 0; i < n; i += 2) {
+        memcpy(&v[i * words], x, words * 4);
+        blockmix(x, y, r);
+        memcpy(&v[(i + 1) * words], y, words * 4);
+        blockmix(y, x, r);
+    }
+    for (uint64_t i = 0; i < n; i += 2) {
+        uint64_t j = x[(2 * r - 1) * 16] & (n - 1);
+        for (size_t k = 0; k < words; k++) x[k] ^= v[j * words + k];
+        blockmix(x, y, r);
+        j = y[(2 * r - 1) * 16] & (n - 1);
+        for (size_t k = 0; k < words; k++) y[k] ^= v[j * words + k];
+        blockmix(y, x, r);
+    }
+    for (size_t k = 0; k < words; k++) {
+        uint8_t *p = &block[k * 4];
+        p[0] = (uint8_t)x[k]; p[1] = (uint8_t)(x[k] >> 8);
+        p[2] = (uint8_t)(x[k] >> 16); p[3] = (uint8_t)(x[k] >> 24);
+    }
+}
+
+// scrypt with N = 2^log_n. Returns 0, or -1 on bad parameters / out of memory.
+int scrypt_kdf(const void *pw, size_t pw_len, const void *salt, size_t salt_len,
+               int log_n, int r, int p, uint8_t *out, size_t out_len) {
+    if (log_n < 1 || log_n > 24 || r < 1 || r > 32 || p < 1 || p > 16) return -1;
+    uint64_t n = 1ULL << log_n;
+    size_t block_size = 128 * (size_t)r;
+
+    uint8_t *b = malloc(block_size * p);
+    uint32_t *v = malloc(block_size * n);
+    uint32_t *xy = malloc(block_size * 2);
+    if (!b || !v || !xy) {
+        free(b);
+        free(v);
+        free(xy);
+        return -1;
+    }
+
+    pbkdf2_sha256(pw, pw_len, salt, salt_len, b, block_size * p);
+    for (int i = 0; i < p; i++) romix(&b[i * block_size], r, n, v, xy);
+    pbkdf2_sha256(pw, pw_len, b, block_size * p, out, out_len);
+
+    memset(b, 0, block_size * p);
+    free(b);
+    free(v);
+    free(xy);
+    return 0;
+}
+
+// --- Stored hash format ---
+
+// Random alphanumeric salt, NUL-terminated within 'len' bytes
+void generate_salt(char *salt, size_t len) {
+    const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    if (secure_random_string(salt, len, charset, sizeof(charset) - 1) != 0) {
+        fprintf(stderr, "[AUTH] Failed to generate salt\n");
+    }
+}
+
+// Pre-scrypt accounts: decimal djb2 of password + salt
+static void legacy_hash(const char *password, const char *salt, char *output, size_t size) {
+    unsigned long hash = 5381;
+    char combined[512];
+    snprintf(combined, sizeof(combined), "%s%s", password, salt);
+
+    const char *str = combined;
+    int c;
+    while ((c = *str++)) {
+        hash = ((hash << 5) + hash) + c;
+    }
+    snprintf(output, size, "%lu", hash);
+}
+
+static int encode(const char *password, const char *salt, int log_n, int r, int p,
+                  char *out, size_t size) {
+    uint8_t dk[PASSWORD_KEY_SIZE];
+    if (scrypt_kdf(password, strlen(password), salt, strlen(salt), log_n, r, p, dk, sizeof(dk)) != 0) {
+        return -1;
+    }
+    int len = snprintf(out, size, "$scrypt$ln=%d,r=%d,p=%d$", log_n, r, p);
+    if (len < 0 || (size_t)len + 2 * sizeof(dk) >= size) return -1;
+    for (size_t i = 0; i < sizeof(dk); i++) {
+        snprintf(out + len + 2 * i, 3, "%02x", dk[i]);
+    }
+    return 0;
+}
+
+// Equal-length compare that does not stop at the first difference
+static int same_string(const char *a, const char *b) {
+    size_t len = strlen(a);
+    if (len != strlen(b)) return 0;
+    unsigned char diff = 0;
+    for (size_t i = 0; i < len; i++) diff |= (unsigned char)(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+// Hash 'password' with the current cost parameters into 'out'
+int password_hash(const char *password, const char *salt, char *out, size_t size) {
+    return encode(password, salt, PASSWORD_SCRYPT_LOG_N, PASSWORD_SCRYPT_R, PASSWORD_SCRYPT_P,
+                  out, size);
+}
+
+// 1 if 'password' matches 'stored', 0 if not, -1 if it could not be checked.
+// On a match, *needs_rehash says whether 'stored' is below the current cost.
+int password_verify(const char *password, const char *salt, const char *stored, int *needs_rehash) {
+    char computed[PASSWORD_HASH_SIZE];
+    int log_n, r, p;
+    *needs_rehash = 0;
+
+    if (sscanf(stored, "$scrypt$ln=%d,r=%d,p=%d$", &log_n, &r, &p) == 3) {
+        if (encode(password, salt, log_n, r, p, computed, sizeof(computed)) != 0) return -1;
+        if (!same_string(stored, computed)) return 0;
+        *needs_rehash = log_n != PASSWORD_SCRYPT_LOG_N || r != PASSWORD_SCRYPT_R ||
+                        p != PASSWORD_SCRYPT_P;
+        return 1;
+    }
+
+    legacy_hash(password, salt, computed, sizeof(computed));
+    if (!same_string(stored, computed)) return 0;
+    *needs_rehash = 1;
+    return 1;
+}
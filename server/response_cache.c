@@ -0,0 +1,101 @@
+/* server/response_cache.c - Encoded responses for hot read endpoints */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include "server.h"
+#include "../common/packet.h"
+
+// Each endpoint keeps a small direct-mapped table of packets exactly as they
+// go on the wire, so a refresh storm costs one build and N send() calls.
+// Entries are dropped by the write paths that change the underlying data;
+// dropping every key just bumps the endpoint's generation. Main loop only.
+typedef struct {
+    int key;
+    unsigned int generation;   // Valid while equal to the endpoint's
+    size_t len;                // 0 = empty
+    size_t capacity;
+    unsigned char *bytes;
+} CacheEntry;
+
+typedef struct {
+    const char *name;
+    unsigned int generation;
+    CacheEntry slots[CACHE_SLOTS];
+    long long hits;
+    long long misses;
+    long long invalidations;
+} CacheTable;
+
+static CacheTable tables[CACHE_ENDPOINTS] = {
+    [CACHE_LEADERBOARD] = {.name = "leaderboard"},
+    [CACHE_LOBBY_LIST]  = {.name = "lobby_list"},
+    [CACHE_PROFILE]     = {.name = "profile"},
+};
+
+static CacheEntry* slot_for(CacheEndpoint ep, int key) {
+    return &tables[ep].slots[(unsigned int)key % CACHE_SLOTS];
+}
+
+// Send the cached response for (ep, key) if there is one. Returns 1 on a hit.
+int response_cache_send(int socket_fd, CacheEndpoint ep, int key) {
+    CacheTable *t = &tables[ep];
+    CacheEntry *e = slot_for(ep, key);
+    if (e->len == 0 || e->key != key || e->generation != t->generation) {
+        t->misses++;
+        return 0;
+    }
+    t->hits++;
+    send(socket_fd, e->bytes, e->len, 0);
+    return 1;
+}
+
+// Keep the wire form of 'packet' for later requests of (ep, key)
+void response_cache_store(CacheEndpoint ep, int key, const ServerPacket *packet) {
+    CacheEntry *e = slot_for(ep, key);
+    size_t len = server_packet_wire_size(packet);
+    if (len > e->capacity) {
+        unsigned char *grown = realloc(e->bytes, len);
+        if (!grown) return;  // Just stays uncached
+        e->bytes = grown;
+        e->capacity = len;
+    }
+    memcpy(e->bytes, packet, len);
+    e->len = len;
+    e->key = key;
+    e->generation = tables[ep].generation;
+}
+
+// Drop one key, or every key with CACHE_ALL_KEYS
+void response_cache_invalidate(CacheEndpoint ep, int key) {
+    CacheTable *t = &tables[ep];
+    t->invalidations++;
+    if (key == CACHE_ALL_KEYS) {
+        t->generation++;
+        return;
+    }
+    CacheEntry *e = slot_for(ep, key);
+    if (e->key == key) e->len = 0;
+}
+
+void response_cache_report() {
+    printf("[CACHE] Response cache stats:\n");
+    printf("[CACHE]   %-12s %10s %10s %8s %14s\n",
+           "endpoint", "hits", "misses", "hit %", "invalidations");
+    for (int i = 0; i < CACHE_ENDPOINTS; i++) {
+        CacheTable *t = &tables[i];
+        long long total = t->hits + t->misses;
+        printf("[CACHE]   %-12s %10lld %10lld %8.1f %14lld\n",
+               t->name, t->hits, t->misses,
+               total ? 100.0 * t->hits / total : 0.0, t->invalidations);
+    }
+}
+
+void response_cache_free() {
+    for (int i = 0; i < CACHE_ENDPOINTS; i++) {
+        for (int s = 0; s < CACHE_SLOTS; s++) {
+            free(tables[i].slots[s].bytes);
+            memset(&tables[i].slots[s], 0, sizeof(CacheEntry));
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/* server/rng.c - Per-game simulation PRNG and OS-backed secure randomness */
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/random.h>
+#include "server.h"
+
+// --- Simulation PRNG (xoshiro256**) ---
+// Each GameWorld owns one, seeded in init_game(), so a match replays exactly
+// from its seed and lobbies ticking on different workers never share state.
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void rng_seed(GameRng *rng, uint64_t seed) {
+    // splitmix64 expands the seed so even 0 gives a valid (non-zero) state
+    for (int i = 0; i < 4; i++) rng->s[i] = splitmix64(&seed);
+}
+
+uint64_t rng_next(GameRng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+// Uniform integer in [0, n) without modulo bias (Lemire's multiply-shift)
+int rng_range(GameRng *rng, int n) {
+    if (n <= 1) return 0;
+    uint32_t range = (uint32_t)n;
+    uint64_t m = (uint64_t)(uint32_t)(rng_next(rng) >> 32) * range;
+    uint32_t low = (uint32_t)m;
+    if (low < range) {
+        uint32_t threshold = -range % range;
+        while (low < threshold) {
+            m = (uint64_t)(uint32_t)(rng_next(rng) >> 32) * range;
+            low = (uint32_t)m;
+        }
+    }
+    return (int)(m >> 32);
+}
+
+// --- Secure randomness (salts, session tokens, seeds) ---
+
+// Fill buf from the kernel CSPRNG. Returns 0 on success, -1 on failure.
+int secure_random_bytes(void *buf, size_t len) {
+    unsigned char *p = buf;
+    while (len > 0) {
+        ssize_t n = getrandom(p, len, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    if (len == 0) return 0;
+
+    // Kernels without getrandom(): fall back to the device
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror("[RNG] /dev/urandom");
+        return -1;
+    }
+    while (len > 0) {
+        ssize_t n = read(fd, p, len);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            close(fd);
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    close(fd);
+    return 0;
+}
+
+// Random string from 'charset' (rejection sampling keeps it unbiased)
+int secure_random_string(char *out, size_t length, const char *charset, size_t charset_len) {
+    if (length == 0) return 0;
+    if (charset_len == 0 || charset_len > 256) return -1;
+
+    size_t limit = 256 - (256 % charset_len);
+    size_t i = 0;
+    unsigned char pool[64];
+    while (i < length - 1) {
+        if (secure_random_bytes(pool, sizeof(pool)) != 0) {
+            out[0] = '\0';
+            return -1;
+        }
+        for (size_t k = 0; k < sizeof(pool) && i < length - 1; k++) {
+            if (pool[k] < limit) out[i++] = charset[pool[k] % charset_len];
+        }
+    }
+    out[length - 1] = '\0';
+    return 0;
+}
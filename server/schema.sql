@@ -10,8 +10,8 @@ CREATE TABLE IF NOT EXISTS Users (
     password_hash TEXT NOT NULL,             -- Hashed password
     salt TEXT NOT NULL,                      -- Salt for password hashing
     elo_rating INTEGER DEFAULT 1200,         -- ELO ranking (start at 1200)
-    session_token TEXT,                      -- For persistent login
-    session_expiry TIMESTAMP,                -- Token expiration
+    session_token TEXT,                      -- Legacy, unused (see Sessions)
+    session_expiry TIMESTAMP,                -- Legacy, unused (see Sessions)
     created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
     last_login TIMESTAMP DEFAULT CURRENT_TIMESTAMP
 );
@@ -20,6 +20,16 @@ CREATE TABLE IF NOT EXISTS Users (
 CREATE INDEX IF NOT EXISTS idx_users_email ON Users(email);
 CREATE INDEX IF NOT EXISTS idx_users_username ON Users(username);
 
+-- Sessions table: Persistent login tokens, stored as SHA-256 digests
+CREATE TABLE IF NOT EXISTS Sessions (
+    token_hash BLOB PRIMARY KEY,             -- SHA-256 of the token
+    user_id INTEGER NOT NULL,
+    expires_at INTEGER NOT NULL,             -- Unix time
+    FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
+);
+
+CREATE INDEX IF NOT EXISTS idx_sessions_expiry ON Sessions(expires_at);
+
 -- Friendships table: Friend relationships and pending requests
 CREATE TABLE IF NOT EXISTS Friendships (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -58,6 +68,7 @@ CREATE TABLE IF NOT EXISTS MatchHistory (
     winner_id INTEGER,                       -- NULL for draw
     duration_seconds INTEGER,
     num_players INTEGER,
+    game_mode INTEGER DEFAULT 0,             -- GAME_MODE_*
     FOREIGN KEY (winner_id) REFERENCES Users(id) ON DELETE SET NULL
 );
 
@@ -77,4 +88,35 @@ CREATE TABLE IF NOT EXISTS MatchPlayers (
 );
 
 CREATE INDEX IF NOT EXISTS idx_match_players_match ON MatchPlayers(match_id);
-CREATE INDEX IF NOT EXISTS idx_match_players_user ON MatchPlayers(user_id);
+-- A player's matches newest first: one range seek per history page
+DROP INDEX IF EXISTS idx_match_players_user;
+CREATE INDEX IF NOT EXISTS idx_match_players_user_match ON MatchPlayers(user_id, match_id);
+
+-- Rollups: per-player totals by day and by game mode, kept up to date by
+-- each match commit (server_bin --rebuild-stats regenerates them from
+-- MatchHistory/MatchPlayers)
+CREATE TABLE IF NOT EXISTS StatsDaily (
+    user_id INTEGER NOT NULL,
+    day INTEGER NOT NULL,                    -- Unix time / 86400 (UTC)
+    matches INTEGER DEFAULT 0,
+    wins INTEGER DEFAULT 0,
+    kills INTEGER DEFAULT 0,
+    deaths INTEGER DEFAULT 0,
+    play_seconds INTEGER DEFAULT 0,
+    elo_change INTEGER DEFAULT 0,
+    PRIMARY KEY (user_id, day),
+    FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
+) WITHOUT ROWID;
+
+CREATE TABLE IF NOT EXISTS StatsByMode (
+    user_id INTEGER NOT NULL,
+    game_mode INTEGER NOT NULL,
+    matches INTEGER DEFAULT 0,
+    wins INTEGER DEFAULT 0,
+    kills INTEGER DEFAULT 0,
+    deaths INTEGER DEFAULT 0,
+    play_seconds INTEGER DEFAULT 0,
+    elo_change INTEGER DEFAULT 0,
+    PRIMARY KEY (user_id, game_mode),
+    FOREIGN KEY (user_id) REFERENCES Users(id) ON DELETE CASCADE
+) WITHOUT ROWID;
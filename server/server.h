@@ -1,159 +1,667 @@
-/* server/server.h */
-#ifndef SERVER_H
-#define SERVER_H
-
-#include <time.h>
-#include "../common/protocol.h"
-
-#define MAX_USERS 10000
-#define MAX_EMAIL 128
-#define MAX_DISPLAY_NAME 64
-
-#define MAX_LOBBIES 10
-
-// --- Structures ---
-typedef struct {
-    int socket_fd;
-    int user_id;                      // Database user ID
-    char username[MAX_USERNAME];
-    char display_name[MAX_DISPLAY_NAME];
-    int is_authenticated;
-    int lobby_id;
-    int player_id_in_game; 
-    char session_token[64];
-    time_t last_active;
-} ClientInfo;
-
-#define MAX_CHAT_HISTORY 50
-typedef struct {
-    char sender_username[MAX_USERNAME];
-    char message[200];
-    uint32_t timestamp;
-    int player_id;
-} ChatHistoryEntry;
-
-typedef struct {
-    ChatHistoryEntry messages[MAX_CHAT_HISTORY];
-    int count;
-} LobbyChat;
-
-// --- Global State (Defined in main.c or specialized state file) ---
-extern ClientInfo clients[MAX_CLIENTS * MAX_LOBBIES];
-extern int num_clients;
-extern LobbyChat lobby_chats[MAX_LOBBIES];
-extern GameState active_games[MAX_LOBBIES];
-extern long long last_game_update[MAX_LOBBIES];
-
-// --- Helper Functions in main.c ---
-ClientInfo* find_client_by_socket(int socket_fd);
-void send_response(int socket_fd, ServerPacket *packet);
-void broadcast_lobby_list();
-void broadcast_lobby_update(int lobby_id);
-void broadcast_game_state(int lobby_id);
-void log_event(const char *category, const char *format, ...);
-void generate_session_token(char *buffer, size_t length);
-long long get_current_time_ms();
-
-// --- Enhanced User Struct (Database) ---
-typedef struct {
-    int id;                                  // Primary key from database
-    char username[MAX_USERNAME];             // Immutable unique identifier
-    char display_name[MAX_DISPLAY_NAME];     // Mutable display name
-    char email[MAX_EMAIL];                   // For login and verification
-    int elo_rating;                          // ELO ranking
-    char session_token[64];                  // Session token
-    int is_online;                           // Current online status
-    int lobby_id;                            // Current lobby (-1 if none)
-} User;
-
-// --- Database Functions (SQLite3) ---
-int db_init();                               // Initialize SQLite database
-void db_close();                             // Close database connection
-int db_register_user(const char *username, const char *email, const char *password);
-int db_login_user(const char *identifier, const char *password, User *out_user);
-int db_update_display_name(int user_id, const char *new_display_name);
-int db_get_user_by_id(int user_id, User *out_user);
-int db_find_user_by_display_name(const char *display_name, User *out_user);
-int db_update_elo(int user_id, int new_elo);
-int db_update_session_token(int user_id, const char *token);
-int db_get_user_by_token(const char *token, User *out_user);
-
-// --- Lobby Functions ---
-void init_lobbies();
-int create_lobby(const char *room_name, const char *host_username, int is_private, const char *access_code, int game_mode);
-int join_lobby(int lobby_id, const char *username);
-int join_lobby_with_code(int lobby_id, const char *username, const char *access_code);
-int leave_lobby(int lobby_id, const char *username);
-int toggle_ready(int lobby_id, const char *username);
-int start_game(int lobby_id, const char *username);
-int get_lobby_list(LobbySummary *out_lobbies);
-Lobby* find_lobby(int lobby_id);
-int find_user_lobby(const char *username);
-int join_spectator(int lobby_id, const char *username);
-int leave_spectator(int lobby_id, const char *username);
-
-// --- Game Logic Functions ---
-void init_game(GameState *state, Lobby *lobby);
-void update_game(GameState *state);
-int handle_move(GameState *state, int player_id, int direction);
-int plant_bomb(GameState *state, int player_id);
-int is_tile_visible(GameState *state, int player_id, int tile_x, int tile_y);
-void filter_game_state(GameState *full_state, int player_id, GameState *out_filtered);
-
-// --- Friend System Functions ---
-int friend_send_request(int sender_id, const char *target_display_name);
-int friend_accept_request(int user_id, int requester_id);
-int friend_decline_request(int user_id, int requester_id);
-int friend_remove(int user_id, int friend_id);
-int friend_get_list(int user_id, FriendInfo *out_friends, int max_count);
-int friend_get_pending_requests(int user_id, FriendInfo *out_requests, int max_count);
-int friend_get_sent_requests(int user_id, FriendInfo *out_requests, int max_count);
-
-// --- ELO System Functions ---
-int get_k_factor(int matches_played);
-int elo_calculate_change(int my_elo, int opp_elo, int win);
-int elo_update_after_match(int *player_ids, int *placements, int num_players, int *out_elo_changes);
-int get_tier(int elo_rating);
-const char* get_tier_name(int tier);
-
-// --- Statistics Functions ---
-int stats_record_match(int *player_ids, int *placements, int *kills, int num_players, int winner_id, int duration_seconds);
-int stats_get_profile(int user_id, ProfileData *out_profile);
-int stats_get_leaderboard(LeaderboardEntry *out_entries, int max_count);
-void stats_increment_bombs(int user_id);
-void stats_increment_walls(int user_id, int count);
-
-// --- Network Functions ---
-// --- Network Functions ---
-int init_server_socket();
-
-// --- Packet Handlers ---
-void handle_register(int socket_fd, ClientPacket *pkt);
-void handle_login(int socket_fd, ClientPacket *pkt);
-void handle_login_with_token(int socket_fd, ClientPacket *pkt);
-
-void handle_create_lobby(int socket_fd, ClientPacket *pkt);
-void handle_join_lobby(int socket_fd, ClientPacket *pkt);
-void handle_leave_lobby(int socket_fd, ClientPacket *pkt);
-void handle_list_lobbies(int socket_fd, ClientPacket *pkt);
-void handle_spectate(int socket_fd, ClientPacket *pkt);
-void handle_ready(int socket_fd, ClientPacket *pkt);
-void handle_start_game(int socket_fd, ClientPacket *pkt);
-
-void handle_game_move(int socket_fd, ClientPacket *pkt);
-void handle_plant_bomb(int socket_fd, ClientPacket *pkt);
-void handle_leave_game(int socket_fd, ClientPacket *pkt);
-void forfeit_player_from_game(int lobby_id, const char *username);
-
-void handle_chat(int socket_fd, ClientPacket *pkt);
-
-void handle_friend_request(int socket_fd, ClientPacket *pkt);
-void handle_friend_accept(int socket_fd, ClientPacket *pkt);
-void handle_friend_reject(int socket_fd, ClientPacket *pkt);
-void handle_friend_remove(int socket_fd, ClientPacket *pkt);
-void handle_friend_list(int socket_fd, ClientPacket *pkt);
-void handle_get_profile(int socket_fd, ClientPacket *pkt);
-void handle_get_leaderboard(int socket_fd, ClientPacket *pkt);
-void handle_invite(int socket_fd, ClientPacket *pkt);
-
+/* server/server.h */
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <time.h>
+#include <sqlite3.h>
+#include "../common/protocol.h"
+#include "../common/visibility.h"
+
+#define MAX_USERS 10000
+#define MAX_EMAIL 128
+#define MAX_DISPLAY_NAME 64
+
+#define MAX_CONNECTIONS 256      // Sockets tracked in clients[]
+
+// --- Structures ---
+typedef struct {
+    int socket_fd;
+    int user_id;                      // Database user ID
+    char username[MAX_USERNAME];
+    char display_name[MAX_DISPLAY_NAME];
+    int is_authenticated;
+    int lobby_id;
+    int player_id_in_game; 
+    char session_token[64];
+    time_t last_active;
+    unsigned int auth_ticket;         // Login/registration on the auth pool (0 = none)
+    int queue_ticket;                 // Quick play ticket (-1 = not queued)
+    int lobby_feed;                   // Subscribed to lobby list deltas
+} ClientInfo;
+
+#define MAX_CHAT_HISTORY CHAT_HISTORY_MAX
+typedef struct {
+    char sender_username[MAX_USERNAME];
+    char message[200];
+    uint32_t timestamp;
+    int player_id;
+} ChatHistoryEntry;
+
+// Ring: the oldest of 'count' messages is at 'first'; a new one past
+// MAX_CHAT_HISTORY overwrites it
+typedef struct {
+    ChatHistoryEntry messages[MAX_CHAT_HISTORY];
+    int first;
+    int count;
+} LobbyChat;
+
+// --- Game Runtime (server-side only, never sent to clients) ---
+// Arrays are sized for a full arena; each game only uses the slots its
+// player count needs (bomb_slots / explosion_slots)
+#define BOMB_SLOTS_PER_PLAYER 3
+#define EXPLOSION_SLOTS_PER_BOMB 10
+#define MAX_BOMBS (MAX_LOBBY_PLAYERS * BOMB_SLOTS_PER_PLAYER)
+#define MAX_EXPLOSIONS (MAX_BOMBS * EXPLOSION_SLOTS_PER_BOMB)
+
+// World size limits. Standard modes use MAP_WIDTH x MAP_HEIGHT.
+#define WORLD_MAX_WIDTH 63
+#define WORLD_MAX_HEIGHT 51
+#define ARENA_MAP_WIDTH WORLD_MAX_WIDTH
+#define ARENA_MAP_HEIGHT WORLD_MAX_HEIGHT
+
+// Uniform grid over the world, rebuilt every tick, so "who is near tile
+// (x, y)" costs one or a few cells instead of a scan over every player
+#define GRID_CELL_SIZE 8
+#define GRID_COLS ((WORLD_MAX_WIDTH + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+#define GRID_ROWS ((WORLD_MAX_HEIGHT + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE)
+
+typedef struct {
+    int cell_start[GRID_COLS * GRID_ROWS + 1];  // ids[cell_start[c] .. cell_start[c+1]) are in cell c
+    int ids[MAX_LOBBY_PLAYERS];                 // Alive players, grouped by cell
+} SpatialGrid;
+
+// xoshiro256** state; one per game so simulation randomness is per lobby
+typedef struct {
+    uint64_t s[4];
+} GameRng;
+
+// Authoritative simulation state. Clients never see this directly; each
+// recipient gets a GameState view encoded from it.
+typedef struct {
+    int width, height;
+    int map[WORLD_MAX_HEIGHT][WORLD_MAX_WIDTH];
+    Player players[MAX_LOBBY_PLAYERS];
+    int num_players;
+    int game_status;
+    int winner_id;
+    int kills[MAX_LOBBY_PLAYERS];
+    int bombs_planted[MAX_LOBBY_PLAYERS];
+    int walls_destroyed[MAX_LOBBY_PLAYERS];
+    int elo_changes[MAX_LOBBY_PLAYERS];
+    long long match_start_time;
+    int match_duration_seconds;
+    long long end_game_time;
+    int game_mode;
+    int fog_radius;
+    int sudden_death_timer;
+    int shrink_zone_left;
+    int shrink_zone_right;
+    int shrink_zone_top;
+    int shrink_zone_bottom;
+    long long start_game_time;
+    int tick_rate;
+    unsigned int tick;
+    SpatialGrid grid;
+    VisOpacity opacity;                // Sight-blocking walls (fog of war only)
+    uint64_t seed;                     // Replaying with this seed reproduces the match
+    GameRng rng;                       // All simulation randomness comes from here
+} GameWorld;
+
+typedef struct {
+    int x, y;
+    long long plant_time;
+    int is_active;
+    int owner_id;      // ID người đặt bom
+    int range;         // Tầm nổ của bom này
+} Bomb;
+
+typedef struct {
+    int x, y;
+    long long start_time;
+    int is_active;
+} Explosion;
+
+// Player input handed from the network thread to the game's tick task
+typedef struct {
+    int player_id;
+    int type;          // MSG_MOVE or MSG_PLANT_BOMB
+    int data;          // Direction for MSG_MOVE
+} GameInput;
+
+// Single-producer (network thread) / single-consumer (tick task) ring
+#define GAME_INPUT_QUEUE_SIZE 64   // Must be a power of two
+typedef struct {
+    GameInput items[GAME_INPUT_QUEUE_SIZE];
+    _Atomic unsigned int head;     // Next slot to read (consumer)
+    _Atomic unsigned int tail;     // Next slot to write (producer)
+} GameInputQueue;
+
+// Encoded output of one tick: one view per recipient
+typedef struct {
+    int per_player_views;              // 0 = views[0] goes to everyone
+    int num_views;                     // Player views + 1 spectator view
+    GameState views[MAX_LOBBY_PLAYERS + 1];
+    int move_results[MAX_LOBBY_PLAYERS];  // Power-up pickup result per player this tick (11/12)
+} GameSnapshot;
+
+// Single-producer (tick task) / single-consumer (network thread) ring
+#define GAME_OUTPUT_QUEUE_SIZE 2   // Must be a power of two
+typedef struct {
+    GameSnapshot items[GAME_OUTPUT_QUEUE_SIZE];
+    _Atomic unsigned int head;
+    _Atomic unsigned int tail;
+} GameOutputQueue;
+
+typedef struct {
+    GameWorld state;                   // Authoritative state
+    long long sim_time_ms;             // Simulated clock: state.tick * 1000 / tick_rate
+    int steps_due;                     // Fixed steps to run in the next tick task
+    int steps_owed;                    // Network thread: steps due while a tick was still running
+    _Atomic int tick_running;          // Set on submit; the tick task owns state until it clears it
+    int results_submitted;             // Match-end writes queued on the DB writer
+    int bomb_slots;                    // bombs[] in use: num_players * BOMB_SLOTS_PER_PLAYER
+    int explosion_slots;               // explosions[] in use: bomb_slots * EXPLOSION_SLOTS_PER_BOMB
+    Bomb bombs[MAX_BOMBS];
+    Explosion explosions[MAX_EXPLOSIONS];
+    GameInputQueue inputs;
+    GameOutputQueue outputs;
+} ActiveGame;
+
+// --- Global State (Defined in main.c or specialized state file) ---
+extern ClientInfo clients[MAX_CONNECTIONS];
+extern int num_clients;
+
+// --- Helper Functions in main.c ---
+ClientInfo* find_client_by_socket(int socket_fd);
+void send_response(int socket_fd, ServerPacket *packet);
+void client_set_lobby(ClientInfo *client, int lobby_id);
+void send_lobby_list(int socket_fd);
+void send_lobby_update(int socket_fd, const Lobby *lobby);
+void broadcast_lobby_update(int lobby_id);
+void broadcast_game_state(int lobby_id);
+void send_game_state(ClientInfo *client, int lobby_id);
+void log_event(const char *category, const char *format, ...);
+int generate_session_token(char *buffer, size_t length);
+long long get_current_time_ms();
+
+// --- Enhanced User Struct (Database) ---
+typedef struct {
+    int id;                                  // Primary key from database
+    char username[MAX_USERNAME];             // Immutable unique identifier
+    char display_name[MAX_DISPLAY_NAME];     // Mutable display name
+    char email[MAX_EMAIL];                   // For login and verification
+    int elo_rating;                          // ELO ranking
+    char session_token[64];                  // Session token
+    int is_online;                           // Current online status
+    int lobby_id;                            // Current lobby (-1 if none)
+} User;
+
+// --- Database Functions (SQLite3) ---
+int db_init();                               // Initialize SQLite database
+void db_close();                             // Close database connection
+int db_check_registration(const char *username, const char *email, const char *password);
+int db_insert_user(const char *username, const char *email, const char *hash, const char *salt,
+                   int *out_user_id);
+int db_get_login(const char *identifier, User *out_user, char *hash, char *salt);
+void db_touch_login(const User *user);
+int db_update_display_name(int user_id, const char *new_display_name);
+int db_get_user_by_id(int user_id, User *out_user);
+int db_find_user_by_display_name(const char *display_name, User *out_user);
+int db_open_connection(sqlite3 **out);
+
+// --- Prepared Statements (db_stmt.c) ---
+typedef enum {
+    STMT_USER_EXISTS_USERNAME,
+    STMT_USER_EXISTS_EMAIL,
+    STMT_USER_INSERT,
+    STMT_STATS_INSERT,
+    STMT_USER_LOGIN,
+    STMT_USER_TOUCH_LOGIN,
+    STMT_USER_SET_PASSWORD,
+    STMT_USER_SET_DISPLAY_NAME,
+    STMT_USER_BY_ID,
+    STMT_USER_BY_DISPLAY_NAME,
+    STMT_SESSION_LOAD,
+    STMT_SESSION_INSERT,
+    STMT_SESSION_DELETE,
+    STMT_SESSION_SWEEP,
+    STMT_BEGIN,
+    STMT_COMMIT,
+    STMT_ROLLBACK,
+    STMT_MATCH_INSERT,
+    STMT_STATS_ADD_MATCH,
+    STMT_MATCH_PLAYER_INSERT,
+    STMT_ROLLUP_DAY_ADD,
+    STMT_ROLLUP_MODE_ADD,
+    STMT_PROFILE,
+    STMT_MATCH_HISTORY_PAGE,
+    STMT_ROLLUP_BY_MODE,
+    STMT_ROLLUP_RECENT,
+    STMT_LEADERBOARD_LOAD,
+    STMT_USER_SET_ELO,
+    STMT_ELO_RATING,
+    STMT_ELO_REPLAY_USERS,
+    STMT_ELO_REPLAY_MATCHES,
+    STMT_ELO_REPLAY_SET_CHANGE,
+    STMT_FRIEND_LOAD,
+    STMT_FRIEND_INSERT,
+    STMT_FRIEND_ACCEPT,
+    STMT_FRIEND_DECLINE,
+    STMT_FRIEND_REMOVE,
+    STMT_COUNT
+} StmtId;
+
+// One per connection; a statement belongs to the connection it was prepared on
+typedef struct {
+    sqlite3 *conn;
+    sqlite3_stmt *stmts[STMT_COUNT];
+    long long calls[STMT_COUNT];
+    long long total_ns[STMT_COUNT];     // Acquire to release, summed
+    long long started_ns[STMT_COUNT];
+} StmtRegistry;
+
+extern StmtRegistry db_stmts;           // Registry for the main connection (database.c)
+
+int stmt_registry_open(StmtRegistry *reg, sqlite3 *conn);
+void stmt_registry_close(StmtRegistry *reg);
+sqlite3_stmt* stmt_acquire(StmtRegistry *reg, StmtId id);
+void stmt_release(StmtRegistry *reg, StmtId id);
+void stmt_registry_report(StmtRegistry *reg, const char *label);
+
+// --- SHA-256 (sha256.c) ---
+#define SHA256_SIZE 32
+
+typedef struct {
+    uint32_t h[8];
+    uint64_t length;           // Bytes hashed so far
+    uint8_t buf[64];
+    size_t used;
+} Sha256;
+
+void sha256_init(Sha256 *ctx);
+void sha256_update(Sha256 *ctx, const void *data, size_t len);
+void sha256_final(Sha256 *ctx, uint8_t out[SHA256_SIZE]);
+void sha256(const void *data, size_t len, uint8_t out[SHA256_SIZE]);
+
+// --- Password Hashing (password.c) ---
+// scrypt cost for new hashes: 128 * r * 2^ln bytes (16 MiB) per hash
+#define PASSWORD_SCRYPT_LOG_N 14
+#define PASSWORD_SCRYPT_R 8
+#define PASSWORD_SCRYPT_P 1
+#define PASSWORD_KEY_SIZE 32
+#define PASSWORD_SALT_SIZE 32
+#define PASSWORD_HASH_SIZE 128     // "$scrypt$ln=..,r=..,p=..$" + hex key
+
+int scrypt_kdf(const void *pw, size_t pw_len, const void *salt, size_t salt_len,
+               int log_n, int r, int p, uint8_t *out, size_t out_len);
+void generate_salt(char *salt, size_t len);
+int password_hash(const char *password, const char *salt, char *out, size_t size);
+int password_verify(const char *password, const char *salt, const char *stored, int *needs_rehash);
+
+// --- Database Writer Thread (db_writer.c) ---
+// Writes that would stall the main loop (each autocommit fsyncs) are queued
+// to a dedicated thread with its own connection. Finished jobs come back
+// through db_writer_fd() and their callbacks run on the main loop.
+#define DB_QUEUE_SIZE 256
+
+typedef enum {
+    DB_JOB_MATCH_COMMIT,       // Rate and record a finished match (stats_commit_match)
+    DB_JOB_SESSION_SAVE,       // Write-through from the session store
+    DB_JOB_SESSION_DELETE,
+    DB_JOB_SESSION_SWEEP,      // Delete every session expired by expires_at
+    DB_JOB_PASSWORD_UPDATE     // Store a rehashed password
+} DbJobType;
+
+typedef struct {
+    int user_id;
+    char hash[PASSWORD_HASH_SIZE];
+    char salt[PASSWORD_SALT_SIZE];
+} DbPasswordJob;
+
+typedef struct {
+    uint8_t token_hash[SHA256_SIZE];
+    int user_id;
+    long long expires_at;      // Unix time
+} DbSessionJob;
+
+typedef struct {
+    int lobby_id;
+    uint64_t seed;             // Identifies the match; the lobby may have moved on
+    int num_players;
+    int player_ids[MAX_LOBBY_PLAYERS];
+    int placements[MAX_LOBBY_PLAYERS];
+    int kills[MAX_LOBBY_PLAYERS];
+    int bombs_planted[MAX_LOBBY_PLAYERS];
+    int walls_destroyed[MAX_LOBBY_PLAYERS];
+    int winner_id;
+    int duration_seconds;
+    int game_mode;
+    int rated;                 // Out: ratings were updated
+    int elo_changes[MAX_LOBBY_PLAYERS];  // Out
+    int new_ratings[MAX_LOBBY_PLAYERS];  // Out, when rated
+    int match_id;                        // Out
+} DbMatchJob;
+
+typedef struct DbJob DbJob;
+typedef void (*DbJobCallback)(DbJob *job);
+
+struct DbJob {
+    DbJobType type;
+    int result;                // 0 on success, -1 on failure
+    DbJobCallback on_done;     // Runs on the main loop; NULL = fire and forget
+    union {
+        DbMatchJob match;
+        DbSessionJob session;
+        DbPasswordJob password;
+    } data;
+};
+
+int db_writer_start();
+int db_writer_fd();
+void db_writer_submit(const DbJob *job);
+void db_writer_dispatch();
+void db_writer_stop();
+int db_update_password(StmtRegistry *reg, const DbPasswordJob *job);  // database.c
+
+// --- Session Tokens (session_store.c) ---
+#define SESSION_TTL_SECONDS (30 * 24 * 3600)
+#define SESSION_SWEEP_SECONDS 600
+#define SESSION_MIN_SLOTS 1024
+
+int session_store_load();
+void session_store_free();
+int session_issue(int user_id, char *out_token, size_t size);
+int session_resolve(const char *token);
+void session_revoke(const char *token);
+void session_store_sweep();
+int session_db_apply(StmtRegistry *reg, DbJobType type, const DbSessionJob *s);
+
+// --- Auth Worker Pool (auth_pool.c) ---
+// Password hashing runs here; results come back through auth_pool_fd()
+// and their callbacks run on the main loop.
+#define AUTH_WORKERS 2
+#define AUTH_QUEUE_SIZE 64        // Jobs in flight before new logins get "busy"
+
+typedef enum {
+    AUTH_JOB_HASH,             // Registration: hash 'password' with 'salt'
+    AUTH_JOB_VERIFY            // Login: check 'password' against 'hash'
+} AuthJobType;
+
+typedef struct AuthJob AuthJob;
+typedef void (*AuthJobCallback)(AuthJob *job);
+
+struct AuthJob {
+    AuthJobType type;
+    int socket_fd;
+    unsigned int ticket;           // Matches ClientInfo.auth_ticket while the client waits
+    User user;                     // Login: account being checked
+    char username[MAX_USERNAME];   // Registration: account to create
+    char email[MAX_EMAIL];
+    char password[MAX_PASSWORD];   // Wiped once hashed
+    char salt[PASSWORD_SALT_SIZE];
+    char hash[PASSWORD_HASH_SIZE]; // Login: stored hash in. Out: new hash
+    int result;                    // Out: AUTH_SUCCESS, AUTH_WRONG_PASSWORD or AUTH_FAILED
+    int rehashed;                  // Out: login upgraded 'hash' and 'salt'
+    AuthJobCallback on_done;       // Runs on the main loop
+};
+
+int auth_pool_start(int count);
+int auth_pool_fd();
+int auth_pool_submit(const AuthJob *job);
+void auth_pool_dispatch();
+int auth_pool_pending();
+void auth_pool_stop();
+
+// --- Lobby Functions ---
+// Lobby ids are handles: slot index in the low bits, generation above
+#define LOBBY_SLOT_BITS 16
+#define LOBBY_MAX_SLOTS (1 << LOBBY_SLOT_BITS)
+#define LOBBY_MAX_GENERATION ((1 << (31 - LOBBY_SLOT_BITS)) - 1)
+
+void init_lobbies();
+void free_lobbies();
+int create_lobby(const char *room_name, const char *host_username, int is_private, const char *access_code, int game_mode, int tick_rate);
+int join_lobby(int lobby_id, const char *username);
+int join_lobby_with_code(int lobby_id, const char *username, const char *access_code);
+int leave_lobby(int lobby_id, const char *username);
+int toggle_ready(int lobby_id, const char *username);
+int start_game(int lobby_id, const char *username);
+int get_lobby_list(LobbySummary *out_lobbies);
+Lobby* find_lobby(int lobby_id);
+ActiveGame* lobby_game(int lobby_id);
+LobbyChat* lobby_chat(int lobby_id);
+int lobby_count();
+Lobby* lobby_at(int index);
+void lobby_summarize(const Lobby *lobby, LobbySummary *out);
+void lobby_summary_changed(int lobby_id);
+int lobby_browse(int filters, int game_mode, int sort, uint64_t cursor,
+                 LobbySummary *out, int max_count, int *total, uint64_t *next_cursor);
+int find_user_lobby(const char *username);
+int join_spectator(int lobby_id, const char *username);
+int leave_spectator(int lobby_id, const char *username);
+
+// --- Lobby List Feed (lobby_feed.c) ---
+#define LOBBY_FEED_LOG 256         // Recent deltas kept to catch subscribers up
+
+void lobby_feed_publish(int op, const Lobby *lobby);
+void lobby_feed_subscribe(ClientInfo *client, uint32_t known_version);
+void lobby_feed_unsubscribe(ClientInfo *client);
+void lobby_feed_report();
+
+// --- Map Generation ---
+void init_map(GameWorld *state);
+void map_spawn_point(GameWorld *state, int count, int index, int *x, int *y);
+
+// --- Game Logic Functions ---
+void init_game(ActiveGame *game, Lobby *lobby);
+void update_game(ActiveGame *game);
+int handle_move(ActiveGame *game, int player_id, int direction);
+void move_players(ActiveGame *game, int *move_results);
+int plant_bomb(ActiveGame *game, int player_id);
+void grid_build(GameWorld *state);
+int grid_query(GameWorld *state, int x0, int y0, int x1, int y1, int *out, int max_out);
+void encode_view(GameWorld *state, int player_id, GameState *out);
+void encode_game_snapshot(GameWorld *state, GameSnapshot *out);
+int game_queue_input(ActiveGame *game, int player_id, int type, int data);
+void run_game_tick(void *arg);
+GameSnapshot* game_peek_snapshot(ActiveGame *game);
+void game_release_snapshot(ActiveGame *game);
+int game_pipeline_init();
+int game_pipeline_fd();
+void game_pipeline_drain_fd();
+void game_wait_idle(ActiveGame *game);
+
+// --- Randomness (rng.c) ---
+void rng_seed(GameRng *rng, uint64_t seed);
+uint64_t rng_next(GameRng *rng);
+int rng_range(GameRng *rng, int n);
+int secure_random_bytes(void *buf, size_t len);
+int secure_random_string(char *out, size_t length, const char *charset, size_t charset_len);
+
+// --- Tick Scheduler (fixed-step, timerfd driven) ---
+#define DEFAULT_TICK_RATE 20     // Hz
+#define MIN_TICK_RATE 10
+#define MAX_TICK_RATE 60
+#define MAX_CATCHUP_TICKS 5      // Steps run back-to-back after a stall before skipping
+
+typedef struct {
+    long long ticks_run;
+    long long late_ticks;        // Catch-up steps run after their deadline had passed
+    long long skipped_ticks;     // Steps dropped because they exceeded the catch-up cap
+} TickStats;
+
+// Per-lobby timing, kept in the lobby's registry slot
+typedef struct {
+    int active;
+    int tick_rate;               // Ticks per second
+    long long start_ms;          // Tick n is due at start_ms + n * 1000 / tick_rate
+    long long next_tick;         // Index of the next tick to run
+    long long next_tick_ms;      // Deadline of next_tick
+    TickStats stats;
+} TickSchedule;
+
+typedef struct {
+    int lobby_id;
+    int steps;
+} TickDue;
+
+TickSchedule* lobby_schedule(int lobby_id);  // lobby_manager.c
+
+int tick_scheduler_init();
+int tick_scheduler_fd();
+int tick_scheduler_clamp_rate(int tick_rate);
+void tick_scheduler_start(int lobby_id, int tick_rate, long long now_ms);
+void tick_scheduler_stop(int lobby_id);
+int tick_scheduler_collect(long long now_ms, TickDue **out);
+void tick_scheduler_skip(int lobby_id, int steps);
+int tick_scheduler_running(const int **out);
+void tick_scheduler_arm();
+int tick_scheduler_get_stats(int lobby_id, TickStats *out);
+void tick_scheduler_free();
+
+// --- Worker Pool (work-stealing, used for lobby ticks) ---
+typedef void (*WorkerTaskFn)(void *arg);
+typedef struct WorkerPool WorkerPool;
+int worker_pool_default_threads();
+WorkerPool* worker_pool_create(int num_threads);
+int worker_pool_size(WorkerPool *pool);
+void worker_pool_submit(WorkerPool *pool, WorkerTaskFn fn, void *arg);
+void worker_pool_wait(WorkerPool *pool);
+void worker_pool_destroy(WorkerPool *pool);
+
+// --- Friend System Functions ---
+int friend_graph_load();
+void friend_graph_free();
+void presence_set(int user_id, int socket_fd, int lobby_id);
+void presence_clear(int user_id, int socket_fd);
+int presence_socket(int user_id);
+int presence_of(int user_id);
+int friend_send_request(int sender_id, const char *target_display_name);
+int friend_accept_request(int user_id, int requester_id);
+int friend_decline_request(int user_id, int requester_id);
+int friend_remove(int user_id, int friend_id);
+int friend_get_list(int user_id, FriendInfo *out_friends, int max_count);
+int friend_get_pending_requests(int user_id, FriendInfo *out_requests, int max_count);
+int friend_get_sent_requests(int user_id, FriendInfo *out_requests, int max_count);
+
+// --- ELO System Functions ---
+int get_k_factor(int matches_played);
+int elo_calculate_change(int my_elo, int opp_elo, int win);
+void elo_rate_match(const int *ratings, const int *match_counts, const int *placements,
+                    int num_players, int *out_elo_changes, int *out_new_ratings);
+void elo_compute_match(const int *player_ids, const int *ratings, const int *match_counts,
+                       const int *placements, int num_players,
+                       int *out_elo_changes, int *out_new_ratings);
+int get_tier(int elo_rating);
+const char* get_tier_name(int tier);
+int elo_recompute(int dry_run);
+
+// --- Statistics Functions ---
+int stats_commit_match(StmtRegistry *reg, DbMatchJob *m);
+int stats_get_profile(int user_id, ProfileData *out_profile);
+int stats_get_profile_detail(int user_id, ProfileDetail *out);
+int stats_rebuild_rollups();
+int stats_get_match_history(int user_id, uint64_t cursor, MatchHistoryEntry *out, int max_count,
+                            uint64_t *next_cursor);
+
+// --- Response Cache (response_cache.c) ---
+// Encoded responses shared by every requester; write paths invalidate
+#define CACHE_SLOTS 256
+#define CACHE_ALL_KEYS -1
+
+typedef enum {
+    CACHE_LEADERBOARD,         // key 0
+    CACHE_LOBBY_LIST,          // key 0
+    CACHE_PROFILE,             // key = user id
+    CACHE_ENDPOINTS
+} CacheEndpoint;
+
+int response_cache_send(int socket_fd, CacheEndpoint ep, int key);
+void response_cache_store(CacheEndpoint ep, int key, const ServerPacket *packet);
+void response_cache_invalidate(CacheEndpoint ep, int key);
+void response_cache_report();
+void response_cache_free();
+
+// --- Leaderboard Index (leaderboard.c) ---
+int leaderboard_load();
+void leaderboard_free();
+void leaderboard_set(int user_id, const char *display_name, int elo_rating, int wins);
+void leaderboard_update(int user_id, int elo_rating, int wins_delta);
+void leaderboard_refresh_user(int user_id);
+int leaderboard_size();
+int leaderboard_top(LeaderboardEntry *out, int max_count);
+int leaderboard_rank(int user_id, LeaderboardEntry *out);
+int leaderboard_lookup(int user_id, LeaderboardEntry *out);
+int leaderboard_around(int user_id, int radius, LeaderboardEntry *out, int max_count);
+
+// --- Display Name Search (name_index.c) ---
+void name_index_set(int user_id, const char *display_name);
+int name_index_search(const char *query, UserSearchResult *out, int max_count);
+int name_index_size();
+void name_index_free();
+
+// --- Quick Play Matchmaking (matchmaking.c) ---
+// Waiting players are bucketed by rating per game mode. The window around a
+// player's rating widens the longer they wait, and the match size they will
+// settle for shrinks from MAX_CLIENTS towards 2.
+#define MM_BUCKET_WIDTH 50         // Rating points per bucket
+#define MM_NUM_BUCKETS 64          // Ratings past the last bucket share it
+#define MM_BASE_WINDOW 100         // Rating +/- accepted on joining
+#define MM_WIDEN_PER_SECOND 25
+#define MM_MAX_WINDOW 1000
+#define MM_SHRINK_SECONDS 15       // Settle for one player fewer every 15 s
+#define MM_SWEEP_MS 1000           // Re-match waiting players this often
+#define MM_WAIT_SAMPLES 1024       // Recent queue times kept per mode
+#define MM_REPORT_SECONDS 300
+
+int matchmaking_enqueue(ClientInfo *client, int game_mode);
+void matchmaking_cancel(ClientInfo *client);
+void matchmaking_sweep();
+int matchmaking_timeout_ms();
+void matchmaking_report();
+
+// --- Network Functions ---
+// --- Network Functions ---
+int init_server_socket();
+
+// --- Packet Handlers ---
+void handle_register(int socket_fd, ClientPacket *pkt);
+void handle_login(int socket_fd, ClientPacket *pkt);
+void handle_login_with_token(int socket_fd, ClientPacket *pkt);
+
+void handle_create_lobby(int socket_fd, ClientPacket *pkt);
+void handle_join_lobby(int socket_fd, ClientPacket *pkt);
+void handle_leave_lobby(int socket_fd, ClientPacket *pkt);
+void handle_list_lobbies(int socket_fd, ClientPacket *pkt);
+void handle_lobby_subscribe(int socket_fd, ClientPacket *pkt);
+void handle_lobby_unsubscribe(int socket_fd, ClientPacket *pkt);
+void handle_browse_lobbies(int socket_fd, ClientPacket *pkt);
+void handle_spectate(int socket_fd, ClientPacket *pkt);
+void handle_ready(int socket_fd, ClientPacket *pkt);
+void handle_start_game(int socket_fd, ClientPacket *pkt);
+void handle_queue_join(int socket_fd, ClientPacket *pkt);
+void handle_queue_leave(int socket_fd, ClientPacket *pkt);
+
+void handle_game_move(int socket_fd, ClientPacket *pkt);
+void handle_plant_bomb(int socket_fd, ClientPacket *pkt);
+void handle_leave_game(int socket_fd, ClientPacket *pkt);
+void forfeit_player_from_game(int lobby_id, const char *username);
+
+void handle_chat(int socket_fd, ClientPacket *pkt);
+void send_chat_backlog(ClientInfo *client);
+
+void handle_friend_request(int socket_fd, ClientPacket *pkt);
+void handle_friend_accept(int socket_fd, ClientPacket *pkt);
+void handle_friend_reject(int socket_fd, ClientPacket *pkt);
+void handle_friend_remove(int socket_fd, ClientPacket *pkt);
+void handle_friend_list(int socket_fd, ClientPacket *pkt);
+void handle_get_profile(int socket_fd, ClientPacket *pkt);
+void handle_get_leaderboard(int socket_fd, ClientPacket *pkt);
+void handle_get_my_rank(int socket_fd, ClientPacket *pkt);
+void handle_get_leaderboard_around(int socket_fd, ClientPacket *pkt);
+void handle_get_match_history(int socket_fd, ClientPacket *pkt);
+void handle_get_profile_detail(int socket_fd, ClientPacket *pkt);
+void handle_search_users(int socket_fd, ClientPacket *pkt);
+void handle_invite(int socket_fd, ClientPacket *pkt);
+
 #endif
\ No newline at end of file
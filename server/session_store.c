@@ -0,0 +1,226 @@
+/* server/session_store.c - Login tokens: in-memory index over the Sessions table */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sqlite3.h>
+#include "server.h"
+
+// Tokens are only ever stored as SHA-256 digests, so neither this table nor
+// the database holds anything a client could log in with. Lookups hit an
+// open-addressing hash table keyed by the digest; every change is written
+// through to SQLite on the DB writer thread. Main loop only.
+typedef struct {
+    uint8_t hash[SHA256_SIZE];
+    int user_id;               // 0 = empty, -1 = deleted
+    long long expires_at;      // Unix time
+} SessionSlot;
+
+#define SLOT_EMPTY 0
+#define SLOT_DELETED -1
+
+static SessionSlot *slots = NULL;
+static size_t capacity = 0;    // Power of two
+static size_t live = 0;        // Sessions in the table
+static size_t occupied = 0;    // Live + deleted; drives rehashing
+static long long last_sweep = 0;
+
+// Digests are uniform, so their first bytes are already a good hash
+static size_t home_slot(const uint8_t *hash) {
+    uint64_t h;
+    memcpy(&h, hash, sizeof(h));
+    return (size_t)h & (capacity - 1);
+}
+
+static SessionSlot* find_slot(const uint8_t *hash) {
+    if (capacity == 0) return NULL;
+    for (size_t i = home_slot(hash), n = 0; n < capacity; i = (i + 1) & (capacity - 1), n++) {
+        SessionSlot *s = &slots[i];
+        if (s->user_id == SLOT_EMPTY) return NULL;
+        if (s->user_id != SLOT_DELETED && memcmp(s->hash, hash, SHA256_SIZE) == 0) return s;
+    }
+    return NULL;
+}
+
+static void insert_slot(const uint8_t *hash, int user_id, long long expires_at);
+
+static int rehash(size_t new_capacity) {
+    SessionSlot *old = slots;
+    size_t old_capacity = capacity;
+
+    slots = calloc(new_capacity, sizeof(SessionSlot));
+    if (!slots) {
+        slots = old;
+        return -1;
+    }
+    capacity = new_capacity;
+    live = 0;
+    occupied = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i].user_id > 0) insert_slot(old[i].hash, old[i].user_id, old[i].expires_at);
+    }
+    free(old);
+    return 0;
+}
+
+static void insert_slot(const uint8_t *hash, int user_id, long long expires_at) {
+    // Keep probes short: at most 70% of slots in use, deleted ones included
+    if ((occupied + 1) * 10 > capacity * 7) {
+        size_t grown = (live + 1) * 10 > capacity * 5 ? capacity * 2 : capacity;
+        if (rehash(grown ? grown : SESSION_MIN_SLOTS) != 0) {
+            fprintf(stderr, "[SESSION] Out of memory growing token table\n");
+            return;
+        }
+    }
+
+    SessionSlot *s = find_slot(hash);
+    if (!s) {
+        size_t i = home_slot(hash);
+        while (slots[i].user_id > 0) i = (i + 1) & (capacity - 1);
+        s = &slots[i];
+        if (s->user_id == SLOT_EMPTY) occupied++;
+        live++;
+        memcpy(s->hash, hash, SHA256_SIZE);
+    }
+    s->user_id = user_id;
+    s->expires_at = expires_at;
+}
+
+static void delete_slot(SessionSlot *s) {
+    s->user_id = SLOT_DELETED;
+    live--;
+}
+
+static void submit(DbJobType type, const uint8_t *hash, int user_id, long long expires_at) {
+    DbJob job;
+    memset(&job, 0, sizeof(job));
+    job.type = type;
+    if (hash) memcpy(job.data.session.token_hash, hash, SHA256_SIZE);
+    job.data.session.user_id = user_id;
+    job.data.session.expires_at = expires_at;
+    db_writer_submit(&job);
+}
+
+// Load unexpired sessions. Call once after db_init().
+int session_store_load() {
+    if (rehash(SESSION_MIN_SLOTS) != 0) return -1;
+    last_sweep = time(NULL);
+
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_SESSION_LOAD);
+    sqlite3_bind_int64(stmt, 1, last_sweep);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (sqlite3_column_bytes(stmt, 0) != SHA256_SIZE) continue;
+        insert_slot(sqlite3_column_blob(stmt, 0), sqlite3_column_int(stmt, 1),
+                    sqlite3_column_int64(stmt, 2));
+    }
+    stmt_release(&db_stmts, STMT_SESSION_LOAD);
+
+    if (rc != SQLITE_DONE) {
+        fprintf(stderr, "[SESSION] Failed to load sessions: %s\n", sqlite3_errmsg(db_stmts.conn));
+        return -1;
+    }
+    printf("[SESSION] Token store loaded: %zu active sessions\n", live);
+    return 0;
+}
+
+void session_store_free() {
+    free(slots);
+    slots = NULL;
+    capacity = live = occupied = 0;
+}
+
+// Start a session: writes a fresh token for the client into out_token
+// (size bytes, NUL-terminated) and remembers only its digest. Returns -1,
+// storing nothing, if no token could be generated.
+int session_issue(int user_id, char *out_token, size_t size) {
+    uint8_t hash[SHA256_SIZE];
+    if (generate_session_token(out_token, size) != 0) return -1;
+    sha256(out_token, strlen(out_token), hash);
+
+    long long expires_at = (long long)time(NULL) + SESSION_TTL_SECONDS;
+    insert_slot(hash, user_id, expires_at);
+    submit(DB_JOB_SESSION_SAVE, hash, user_id, expires_at);
+    return 0;
+}
+
+// User id behind a token, or -1 if it is unknown or expired
+int session_resolve(const char *token) {
+    uint8_t hash[SHA256_SIZE];
+    if (token[0] == '\0') return -1;
+    sha256(token, strlen(token), hash);
+
+    SessionSlot *s = find_slot(hash);
+    if (!s) return -1;
+    if (s->expires_at <= time(NULL)) {
+        delete_slot(s);
+        submit(DB_JOB_SESSION_DELETE, hash, 0, 0);
+        return -1;
+    }
+    return s->user_id;
+}
+
+// End a session (the token was rotated or the user logged out)
+void session_revoke(const char *token) {
+    uint8_t hash[SHA256_SIZE];
+    sha256(token, strlen(token), hash);
+
+    SessionSlot *s = find_slot(hash);
+    if (!s) return;
+    delete_slot(s);
+    submit(DB_JOB_SESSION_DELETE, hash, 0, 0);
+}
+
+// Drop expired sessions every SESSION_SWEEP_SECONDS. The table scan is cheap;
+// the DELETE runs on the writer thread.
+void session_store_sweep() {
+    long long now = time(NULL);
+    if (now - last_sweep < SESSION_SWEEP_SECONDS) return;
+    last_sweep = now;
+
+    size_t expired = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        if (slots[i].user_id > 0 && slots[i].expires_at <= now) {
+            delete_slot(&slots[i]);
+            expired++;
+        }
+    }
+    submit(DB_JOB_SESSION_SWEEP, NULL, 0, now);
+    if (expired > 0) {
+        printf("[SESSION] Swept %zu expired sessions (%zu active)\n", expired, live);
+    }
+}
+
+// Writer thread side of the jobs above
+int session_db_apply(StmtRegistry *reg, DbJobType type, const DbSessionJob *s) {
+    sqlite3_stmt *stmt;
+    StmtId id;
+    switch (type) {
+        case DB_JOB_SESSION_SAVE:
+            id = STMT_SESSION_INSERT;
+            stmt = stmt_acquire(reg, id);
+            sqlite3_bind_blob(stmt, 1, s->token_hash, SHA256_SIZE, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 2, s->user_id);
+            sqlite3_bind_int64(stmt, 3, s->expires_at);
+            break;
+        case DB_JOB_SESSION_DELETE:
+            id = STMT_SESSION_DELETE;
+            stmt = stmt_acquire(reg, id);
+            sqlite3_bind_blob(stmt, 1, s->token_hash, SHA256_SIZE, SQLITE_STATIC);
+            break;
+        case DB_JOB_SESSION_SWEEP:
+            id = STMT_SESSION_SWEEP;
+            stmt = stmt_acquire(reg, id);
+            sqlite3_bind_int64(stmt, 1, s->expires_at);
+            break;
+        default:
+            return -1;
+    }
+    int rc = sqlite3_step(stmt);
+    stmt_release(reg, id);
+    if (rc != SQLITE_DONE) {
+        fprintf(stderr, "[SESSION] Write failed: %s\n", sqlite3_errmsg(reg->conn));
+        return -1;
+    }
+    return 0;
+}
@@ -2,110 +2,145 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <sqlite3.h>
 #include "../common/protocol.h"
 #include "server.h"
 
-extern sqlite3 *db;
+// Step a statement that returns no rows and hand it back
+static int step_done(StmtRegistry *reg, StmtId id) {
+    int rc = sqlite3_step(reg->stmts[id]);
+    stmt_release(reg, id);
+    return rc == SQLITE_DONE;
+}
 
-// Record match completion and update statistics
-int stats_record_match(int *player_ids, int *placements, int *kills, 
-                       int num_players, int winner_id, int duration_seconds) {
-    // Insert match history
+// Everything a finished match changes, in one transaction: MatchHistory,
+// per-player MatchPlayers rows with their ELO change, Statistics and the new
+// ratings. One fsync per match, and a crash never leaves it half recorded.
+// Fills m->elo_changes, m->new_ratings and m->rated; returns the match id,
+// or -1 when nothing was written.
+int stats_commit_match(StmtRegistry *reg, DbMatchJob *m) {
+    int n = m->num_players;
+    int ratings[MAX_LOBBY_PLAYERS];
+    int match_counts[MAX_LOBBY_PLAYERS];
     sqlite3_stmt *stmt;
-    const char *match_sql = 
-        "INSERT INTO MatchHistory (winner_id, duration_seconds, num_players) "
-        "VALUES (?, ?, ?)";
     
-    if (sqlite3_prepare_v2(db, match_sql, -1, &stmt, NULL) != SQLITE_OK) {
-        fprintf(stderr, "[STATS] Prepare failed: %s\n", sqlite3_errmsg(db));
+    // IMMEDIATE: take the write lock now, so the ratings read below can't
+    // change before they are written back
+    stmt_acquire(reg, STMT_BEGIN);
+    if (!step_done(reg, STMT_BEGIN)) {
+        fprintf(stderr, "[STATS] Cannot begin match commit: %s\n", sqlite3_errmsg(reg->conn));
         return -1;
     }
     
-    if (winner_id >= 0) {
-        sqlite3_bind_int(stmt, 1, player_ids[winner_id]);
+    // Get current ratings and match counts; every player must have an account
+    m->rated = (n >= 2);
+    for (int i = 0; i < n && m->rated; i++) {
+        stmt = stmt_acquire(reg, STMT_ELO_RATING);
+        sqlite3_bind_int(stmt, 1, m->player_ids[i]);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            ratings[i] = sqlite3_column_int(stmt, 0);
+            match_counts[i] = sqlite3_column_int(stmt, 1);
+        } else {
+            m->rated = 0;
+        }
+        stmt_release(reg, STMT_ELO_RATING);
+    }
+    
+    if (m->rated) {
+        elo_compute_match(m->player_ids, ratings, match_counts, m->placements, n,
+                          m->elo_changes, m->new_ratings);
     } else {
-        sqlite3_bind_null(stmt, 1);  // Draw
+        memset(m->elo_changes, 0, sizeof(m->elo_changes));
     }
-    sqlite3_bind_int(stmt, 2, duration_seconds);
-    sqlite3_bind_int(stmt, 3, num_players);
     
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
-        sqlite3_finalize(stmt);
-        return -1;
+    // Insert match history
+    stmt = stmt_acquire(reg, STMT_MATCH_INSERT);
+    if (m->winner_id >= 0) {
+        sqlite3_bind_int(stmt, 1, m->player_ids[m->winner_id]);
+    } else {
+        sqlite3_bind_null(stmt, 1);  // Draw
     }
-    sqlite3_finalize(stmt);
+    sqlite3_bind_int(stmt, 2, m->duration_seconds);
+    sqlite3_bind_int(stmt, 3, n);
+    sqlite3_bind_int(stmt, 4, m->game_mode);
+    if (!step_done(reg, STMT_MATCH_INSERT)) goto fail;
     
-    int match_id = (int)sqlite3_last_insert_rowid(db);
-    printf("[STATS] Recorded match %d (duration: %ds, players: %d)\n", 
-           match_id, duration_seconds, num_players);
+    int match_id = (int)sqlite3_last_insert_rowid(reg->conn);
     
     // Update each player's statistics
-    for (int i = 0; i < num_players; i++) {
-        int user_id = player_ids[i];
-        int won = (i == winner_id) ? 1 : 0;
-        int player_kills = kills[i];
-        int deaths = (placements[i] == 1) ? 0 : 1;  // Winner survives
-        
-        // Update Statistics table
-        const char *update_sql = 
-            "UPDATE Statistics SET "
-            "total_matches = total_matches + 1, "
-            "wins = wins + ?, "
-            "total_kills = total_kills + ?, "
-            "deaths = deaths + ? "
-            "WHERE user_id = ?";
+    for (int i = 0; i < n; i++) {
+        int user_id = m->player_ids[i];
+        int won = (i == m->winner_id) ? 1 : 0;
+        int deaths = (m->placements[i] == 1) ? 0 : 1;  // Winner survives
         
-        if (sqlite3_prepare_v2(db, update_sql, -1, &stmt, NULL) == SQLITE_OK) {
-            sqlite3_bind_int(stmt, 1, won);
-            sqlite3_bind_int(stmt, 2, player_kills);
-            sqlite3_bind_int(stmt, 3, deaths);
-            sqlite3_bind_int(stmt, 4, user_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+        if (m->rated) {
+            stmt = stmt_acquire(reg, STMT_USER_SET_ELO);
+            sqlite3_bind_int(stmt, 1, m->new_ratings[i]);
+            sqlite3_bind_int(stmt, 2, user_id);
+            if (!step_done(reg, STMT_USER_SET_ELO)) goto fail;
         }
         
-        // Insert into MatchPlayers (ELO change will be added separately)
-        const char *player_sql = 
-            "INSERT INTO MatchPlayers (match_id, user_id, placement, kills, deaths) "
-            "VALUES (?, ?, ?, ?, ?)";
+        stmt = stmt_acquire(reg, STMT_STATS_ADD_MATCH);
+        sqlite3_bind_int(stmt, 1, won);
+        sqlite3_bind_int(stmt, 2, m->kills[i]);
+        sqlite3_bind_int(stmt, 3, deaths);
+        sqlite3_bind_int(stmt, 4, m->bombs_planted[i]);
+        sqlite3_bind_int(stmt, 5, m->walls_destroyed[i]);
+        sqlite3_bind_int(stmt, 6, user_id);
+        if (!step_done(reg, STMT_STATS_ADD_MATCH)) goto fail;
         
-        if (sqlite3_prepare_v2(db, player_sql, -1, &stmt, NULL) == SQLITE_OK) {
-            sqlite3_bind_int(stmt, 1, match_id);
-            sqlite3_bind_int(stmt, 2, user_id);
-            sqlite3_bind_int(stmt, 3, placements[i]);
-            sqlite3_bind_int(stmt, 4, player_kills);
+        stmt = stmt_acquire(reg, STMT_MATCH_PLAYER_INSERT);
+        sqlite3_bind_int(stmt, 1, match_id);
+        sqlite3_bind_int(stmt, 2, user_id);
+        sqlite3_bind_int(stmt, 3, m->placements[i]);
+        sqlite3_bind_int(stmt, 4, m->kills[i]);
+        sqlite3_bind_int(stmt, 5, deaths);
+        sqlite3_bind_int(stmt, 6, m->elo_changes[i]);
+        if (!step_done(reg, STMT_MATCH_PLAYER_INSERT)) goto fail;
+        
+        // Rollups: the match's day and game mode come from the row just written
+        if (user_id <= 0) continue;
+        StmtId rollups[2] = {STMT_ROLLUP_DAY_ADD, STMT_ROLLUP_MODE_ADD};
+        for (int r = 0; r < 2; r++) {
+            stmt = stmt_acquire(reg, rollups[r]);
+            sqlite3_bind_int(stmt, 1, user_id);
+            sqlite3_bind_int(stmt, 2, match_id);
+            sqlite3_bind_int(stmt, 3, won);
+            sqlite3_bind_int(stmt, 4, m->kills[i]);
             sqlite3_bind_int(stmt, 5, deaths);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            sqlite3_bind_int(stmt, 6, m->elo_changes[i]);
+            if (!step_done(reg, rollups[r])) goto fail;
         }
-        
-        printf("[STATS]   Player %d: Placement %d, Kills %d\n", 
-               user_id, placements[i], player_kills);
     }
     
+    stmt_acquire(reg, STMT_COMMIT);
+    if (!step_done(reg, STMT_COMMIT)) goto fail;
+    
+    printf("[STATS] Recorded match %d (duration: %ds, players: %d)\n", 
+           match_id, m->duration_seconds, n);
+    for (int i = 0; i < n; i++) {
+        printf("[STATS]   Player %d: Placement %d, Kills %d, ELO %+d\n", 
+               m->player_ids[i], m->placements[i], m->kills[i], m->elo_changes[i]);
+    }
     return match_id;
+    
+fail:
+    fprintf(stderr, "[STATS] Match commit failed, rolling back: %s\n", sqlite3_errmsg(reg->conn));
+    stmt_acquire(reg, STMT_ROLLBACK);
+    step_done(reg, STMT_ROLLBACK);
+    m->rated = 0;
+    memset(m->elo_changes, 0, sizeof(m->elo_changes));
+    return -1;
 }
 
 // Get user statistics
 int stats_get_profile(int user_id, ProfileData *out_profile) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT u.username, u.display_name, u.elo_rating, "
-        "       COALESCE(s.total_matches, 0), COALESCE(s.wins, 0), "
-        "       COALESCE(s.total_kills, 0), COALESCE(s.deaths, 0) "
-        "FROM Users u "
-        "LEFT JOIN Statistics s ON u.id = s.user_id "
-        "WHERE u.id = ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return -1;
-    }
-    
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_PROFILE);
     sqlite3_bind_int(stmt, 1, user_id);
     
     if (sqlite3_step(stmt) != SQLITE_ROW) {
-        sqlite3_finalize(stmt);
+        stmt_release(&db_stmts, STMT_PROFILE);
         return -1;
     }
     
@@ -124,67 +159,172 @@ int stats_get_profile(int user_id, ProfileData *out_profile) {
         out_profile->deaths = sqlite3_column_int(stmt, 6);
     }
     
-    sqlite3_finalize(stmt);
+    stmt_release(&db_stmts, STMT_PROFILE);
     return 0;
 }
 
-// Get top N players for leaderboard
-int stats_get_leaderboard(LeaderboardEntry *out_entries, int max_count) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "SELECT u.display_name, u.elo_rating, COALESCE(s.wins, 0) "
-        "FROM Users u "
-        "LEFT JOIN Statistics s ON u.id = s.user_id "
-        "ORDER BY u.elo_rating DESC "
-        "LIMIT ?";
-    
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
-        return 0;
-    }
-    
-    sqlite3_bind_int(stmt, 1, max_count);
+static void read_rollup(sqlite3_stmt *stmt, StatsRollup *out) {
+    out->matches = sqlite3_column_int(stmt, 1);
+    out->wins = sqlite3_column_int(stmt, 2);
+    out->kills = sqlite3_column_int(stmt, 3);
+    out->deaths = sqlite3_column_int(stmt, 4);
+    out->play_seconds = sqlite3_column_int(stmt, 5);
+    out->elo_change = sqlite3_column_int(stmt, 6);
+}
+
+// Profile plus per-mode totals and the last PROFILE_RECENT_DAYS days, read
+// from the rollup tables: a handful of primary-key rows, however many
+// matches the player has
+int stats_get_profile_detail(int user_id, ProfileDetail *out) {
+    memset(out, 0, sizeof(*out));
+    if (stats_get_profile(user_id, &out->profile) != 0) return -1;
     
-    int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_count) {
-        out_entries[count].rank = count + 1;
-        strncpy(out_entries[count].display_name, 
-                (const char *)sqlite3_column_text(stmt, 0), 
-                MAX_DISPLAY_NAME - 1);
-        out_entries[count].elo_rating = sqlite3_column_int(stmt, 1);
-        out_entries[count].wins = sqlite3_column_int(stmt, 2);
-        count++;
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_ROLLUP_BY_MODE);
+    sqlite3_bind_int(stmt, 1, user_id);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        int mode = sqlite3_column_int(stmt, 0);
+        if (mode >= 0 && mode < NUM_GAME_MODES) read_rollup(stmt, &out->by_mode[mode]);
     }
+    stmt_release(&db_stmts, STMT_ROLLUP_BY_MODE);
     
-    sqlite3_finalize(stmt);
-    printf("[STATS] Retrieved %d leaderboard entries\n", count);
-    return count;
+    int today = (int)(time(NULL) / 86400);
+    stmt = stmt_acquire(&db_stmts, STMT_ROLLUP_RECENT);
+    sqlite3_bind_int(stmt, 1, user_id);
+    sqlite3_bind_int(stmt, 2, today - PROFILE_RECENT_DAYS);
+    while (out->recent_count < PROFILE_RECENT_DAYS && sqlite3_step(stmt) == SQLITE_ROW) {
+        out->recent_days[out->recent_count] = sqlite3_column_int(stmt, 0);
+        read_rollup(stmt, &out->recent[out->recent_count]);
+        out->recent_count++;
+    }
+    stmt_release(&db_stmts, STMT_ROLLUP_RECENT);
+    return 0;
 }
 
-// Update bombs planted stat
-void stats_increment_bombs(int user_id) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "UPDATE Statistics SET bombs_planted = bombs_planted + 1 "
-        "WHERE user_id = ?";
+// Regenerate StatsDaily/StatsByMode from MatchHistory + MatchPlayers
+// (server_bin --rebuild-stats). One transaction; the tables are never seen
+// half built.
+int stats_rebuild_rollups() {
+    static const char *sql =
+        "BEGIN IMMEDIATE;"
+        "DELETE FROM StatsDaily;"
+        "DELETE FROM StatsByMode;"
+        "INSERT INTO StatsDaily (user_id, day, matches, wins, kills, deaths, play_seconds, elo_change) "
+        "SELECT mp.user_id, CAST(strftime('%s', mh.match_date) AS INTEGER) / 86400, COUNT(*), "
+        "       SUM(mh.winner_id IS mp.user_id), SUM(COALESCE(mp.kills, 0)), SUM(COALESCE(mp.deaths, 0)), "
+        "       SUM(COALESCE(mh.duration_seconds, 0)), SUM(COALESCE(mp.elo_change, 0)) "
+        "FROM MatchPlayers mp JOIN MatchHistory mh ON mh.id = mp.match_id "
+        "WHERE mp.user_id > 0 GROUP BY 1, 2;"
+        "INSERT INTO StatsByMode (user_id, game_mode, matches, wins, kills, deaths, play_seconds, elo_change) "
+        "SELECT mp.user_id, COALESCE(mh.game_mode, 0), COUNT(*), "
+        "       SUM(mh.winner_id IS mp.user_id), SUM(COALESCE(mp.kills, 0)), SUM(COALESCE(mp.deaths, 0)), "
+        "       SUM(COALESCE(mh.duration_seconds, 0)), SUM(COALESCE(mp.elo_change, 0)) "
+        "FROM MatchPlayers mp JOIN MatchHistory mh ON mh.id = mp.match_id "
+        "WHERE mp.user_id > 0 GROUP BY 1, 2;"
+        "COMMIT;";
     
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK) {
-        sqlite3_bind_int(stmt, 1, user_id);
-        sqlite3_step(stmt);
+    char *err_msg = NULL;
+    if (sqlite3_exec(db_stmts.conn, sql, NULL, NULL, &err_msg) != SQLITE_OK) {
+        fprintf(stderr, "[STATS] Rollup rebuild failed: %s\n", err_msg);
+        sqlite3_free(err_msg);
+        sqlite3_exec(db_stmts.conn, "ROLLBACK", NULL, NULL, NULL);
+        return -1;
+    }
+    
+    sqlite3_stmt *stmt;
+    int days = 0, modes = 0;
+    if (sqlite3_prepare_v2(db_stmts.conn,
+            "SELECT (SELECT COUNT(*) FROM StatsDaily), (SELECT COUNT(*) FROM StatsByMode)",
+            -1, &stmt, NULL) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            days = sqlite3_column_int(stmt, 0);
+            modes = sqlite3_column_int(stmt, 1);
+        }
         sqlite3_finalize(stmt);
     }
+    printf("[STATS] Rollups rebuilt: %d daily rows, %d per-mode rows\n", days, modes);
+    return 0;
 }
 
-// Update walls destroyed stat
-void stats_increment_walls(int user_id, int count) {
-    sqlite3_stmt *stmt;
-    const char *sql = 
-        "UPDATE Statistics SET walls_destroyed = walls_destroyed + ? "
-        "WHERE user_id = ?";
+// Match history cursor: format version in the top byte, a keyed check over
+// (player, match id) in the next 24 bits, the last match id sent in the low
+// 32. The key is drawn once per server run, so a cursor is only good for the
+// list it came from; forged, stale or other players' cursors are rejected
+// instead of seeking somewhere arbitrary, and the layout can change by
+// bumping the version.
+#define HISTORY_CURSOR_VERSION 1
+
+static uint64_t history_cursor_key;
+static int history_cursor_key_ready = 0;
+
+static uint32_t history_cursor_check(int user_id, uint32_t match_id) {
+    if (!history_cursor_key_ready) {
+        if (secure_random_bytes(&history_cursor_key, sizeof(history_cursor_key)) != 0) {
+            fprintf(stderr, "[STATS] No random cursor key, history cursors are unkeyed\n");
+        }
+        history_cursor_key_ready = 1;
+    }
+    // splitmix64 finaliser over key ^ (user, match)
+    uint64_t h = history_cursor_key ^ ((uint64_t)(uint32_t)user_id << 32 | match_id);
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return (uint32_t)h & 0xFFFFFF;
+}
+
+static uint64_t history_cursor_encode(int user_id, int match_id) {
+    return (uint64_t)HISTORY_CURSOR_VERSION << 56 |
+           (uint64_t)history_cursor_check(user_id, (uint32_t)match_id) << 32 |
+           (uint32_t)match_id;
+}
+
+// Match id the cursor continues after, or -1 if it isn't one of ours
+static int history_cursor_decode(int user_id, uint64_t cursor) {
+    uint32_t match_id = (uint32_t)cursor;
+    if (cursor >> 56 != HISTORY_CURSOR_VERSION || match_id > INT32_MAX) return -1;
+    if ((cursor >> 32 & 0xFFFFFF) != history_cursor_check(user_id, match_id)) return -1;
+    return (int)match_id;
+}
+
+// One page of a player's matches, newest first. 'cursor' is 0 for the first
+// page, else the next_cursor of the previous one. Match ids are handed out in
+// match_date order, so the id alone is the keyset: each page is one seek on
+// idx_match_players_user_match, however deep. Returns the number of entries,
+// or -1 for a cursor this server didn't issue for this player.
+int stats_get_match_history(int user_id, uint64_t cursor, MatchHistoryEntry *out, int max_count,
+                            uint64_t *next_cursor) {
+    *next_cursor = 0;
+    sqlite3_int64 before = INT64_MAX;
+    if (cursor != 0) {
+        int match_id = history_cursor_decode(user_id, cursor);
+        if (match_id < 0) return -1;
+        before = match_id;
+    }
+
+    sqlite3_stmt *stmt = stmt_acquire(&db_stmts, STMT_MATCH_HISTORY_PAGE);
+    sqlite3_bind_int(stmt, 1, user_id);
+    sqlite3_bind_int64(stmt, 2, before);
+    sqlite3_bind_int(stmt, 3, max_count + 1);  // One extra row says whether there is a next page
     
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK) {
-        sqlite3_bind_int(stmt, 1, count);
-        sqlite3_bind_int(stmt, 2, user_id);
-        sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+    int count = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (count == max_count) {
+            *next_cursor = history_cursor_encode(user_id, out[count - 1].match_id);
+            break;
+        }
+        MatchHistoryEntry *e = &out[count++];
+        memset(e, 0, sizeof(*e));
+        e->match_id = sqlite3_column_int(stmt, 0);
+        e->played_at = (uint32_t)sqlite3_column_int64(stmt, 1);
+        e->duration_seconds = (uint16_t)sqlite3_column_int(stmt, 2);
+        e->num_players = (uint8_t)sqlite3_column_int(stmt, 3);
+        e->won = (uint8_t)sqlite3_column_int(stmt, 4);
+        e->placement = (uint8_t)sqlite3_column_int(stmt, 5);
+        e->kills = (uint8_t)sqlite3_column_int(stmt, 6);
+        e->elo_change = (int16_t)sqlite3_column_int(stmt, 7);
     }
+    
+    stmt_release(&db_stmts, STMT_MATCH_HISTORY_PAGE);
+    return count;
 }
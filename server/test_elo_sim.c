@@ -1,81 +1,292 @@
+/* server/test_elo_sim.c - Monte Carlo simulator for the ELO system
+ *
+ * Build: make test_elo_sim
+ * Usage: ./test_elo_sim [players] [matches] [populations] [threads] [seed]
+ *
+ * Links the real server/elo_system.c, so it measures exactly what the server
+ * ships: edit get_k_factor() or elo_rate_match(), rebuild, rerun, compare.
+ *
+ * Each population gets 'players' accounts with a hidden true skill drawn from
+ * N(1200, 350), all starting at a rating of 1200. It then plays 'matches'
+ * matches of 2-4 randomly drawn players. A player's performance in a match is
+ * skill + Gumbel noise scaled to the ELO logistic, so any two players meet
+ * with exactly the win chance the formula assumes (and larger matches rank
+ * like Plackett-Luce). Populations are independent and spread over threads.
+ *
+ * Reported at matches-per-player checkpoints, averaged over populations:
+ *   rho     Spearman rank correlation of rating against true skill
+ *   error   mean |rating - skill|
+ *   drift   mean rating - 1200 (inflation; points are not zero-sum once
+ *           K differs between players, changes truncate and ratings floor at 0)
+ */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "../common/protocol.h"
+#include "server.h"
 
-// Copied from server/elo_system.c
+#define SIM_START_RATING 1200
+#define SIM_SKILL_SD 350.0
+#define SIM_MIN_PLAYERS 2
+#define SIM_MAX_PLAYERS 4
 
-int get_k_factor(int matches_played) {
-    if (matches_played < 10) return 40;
-    if (matches_played < 30) return 30;
-    return 20;
+static const int checkpoints[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000};
+#define NUM_CHECKPOINTS (int)(sizeof(checkpoints) / sizeof(checkpoints[0]))
+
+typedef struct {
+    double rho[NUM_CHECKPOINTS];
+    double error[NUM_CHECKPOINTS];
+    double drift[NUM_CHECKPOINTS];
+    int reached;               // Checkpoints this population got to
+} PopResult;
+
+static int num_players = 10000;
+static long long num_matches = 1000000;
+static int num_populations = 0;
+static uint64_t base_seed = 42;
+
+static PopResult *results;
+static int next_population = 0;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Uniform in (0, 1)
+static double uniform(GameRng *rng) {
+    return ((rng_next(rng) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double normal(GameRng *rng) {
+    return sqrt(-2.0 * log(uniform(rng))) * cos(2.0 * M_PI * uniform(rng));
+}
+
+// --- Spearman rank correlation ---
+
+typedef struct {
+    double key;
+    int index;
+} RankItem;
+
+static int cmp_rank_item(const void *a, const void *b) {
+    double x = ((const RankItem *)a)->key, y = ((const RankItem *)b)->key;
+    return (x > y) - (x < y);
 }
 
-double calculate_expected_score(int rating_a, int rating_b) {
-    return 1.0 / (1.0 + pow(10.0, (rating_b - rating_a) / 400.0));
+// Fractional ranks (ties share their mean rank); 'items' is scratch space
+static void rank_values(const double *values, double *ranks, RankItem *items, int n) {
+    for (int i = 0; i < n; i++) {
+        items[i].key = values[i];
+        items[i].index = i;
+    }
+    qsort(items, n, sizeof(RankItem), cmp_rank_item);
+    for (int i = 0; i < n;) {
+        int j = i + 1;
+        while (j < n && items[j].key == items[i].key) j++;
+        double rank = (i + j - 1) / 2.0;
+        for (int k = i; k < j; k++) ranks[items[k].index] = rank;
+        i = j;
+    }
 }
 
-int calculate_elo_change(int player_rating, int avg_opponent_rating, 
-                         int placement, int matches_played) {
-    double expected = calculate_expected_score(player_rating, avg_opponent_rating);
-    double actual = (placement == 1) ? 1.0 : 0.0;
-    
-    int k = get_k_factor(matches_played);
-    int change = (int)(k * (actual - expected));
-    
-    return change;
+static double pearson(const double *a, const double *b, int n) {
+    double ma = 0, mb = 0;
+    for (int i = 0; i < n; i++) {
+        ma += a[i];
+        mb += b[i];
+    }
+    ma /= n;
+    mb /= n;
+    double cov = 0, va = 0, vb = 0;
+    for (int i = 0; i < n; i++) {
+        cov += (a[i] - ma) * (b[i] - mb);
+        va += (a[i] - ma) * (a[i] - ma);
+        vb += (b[i] - mb) * (b[i] - mb);
+    }
+    return (va > 0 && vb > 0) ? cov / sqrt(va * vb) : 0.0;
 }
 
-void simulate_match(int *ratings, int *matches, int num_players) {
-    printf("--- Pairwise Match Simulation ---\n");
-    printf("Initial Ratings: ");
-    for(int i=0; i<num_players; i++) printf("P%d: %d ", i+1, ratings[i]);
-    printf("\n");
+// --- One population ---
+
+typedef struct {
+    double *skill;
+    int *rating;
+    int *matches;
+    double *skill_rank;
+    double *rating_values;
+    double *rating_rank;
+    RankItem *scratch;
+} Population;
 
-    // Rank 1 is P1 (index 0), Rank 2 is P2 (index 1), etc.
-    // Lower index = better placement here for simulation simplicity.
-    int placements[4] = {1, 2, 3, 4}; 
+static int population_alloc(Population *p) {
+    p->skill = malloc(num_players * sizeof(double));
+    p->rating = malloc(num_players * sizeof(int));
+    p->matches = malloc(num_players * sizeof(int));
+    p->skill_rank = malloc(num_players * sizeof(double));
+    p->rating_values = malloc(num_players * sizeof(double));
+    p->rating_rank = malloc(num_players * sizeof(double));
+    p->scratch = malloc(num_players * sizeof(RankItem));
+    return (p->skill && p->rating && p->matches && p->skill_rank && p->rating_values &&
+            p->rating_rank && p->scratch) ? 0 : -1;
+}
+
+static void population_free(Population *p) {
+    free(p->skill);
+    free(p->rating);
+    free(p->matches);
+    free(p->skill_rank);
+    free(p->rating_values);
+    free(p->rating_rank);
+    free(p->scratch);
+}
+
+static void measure(Population *p, PopResult *out, int checkpoint) {
+    double error = 0, total = 0;
+    for (int i = 0; i < num_players; i++) {
+        p->rating_values[i] = p->rating[i];
+        error += fabs(p->rating[i] - p->skill[i]);
+        total += p->rating[i];
+    }
+    rank_values(p->rating_values, p->rating_rank, p->scratch, num_players);
+    out->rho[checkpoint] = pearson(p->skill_rank, p->rating_rank, num_players);
+    out->error[checkpoint] = error / num_players;
+    out->drift[checkpoint] = total / num_players - SIM_START_RATING;
+}
 
-    int total_change_system = 0;
+static void simulate(Population *p, int population, PopResult *out) {
+    // Gumbel(0, beta): the difference of two is logistic with the ELO scale
+    const double beta = 400.0 / log(10.0);
+    GameRng rng;
+    rng_seed(&rng, base_seed + (uint64_t)population * 0x9E3779B97F4A7C15ULL);
 
     for (int i = 0; i < num_players; i++) {
-        double total_expected = 0;
-        double total_actual = 0;
-        
-        for (int j = 0; j < num_players; j++) {
-            if (i == j) continue;
-            
-            // Calculate expectation for i vs j
-            double expected = calculate_expected_score(ratings[i], ratings[j]);
-            total_expected += expected;
-            
-            // Calculate actual result (1.0 if i beat j, 0.0 if i lost to j)
-            // Since our array is sorted by rank (index 0 is rank 1), i < j means i beat j
-            double actual = (placements[i] < placements[j]) ? 1.0 : 0.0;
-            total_actual += actual;
+        p->skill[i] = SIM_START_RATING + SIM_SKILL_SD * normal(&rng);
+        p->rating[i] = SIM_START_RATING;
+        p->matches[i] = 0;
+    }
+    rank_values(p->skill, p->skill_rank, p->scratch, num_players);
+
+    int ids[SIM_MAX_PLAYERS], ratings[SIM_MAX_PLAYERS], counts[SIM_MAX_PLAYERS];
+    int placements[SIM_MAX_PLAYERS], changes[SIM_MAX_PLAYERS], new_ratings[SIM_MAX_PLAYERS];
+    double performance[SIM_MAX_PLAYERS];
+    long long slots = 0;  // Player-matches played so far
+    int checkpoint = 0;
+
+    memset(out, 0, sizeof(*out));
+    for (long long m = 0; m < num_matches; m++) {
+        int n = SIM_MIN_PLAYERS + rng_range(&rng, SIM_MAX_PLAYERS - SIM_MIN_PLAYERS + 1);
+        for (int i = 0; i < n; i++) {
+            int dup;
+            do {
+                ids[i] = rng_range(&rng, num_players);
+                dup = 0;
+                for (int j = 0; j < i; j++) dup |= ids[j] == ids[i];
+            } while (dup);
+            ratings[i] = p->rating[ids[i]];
+            counts[i] = p->matches[ids[i]];
+            performance[i] = p->skill[ids[i]] - beta * log(-log(uniform(&rng)));
+        }
+        // Placement 1 = best performance
+        for (int i = 0; i < n; i++) {
+            placements[i] = 1;
+            for (int j = 0; j < n; j++) placements[i] += performance[j] > performance[i];
         }
-        
-        int k = get_k_factor(matches[i]);
-        
-        // The change is Sum(K * (Actual - Expected)) which is equivalent to K * Sum(Actual - Expected)
-        int change = (int)(k * (total_actual - total_expected));
-        
-        total_change_system += change;
-        printf("P%d (Place %d): Rating %d -> Score %.2f/%.2f -> Change: %d\n", 
-               i+1, placements[i], ratings[i], total_actual, total_expected, change);
+
+        elo_rate_match(ratings, counts, placements, n, changes, new_ratings);
+        for (int i = 0; i < n; i++) {
+            p->rating[ids[i]] = new_ratings[i];
+            p->matches[ids[i]]++;
+        }
+
+        slots += n;
+        while (checkpoint < NUM_CHECKPOINTS && slots >= (long long)checkpoints[checkpoint] * num_players) {
+            measure(p, out, checkpoint++);
+        }
+    }
+    out->reached = checkpoint;
+}
+
+static void* worker_main(void *arg) {
+    (void)arg;
+    Population p;
+    if (population_alloc(&p) != 0) {
+        fprintf(stderr, "Out of memory\n");
+        population_free(&p);
+        return NULL;
+    }
+    int population;
+    while ((population = __atomic_fetch_add(&next_population, 1, __ATOMIC_RELAXED)) < num_populations) {
+        simulate(&p, population, &results[population]);
     }
-    
-    printf("Total System Point Change: %d\n", total_change_system);
+    population_free(&p);
+    return NULL;
 }
 
-int main() {
-    // Case 1: 4 Players, Equal Rating, New Players (High K)
-    int r1[] = {1000, 1000, 1000, 1000};
-    int m1[] = {0, 0, 0, 0};
-    simulate_match(r1, m1, 4);
+int main(int argc, char **argv) {
+    int num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (argc > 1) num_players = atoi(argv[1]);
+    if (argc > 2) num_matches = atoll(argv[2]);
+    if (argc > 3) num_populations = atoi(argv[3]);
+    if (argc > 4) num_threads = atoi(argv[4]);
+    if (argc > 5) base_seed = strtoull(argv[5], NULL, 10);
+    if (num_players < SIM_MAX_PLAYERS || num_matches < 1) {
+        fprintf(stderr, "Usage: %s [players>=%d] [matches] [populations] [threads] [seed]\n",
+                argv[0], SIM_MAX_PLAYERS);
+        return 1;
+    }
+    if (num_threads < 1) num_threads = 1;
+    if (num_populations < 1) num_populations = num_threads;
+
+    results = calloc(num_populations, sizeof(PopResult));
+    pthread_t *threads = calloc(num_threads, sizeof(pthread_t));
+    if (!results || !threads) return 1;
+
+    printf("%d population(s) x %d players x %lld matches of %d-%d players, %d thread(s), seed %llu\n",
+           num_populations, num_players, num_matches, SIM_MIN_PLAYERS, SIM_MAX_PLAYERS,
+           num_threads, (unsigned long long)base_seed);
+    printf("K-factor: %d / %d / %d at 0 / 10 / 30 matches played\n",
+           get_k_factor(0), get_k_factor(10), get_k_factor(30));
 
-    // Case 2: 4 Players, Equal Rating, Experienced (Low K)
-    int r2[] = {1500, 1500, 1500, 1500};
-    int m2[] = {100, 100, 100, 100};
-    simulate_match(r2, m2, 4);
+    double start = now_seconds();
+    for (int i = 0; i < num_threads; i++) pthread_create(&threads[i], NULL, worker_main, NULL);
+    for (int i = 0; i < num_threads; i++) pthread_join(threads[i], NULL);
+    double seconds = now_seconds() - start;
+
+    printf("\n%12s %8s %8s %8s %8s\n", "matches/plr", "rho", "rho sd", "error", "drift");
+    int converged_at = -1;
+    for (int c = 0; c < NUM_CHECKPOINTS; c++) {
+        int n = 0;
+        double rho = 0, rho_sq = 0, error = 0, drift = 0;
+        for (int i = 0; i < num_populations; i++) {
+            if (results[i].reached <= c) continue;
+            n++;
+            rho += results[i].rho[c];
+            rho_sq += results[i].rho[c] * results[i].rho[c];
+            error += results[i].error[c];
+            drift += results[i].drift[c];
+        }
+        if (n == 0) break;
+        rho /= n;
+        double sd = sqrt(fmax(0.0, rho_sq / n - rho * rho));
+        printf("%12d %8.4f %8.4f %8.1f %+8.1f\n", checkpoints[c], rho, sd, error / n, drift / n);
+        if (converged_at < 0 && rho >= 0.9) converged_at = checkpoints[c];
+    }
+
+    if (converged_at > 0) {
+        printf("\nRank correlation reaches 0.90 by %d matches per player\n", converged_at);
+    } else {
+        printf("\nRank correlation never reached 0.90; try more matches\n");
+    }
+    long long total = num_matches * num_populations;
+    printf("%lld matches in %.2f s: %.2f M matches/s\n", total, seconds, total / seconds / 1e6);
 
+    free(threads);
+    free(results);
     return 0;
 }
@@ -0,0 +1,200 @@
+/* server/tick_scheduler.c - Fixed-step lobby tick scheduling on a timerfd */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+#include "server.h"
+
+// Schedules live in the lobby registry; this keeps the ids of the ones
+// ticking, so a pass costs the running games, not every lobby
+static int *running = NULL;
+static int num_running = 0;
+static int running_cap = 0;
+static TickDue *due = NULL;      // Sized with running[]
+static TickStats totals;
+static int timer_fd = -1;
+
+// Deadline of tick n. Computed from the start rather than accumulated as a
+// whole-ms interval, which would run 60 Hz at 62.5 Hz.
+static long long tick_deadline(const TickSchedule *s, long long n) {
+    return s->start_ms + n * 1000 / s->tick_rate;
+}
+
+int tick_scheduler_init() {
+    memset(&totals, 0, sizeof(totals));
+
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0) {
+        perror("timerfd_create");
+        return -1;
+    }
+    printf("[TICK] Scheduler ready (default %d Hz, catch-up cap %d ticks)\n",
+           DEFAULT_TICK_RATE, MAX_CATCHUP_TICKS);
+    return timer_fd;
+}
+
+int tick_scheduler_fd() {
+    return timer_fd;
+}
+
+// Clamp a requested tick rate; 0 means "use the default"
+int tick_scheduler_clamp_rate(int tick_rate) {
+    if (tick_rate <= 0) return DEFAULT_TICK_RATE;
+    if (tick_rate < MIN_TICK_RATE) return MIN_TICK_RATE;
+    if (tick_rate > MAX_TICK_RATE) return MAX_TICK_RATE;
+    return tick_rate;
+}
+
+void tick_scheduler_start(int lobby_id, int tick_rate, long long now_ms) {
+    TickSchedule *s = lobby_schedule(lobby_id);
+    if (!s) return;
+
+    if (!s->active) {
+        if (num_running == running_cap) {
+            int cap = running_cap ? running_cap * 2 : 16;
+            int *grown_running = realloc(running, cap * sizeof(int));
+            if (grown_running) running = grown_running;
+            TickDue *grown_due = realloc(due, cap * sizeof(TickDue));
+            if (grown_due) due = grown_due;
+            if (!grown_running || !grown_due) {
+                fprintf(stderr, "[TICK] Out of memory scheduling lobby %d\n", lobby_id);
+                return;
+            }
+            running_cap = cap;
+        }
+        running[num_running++] = lobby_id;
+    }
+    memset(s, 0, sizeof(TickSchedule));
+    s->active = 1;
+    s->tick_rate = tick_scheduler_clamp_rate(tick_rate);
+    s->start_ms = now_ms;
+    s->next_tick = 1;
+    s->next_tick_ms = tick_deadline(s, s->next_tick);
+
+    printf("[TICK] Lobby %d scheduled at %d Hz\n", lobby_id, s->tick_rate);
+}
+
+void tick_scheduler_stop(int lobby_id) {
+    TickSchedule *s = lobby_schedule(lobby_id);
+    if (!s || !s->active) return;
+
+    s->active = 0;
+    for (int i = 0; i < num_running; i++) {
+        if (running[i] == lobby_id) {
+            running[i] = running[--num_running];
+            break;
+        }
+    }
+    log_event("TICK", "Lobby %d stopped: %lld ticks, %lld late, %lld skipped",
+              lobby_id, s->stats.ticks_run, s->stats.late_ticks, s->stats.skipped_ticks);
+}
+
+// Work out how many fixed steps each lobby owes at 'now'. Deadlines stay on
+// the grid (start + k * 1000 / rate) no matter how late we wake up; anything
+// beyond MAX_CATCHUP_TICKS is dropped and counted as skipped. *out points
+// at the due lobbies until the next call.
+int tick_scheduler_collect(long long now_ms, TickDue **out) {
+    // Drain the timer so select() stops reporting it
+    uint64_t expirations;
+    if (timer_fd >= 0) {
+        while (read(timer_fd, &expirations, sizeof(expirations)) > 0) {}
+    }
+
+    int count = 0;
+    for (int i = 0; i < num_running; i++) {
+        TickSchedule *s = lobby_schedule(running[i]);
+        if (!s) {
+            running[i--] = running[--num_running];  // Lobby freed while ticking
+            continue;
+        }
+        if (now_ms < s->next_tick_ms) continue;
+
+        // Last tick n with start + floor(n * 1000 / rate) <= now
+        long long last = ((now_ms - s->start_ms + 1) * s->tick_rate - 1) / 1000;
+        long long owed = last - s->next_tick + 1;
+        int steps = (owed > MAX_CATCHUP_TICKS) ? MAX_CATCHUP_TICKS : (int)owed;
+
+        if (owed > 1) {
+            s->stats.late_ticks += steps - 1;
+            totals.late_ticks += steps - 1;
+        }
+        if (owed > steps) {
+            s->stats.skipped_ticks += owed - steps;
+            totals.skipped_ticks += owed - steps;
+        }
+        s->stats.ticks_run += steps;
+        totals.ticks_run += steps;
+        s->next_tick += owed;
+        s->next_tick_ms = tick_deadline(s, s->next_tick);
+
+        due[count].lobby_id = running[i];
+        due[count].steps = steps;
+        count++;
+    }
+    *out = due;
+    return count;
+}
+
+// Steps collected for a lobby that were then dropped (its previous tick was
+// still running and the backlog passed MAX_CATCHUP_TICKS)
+void tick_scheduler_skip(int lobby_id, int steps) {
+    TickSchedule *s = lobby_schedule(lobby_id);
+    if (!s || steps <= 0) return;
+    s->stats.ticks_run -= steps;
+    s->stats.skipped_ticks += steps;
+    totals.ticks_run -= steps;
+    totals.skipped_ticks += steps;
+}
+
+// Ids of the lobbies currently ticking; *out is valid until the next start/stop
+int tick_scheduler_running(const int **out) {
+    *out = running;
+    return num_running;
+}
+
+// Arm the timerfd for the earliest pending deadline (or disarm it)
+void tick_scheduler_arm() {
+    if (timer_fd < 0) return;
+
+    long long earliest = -1;
+    for (int i = 0; i < num_running; i++) {
+        TickSchedule *s = lobby_schedule(running[i]);
+        if (s && (earliest < 0 || s->next_tick_ms < earliest)) {
+            earliest = s->next_tick_ms;
+        }
+    }
+
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    if (earliest >= 0) {
+        // CLOCK_MONOTONIC absolute time, same clock as get_current_time_ms()
+        spec.it_value.tv_sec = earliest / 1000;
+        spec.it_value.tv_nsec = (earliest % 1000) * 1000000L;
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+            spec.it_value.tv_nsec = 1;  // All-zero would disarm
+        }
+    }
+    timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+int tick_scheduler_get_stats(int lobby_id, TickStats *out) {
+    if (!out) return -1;
+    if (lobby_id < 0) {
+        *out = totals;
+        return 0;
+    }
+    TickSchedule *s = lobby_schedule(lobby_id);
+    if (!s) return -1;
+    *out = s->stats;
+    return 0;
+}
+
+void tick_scheduler_free() {
+    free(running);
+    free(due);
+    running = NULL;
+    due = NULL;
+    num_running = running_cap = 0;
+}
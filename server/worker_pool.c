@@ -0,0 +1,262 @@
+/* server/worker_pool.c - Work-stealing thread pool */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "server.h"
+
+// Each participant (the owner thread in slot 0, helper threads after it)
+// has a fixed-size Chase-Lev deque. The owner pushes and pops at the
+// bottom, idle participants steal from the top of everyone else's deque.
+#define WORK_DEQUE_SIZE 256
+
+typedef struct {
+    WorkerTaskFn fn;
+    void *arg;
+} WorkerTask;
+
+typedef struct {
+    atomic_long top;
+    atomic_long bottom;
+    WorkerTask tasks[WORK_DEQUE_SIZE];
+} WorkDeque;
+
+struct WorkerPool {
+    int num_threads;             // helper threads
+    int num_deques;              // num_threads + 1 (slot 0 = owner thread)
+    WorkDeque *deques;
+    pthread_t *threads;
+    pthread_t owner;
+    atomic_int pending;          // submitted and not yet finished
+    atomic_int queued;           // sitting in a deque
+    atomic_int shutdown;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;      // helpers park here when there is nothing to steal
+    pthread_cond_t done_cv;      // worker_pool_wait() parks here
+};
+
+typedef struct {
+    WorkerPool *pool;
+    int index;
+} WorkerStart;
+
+static __thread WorkerPool *tls_pool = NULL;
+static __thread int tls_index = -1;
+
+// --- Deque operations ---
+
+static int deque_push(WorkDeque *dq, WorkerTask task) {
+    long b = atomic_load(&dq->bottom);
+    long t = atomic_load(&dq->top);
+    // Keep one slot free so a slow thief never reads a slot being rewritten
+    if (b - t >= WORK_DEQUE_SIZE - 1) return 0;
+    dq->tasks[b % WORK_DEQUE_SIZE] = task;
+    atomic_store(&dq->bottom, b + 1);
+    return 1;
+}
+
+static int deque_pop(WorkDeque *dq, WorkerTask *out) {
+    long b = atomic_load(&dq->bottom) - 1;
+    atomic_store(&dq->bottom, b);
+    long t = atomic_load(&dq->top);
+
+    if (t > b) {
+        // Empty
+        atomic_store(&dq->bottom, b + 1);
+        return 0;
+    }
+
+    *out = dq->tasks[b % WORK_DEQUE_SIZE];
+    if (t == b) {
+        // Last element: race against thieves for it
+        int won = atomic_compare_exchange_strong(&dq->top, &t, t + 1);
+        atomic_store(&dq->bottom, b + 1);
+        return won;
+    }
+    return 1;
+}
+
+static int deque_steal(WorkDeque *dq, WorkerTask *out) {
+    long t = atomic_load(&dq->top);
+    long b = atomic_load(&dq->bottom);
+    if (t >= b) return 0;
+
+    WorkerTask task = dq->tasks[t % WORK_DEQUE_SIZE];
+    if (!atomic_compare_exchange_strong(&dq->top, &t, t + 1)) {
+        return 0;  // Lost the race, caller will retry elsewhere
+    }
+    *out = task;
+    return 1;
+}
+
+// --- Scheduling ---
+
+static int find_task(WorkerPool *pool, int self, WorkerTask *out) {
+    if (self >= 0 && deque_pop(&pool->deques[self], out)) {
+        atomic_fetch_sub(&pool->queued, 1);
+        return 1;
+    }
+
+    int start = (self >= 0) ? self + 1 : 0;
+    for (int i = 0; i < pool->num_deques; i++) {
+        int victim = (start + i) % pool->num_deques;
+        if (victim == self) continue;
+        if (deque_steal(&pool->deques[victim], out)) {
+            atomic_fetch_sub(&pool->queued, 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void finish_task(WorkerPool *pool) {
+    if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->done_cv);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void *worker_main(void *arg) {
+    WorkerStart start = *(WorkerStart *)arg;
+    free(arg);
+
+    WorkerPool *pool = start.pool;
+    tls_pool = pool;
+    tls_index = start.index;
+
+    while (!atomic_load(&pool->shutdown)) {
+        WorkerTask task;
+        if (find_task(pool, tls_index, &task)) {
+            task.fn(task.arg);
+            finish_task(pool);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        while (!atomic_load(&pool->shutdown) && atomic_load(&pool->queued) == 0) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+// --- Public API ---
+
+int worker_pool_default_threads() {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+    return (int)cores;
+}
+
+WorkerPool* worker_pool_create(int num_threads) {
+    if (num_threads < 0) num_threads = 0;
+
+    WorkerPool *pool = calloc(1, sizeof(WorkerPool));
+    if (!pool) return NULL;
+
+    pool->num_threads = num_threads;
+    pool->num_deques = num_threads + 1;
+    pool->deques = calloc(pool->num_deques, sizeof(WorkDeque));
+    pool->threads = calloc(num_threads > 0 ? num_threads : 1, sizeof(pthread_t));
+    pool->owner = pthread_self();
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+
+    if (!pool->deques || !pool->threads) {
+        free(pool->deques);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        WorkerStart *start = malloc(sizeof(WorkerStart));
+        start->pool = pool;
+        start->index = i + 1;
+        if (pthread_create(&pool->threads[i], NULL, worker_main, start) != 0) {
+            fprintf(stderr, "[POOL] Failed to start worker %d\n", i);
+            free(start);
+            pool->num_threads = i;
+            break;
+        }
+    }
+
+    printf("[POOL] Worker pool started with %d helper thread(s)\n", pool->num_threads);
+    return pool;
+}
+
+int worker_pool_size(WorkerPool *pool) {
+    return pool ? pool->num_threads + 1 : 0;
+}
+
+void worker_pool_submit(WorkerPool *pool, WorkerTaskFn fn, void *arg) {
+    int self = -1;
+    if (tls_pool == pool) {
+        self = tls_index;
+    } else if (pthread_equal(pthread_self(), pool->owner)) {
+        self = 0;
+    }
+
+    WorkerTask task = { fn, arg };
+    atomic_fetch_add(&pool->pending, 1);
+
+    if (self < 0 || !deque_push(&pool->deques[self], task)) {
+        // Foreign thread or full deque: run it right here
+        fn(arg);
+        finish_task(pool);
+        return;
+    }
+
+    atomic_fetch_add(&pool->queued, 1);
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->work_cv);
+    pthread_cond_broadcast(&pool->done_cv);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Help run queued tasks, then block until every submitted task has finished
+void worker_pool_wait(WorkerPool *pool) {
+    int self = pthread_equal(pthread_self(), pool->owner) ? 0 : -1;
+
+    while (atomic_load(&pool->pending) > 0) {
+        WorkerTask task;
+        if (find_task(pool, self, &task)) {
+            task.fn(task.arg);
+            finish_task(pool);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        while (atomic_load(&pool->pending) > 0 && atomic_load(&pool->queued) == 0) {
+            pthread_cond_wait(&pool->done_cv, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void worker_pool_destroy(WorkerPool *pool) {
+    if (!pool) return;
+
+    worker_pool_wait(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->shutdown, 1);
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_cond_destroy(&pool->done_cv);
+    free(pool->deques);
+    free(pool->threads);
+    free(pool);
+}